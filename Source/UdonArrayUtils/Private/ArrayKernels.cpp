@@ -0,0 +1,673 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "ArrayKernels.h"
+
+#include "Math/VectorRegister.h"
+#include "Misc/EngineVersionComparison.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace udon {
+namespace {
+inline int32 GetElementSize(const FProperty& Property) {
+	return
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    Property.ElementSize
+#else
+	    Property.GetElementSize()
+#endif
+	    ;
+}
+
+// count the elements equal to Value. Written without branches, so that the
+// compiler can vectorize the loop (compare and add the masks).
+template <class T>
+int32 CountEqual(const T* const Data, const int32 Num, const T Value) {
+	auto Count = 0;
+	for (auto i = 0; i < Num; ++i) {
+		Count += Data[i] == Value ? 1 : 0;
+	}
+	return Count;
+}
+
+// count the elements whose bytes are equal to those of Value
+int32 CountBitwiseEqual(const uint8* const Data, const int32 Num,
+                        const int32 ElementSize, const void* const Value) {
+	auto Count = 0;
+	for (auto i = 0; i < Num; ++i) {
+		Count += FMemory::Memcmp(Data + static_cast<int64>(i) * ElementSize,
+		                         Value, ElementSize) == 0
+		             ? 1
+		             : 0;
+	}
+	return Count;
+}
+
+// count the elements equal to Value as unsigned integers of ElementSize
+TOptional<int32> CountEqualBySize(const uint8* const Data, const int32 Num,
+                                  const int32 ElementSize,
+                                  const void* const Value) {
+	switch (ElementSize) {
+	case 1:
+		return CountEqual(Data, Num, *static_cast<const uint8*>(Value));
+	case 2:
+		return CountEqual(reinterpret_cast<const uint16*>(Data), Num,
+		                  *static_cast<const uint16*>(Value));
+	case 4:
+		return CountEqual(reinterpret_cast<const uint32*>(Data), Num,
+		                  *static_cast<const uint32*>(Value));
+	case 8:
+		return CountEqual(reinterpret_cast<const uint64*>(Data), Num,
+		                  *static_cast<const uint64*>(Value));
+	default:
+		return CountBitwiseEqual(Data, Num, ElementSize, Value);
+	}
+}
+
+// fill the elements with copies of Value of type T
+template <class T>
+void FillTyped(uint8* const Data, const int32 Num, const void* const Value) {
+	std::fill_n(reinterpret_cast<T*>(Data), Num, *static_cast<const T*>(Value));
+}
+
+// types of elements supported by the numeric kernels
+enum class ENumericType : uint8 { None, Int32, Int64, Float, Double, Vector };
+
+// get the numeric type of elements of Property
+ENumericType GetNumericType(const FProperty& Property) {
+	if (Property.IsA<FIntProperty>()) {
+		return ENumericType::Int32;
+	}
+	if (Property.IsA<FInt64Property>()) {
+		return ENumericType::Int64;
+	}
+	if (Property.IsA<FFloatProperty>()) {
+		return ENumericType::Float;
+	}
+	if (Property.IsA<FDoubleProperty>()) {
+		return ENumericType::Double;
+	}
+	if (const auto* const StructProperty = CastField<FStructProperty>(&Property);
+	    StructProperty && StructProperty->Struct == TBaseStructure<FVector>::Get()) {
+		return ENumericType::Vector;
+	}
+	return ENumericType::None;
+}
+
+// sum int32 values in 64 bits (the loop is vectorized by the compiler)
+int64 SumInt32(const int32* const Data, const int32 Num) {
+	int64 Sum = 0;
+	for (auto i = 0; i < Num; ++i) {
+		Sum += Data[i];
+	}
+	return Sum;
+}
+
+// sum int64 values, wrapping around on overflow
+int64 SumInt64(const int64* const Data, const int32 Num) {
+	uint64 Sum = 0;
+	for (auto i = 0; i < Num; ++i) {
+		Sum += static_cast<uint64>(Data[i]);
+	}
+	return static_cast<int64>(Sum);
+}
+
+// sum float values in four SIMD lanes
+float SumFloat(const float* const Data, const int32 Num) {
+	auto Lanes = VectorZeroFloat();
+	auto i     = 0;
+	for (; i + 4 <= Num; i += 4) {
+		Lanes = VectorAdd(Lanes, VectorLoad(Data + i));
+	}
+
+	alignas(16) float LaneValues[4];
+	VectorStoreAligned(Lanes, LaneValues);
+	auto Sum = (LaneValues[0] + LaneValues[1]) + (LaneValues[2] + LaneValues[3]);
+	for (; i < Num; ++i) {
+		Sum += Data[i];
+	}
+	return Sum;
+}
+
+// sum double values in four SIMD lanes
+double SumDouble(const double* const Data, const int32 Num) {
+	auto Lanes = VectorZeroDouble();
+	auto i     = 0;
+	for (; i + 4 <= Num; i += 4) {
+		Lanes = VectorAdd(Lanes, VectorLoad(Data + i));
+	}
+
+	alignas(32) double LaneValues[4];
+	VectorStoreAligned(Lanes, LaneValues);
+	auto Sum = (LaneValues[0] + LaneValues[1]) + (LaneValues[2] + LaneValues[3]);
+	for (; i < Num; ++i) {
+		Sum += Data[i];
+	}
+	return Sum;
+}
+
+// sum FVector values component-wise. Four vectors (12 doubles) are summed per
+// iteration in three SIMD registers, whose lanes hold the components in the
+// order XYZX, YZXY and ZXYZ.
+FVector SumVector(const FVector* const Vectors, const int32 Num) {
+	static_assert(sizeof(FVector) == sizeof(double) * 3,
+	              "FVector must be three doubles");
+	const auto* const Data = reinterpret_cast<const double*>(Vectors);
+
+	auto Lanes0 = VectorZeroDouble();
+	auto Lanes1 = VectorZeroDouble();
+	auto Lanes2 = VectorZeroDouble();
+	auto i      = 0;
+	for (; i + 4 <= Num; i += 4) {
+		const auto* const Block = Data + static_cast<int64>(i) * 3;
+		Lanes0 = VectorAdd(Lanes0, VectorLoad(Block));
+		Lanes1 = VectorAdd(Lanes1, VectorLoad(Block + 4));
+		Lanes2 = VectorAdd(Lanes2, VectorLoad(Block + 8));
+	}
+
+	alignas(32) double L0[4];
+	alignas(32) double L1[4];
+	alignas(32) double L2[4];
+	VectorStoreAligned(Lanes0, L0);
+	VectorStoreAligned(Lanes1, L1);
+	VectorStoreAligned(Lanes2, L2);
+	FVector Sum(L0[0] + L0[3] + L1[2] + L2[1], L0[1] + L1[0] + L1[3] + L2[2],
+	            L0[2] + L1[1] + L2[0] + L2[3]);
+	for (; i < Num; ++i) {
+		Sum += Vectors[i];
+	}
+	return Sum;
+}
+
+// sum the products of float values in four SIMD lanes
+double DotFloat(const float* const A, const float* const B, const int32 Num) {
+	auto Lanes = VectorZeroFloat();
+	auto i     = 0;
+	for (; i + 4 <= Num; i += 4) {
+		Lanes = VectorMultiplyAdd(VectorLoad(A + i), VectorLoad(B + i), Lanes);
+	}
+
+	alignas(16) float LaneValues[4];
+	VectorStoreAligned(Lanes, LaneValues);
+	double Sum = (LaneValues[0] + LaneValues[1]) + (LaneValues[2] + LaneValues[3]);
+	for (; i < Num; ++i) {
+		Sum += static_cast<double>(A[i]) * B[i];
+	}
+	return Sum;
+}
+
+// sum the products of double values in four SIMD lanes
+double DotDouble(const double* const A, const double* const B,
+                 const int64 Num) {
+	auto  Lanes = VectorZeroDouble();
+	int64 i     = 0;
+	for (; i + 4 <= Num; i += 4) {
+		Lanes = VectorMultiplyAdd(VectorLoad(A + i), VectorLoad(B + i), Lanes);
+	}
+
+	alignas(32) double LaneValues[4];
+	VectorStoreAligned(Lanes, LaneValues);
+	auto Sum = (LaneValues[0] + LaneValues[1]) + (LaneValues[2] + LaneValues[3]);
+	for (; i < Num; ++i) {
+		Sum += A[i] * B[i];
+	}
+	return Sum;
+}
+
+// sum the products of integer values in 64 bits. The products are computed
+// as unsigned integers, so that they wrap around on overflow like the sum.
+template <class T>
+double DotInteger(const T* const A, const T* const B, const int32 Num) {
+	uint64 Sum = 0;
+	for (auto i = 0; i < Num; ++i) {
+		Sum += static_cast<uint64>(A[i]) * static_cast<uint64>(B[i]);
+	}
+	return static_cast<double>(static_cast<int64>(Sum));
+}
+
+// average int64 values exactly. The sum is kept in 128 bits (the high half
+// counts the carries and the signs), and is divided by Num in 32-bit digits.
+// The result is rounded toward zero, like the average of int32 values.
+int64 AverageInt64(const int64* const Data, const int32 Num) {
+	if (Num <= 0) {
+		return 0;
+	}
+
+	uint64 Low  = 0;
+	uint64 High = 0;
+	for (auto i = 0; i < Num; ++i) {
+		const auto Value = static_cast<uint64>(Data[i]);
+		Low += Value;
+		High += (Low < Value ? 1 : 0) - (Data[i] < 0 ? 1 : 0);
+	}
+
+	// take the absolute value of the sum
+	const auto bNegative = static_cast<int64>(High) < 0;
+	if (bNegative) {
+		Low  = ~Low + 1;
+		High = ~High + (Low == 0 ? 1 : 0);
+	}
+
+	// divide the digits from the highest one
+	const uint32 Digits[4] = {
+	    static_cast<uint32>(High >> 32), static_cast<uint32>(High),
+	    static_cast<uint32>(Low >> 32), static_cast<uint32>(Low)};
+	const auto Divisor   = static_cast<uint64>(Num);
+	uint64     Remainder = 0;
+	uint64     Quotient  = 0;
+	for (const auto Digit : Digits) {
+		const auto Dividend = (Remainder << 32) | Digit;
+		Quotient            = (Quotient << 32) | (Dividend / Divisor);
+		Remainder           = Dividend % Divisor;
+	}
+
+	// the average is within the range of the values, so it fits in 64 bits
+	return static_cast<int64>(bNegative ? ~Quotient + 1 : Quotient);
+}
+
+// find the minimum and maximum of int32 values in four SIMD lanes, starting
+// from Fill (a value of the array)
+void MinMaxValues(const int32* const Data, const int32 Num, const int32 Fill,
+                  int32& OutMin, int32& OutMax) {
+	auto MinLanes = VectorIntSet1(Fill);
+	auto MaxLanes = MinLanes;
+	auto i        = 0;
+	for (; i + 4 <= Num; i += 4) {
+		const auto Values = VectorIntLoad(Data + i);
+		MinLanes          = VectorIntMin(MinLanes, Values);
+		MaxLanes          = VectorIntMax(MaxLanes, Values);
+	}
+
+	alignas(16) int32 MinValues[4];
+	alignas(16) int32 MaxValues[4];
+	VectorIntStoreAligned(MinLanes, MinValues);
+	VectorIntStoreAligned(MaxLanes, MaxValues);
+	OutMin = OutMax = Fill;
+	for (auto Lane = 0; Lane < 4; ++Lane) {
+		OutMin = FMath::Min(OutMin, MinValues[Lane]);
+		OutMax = FMath::Max(OutMax, MaxValues[Lane]);
+	}
+	for (; i < Num; ++i) {
+		OutMin = FMath::Min(OutMin, Data[i]);
+		OutMax = FMath::Max(OutMax, Data[i]);
+	}
+}
+
+// find the minimum and maximum of int64 values, for which there are no SIMD
+// minimum and maximum before AVX-512. The loop has no branches, so that the
+// compiler can vectorize it where it can.
+void MinMaxValues(const int64* const Data, const int32 Num, const int64 Fill,
+                  int64& OutMin, int64& OutMax) {
+	OutMin = OutMax = Fill;
+	for (auto i = 0; i < Num; ++i) {
+		OutMin = FMath::Min(OutMin, Data[i]);
+		OutMax = FMath::Max(OutMax, Data[i]);
+	}
+}
+
+// find the minimum and maximum of floating point values in four SIMD lanes,
+// starting from Fill (a value of the array that isn't NaN). NaNs are replaced
+// with Fill, so that they never win.
+template <class T, class RegisterT>
+void MinMaxFloatingPointValues(const T* const Data, const int32 Num,
+                               const T Fill, const RegisterT FillLanes,
+                               T& OutMin, T& OutMax) {
+	auto MinLanes = FillLanes;
+	auto MaxLanes = FillLanes;
+	auto i        = 0;
+	for (; i + 4 <= Num; i += 4) {
+		const auto Values = VectorLoad(Data + i);
+
+		// NaNs aren't equal to themselves
+		const auto Numbers =
+		    VectorSelect(VectorCompareEQ(Values, Values), Values, FillLanes);
+		MinLanes = VectorMin(MinLanes, Numbers);
+		MaxLanes = VectorMax(MaxLanes, Numbers);
+	}
+
+	alignas(32) T MinValues[4];
+	alignas(32) T MaxValues[4];
+	VectorStoreAligned(MinLanes, MinValues);
+	VectorStoreAligned(MaxLanes, MaxValues);
+	OutMin = OutMax = Fill;
+	for (auto Lane = 0; Lane < 4; ++Lane) {
+		OutMin = FMath::Min(OutMin, MinValues[Lane]);
+		OutMax = FMath::Max(OutMax, MaxValues[Lane]);
+	}
+
+	// comparisons with NaN are false, so NaNs in the rest are skipped
+	for (; i < Num; ++i) {
+		OutMin = Data[i] < OutMin ? Data[i] : OutMin;
+		OutMax = OutMax < Data[i] ? Data[i] : OutMax;
+	}
+}
+
+void MinMaxValues(const float* const Data, const int32 Num, const float Fill,
+                  float& OutMin, float& OutMax) {
+	MinMaxFloatingPointValues(Data, Num, Fill, VectorLoadFloat1(&Fill), OutMin,
+	                          OutMax);
+}
+
+void MinMaxValues(const double* const Data, const int32 Num,
+                  const double Fill, double& OutMin, double& OutMax) {
+	MinMaxFloatingPointValues(Data, Num, Fill, VectorLoadDouble1(&Fill),
+	                          OutMin, OutMax);
+}
+
+// find the minimum and maximum. The values are found first, with SIMD
+// instructions for int32, float and double, and then the first indices of
+// them in a second scan, which stops as soon as both are found.
+template <class T>
+void MinMaxIndices(const T* const Data, const int32 Num, int32& OutMinIndex,
+                   int32& OutMaxIndex) {
+	// skip NaNs at the beginning, so that the search starts with a number
+	auto First = 0;
+	if constexpr (std::is_floating_point_v<T>) {
+		while (First < Num && FMath::IsNaN(Data[First])) {
+			++First;
+		}
+		if (First == Num) {
+			OutMinIndex = OutMaxIndex = Num > 0 ? 0 : INDEX_NONE;
+			return;
+		}
+	} else if (Num == 0) {
+		OutMinIndex = OutMaxIndex = INDEX_NONE;
+		return;
+	}
+
+	// find the values
+	T MinValue;
+	T MaxValue;
+	MinMaxValues(Data + First, Num - First, Data[First], MinValue, MaxValue);
+
+	// find the first elements equal to them (+0 and -0 are equal, like in a
+	// comparison of the elements)
+	OutMinIndex = OutMaxIndex = INDEX_NONE;
+	for (auto i = First; OutMinIndex == INDEX_NONE || OutMaxIndex == INDEX_NONE;
+	     ++i) {
+		if (OutMinIndex == INDEX_NONE && Data[i] == MinValue) {
+			OutMinIndex = i;
+		}
+		if (OutMaxIndex == INDEX_NONE && Data[i] == MaxValue) {
+			OutMaxIndex = i;
+		}
+	}
+}
+} // namespace
+
+bool IsBitwiseComparable(const FProperty& Property) {
+	// integers and enums (not floating points: +0 and -0 are identical, and
+	// NaN is not identical to itself)
+	if (const auto* const NumericProperty =
+	        CastField<FNumericProperty>(&Property)) {
+		return NumericProperty->IsInteger();
+	}
+	if (Property.IsA<FEnumProperty>()) {
+		return true;
+	}
+
+	// structs
+	const auto* const StructProperty = CastField<FStructProperty>(&Property);
+	if (!StructProperty) {
+		return false;
+	}
+
+	// if the struct is compared natively, or is not plain old data
+	const auto* const Struct = StructProperty->Struct;
+	if (Struct->StructFlags & STRUCT_IdenticalNative ||
+	    !(Struct->StructFlags & STRUCT_IsPlainOldData)) {
+		return false;
+	}
+
+	// all members must be comparable, and fill the struct without padding
+	auto MembersSize = 0;
+	for (TFieldIterator<FProperty> It(Struct); It; ++It) {
+		if (It->ArrayDim != 1 || !IsBitwiseComparable(**It)) {
+			return false;
+		}
+		MembersSize += GetElementSize(**It);
+	}
+
+	return MembersSize == Struct->GetStructureSize();
+}
+
+TOptional<int32> CountIdenticalTyped(FScriptArrayHelper& ArrayHelper,
+                                     const FProperty&    ElementProperty,
+                                     const void* const   Value) {
+	const auto Num = ArrayHelper.Num();
+
+	// if there are no elements
+	if (Num == 0) {
+		return 0;
+	}
+
+	const auto* const Data        = ArrayHelper.GetRawPtr(0);
+	const auto        ElementSize = GetElementSize(ElementProperty);
+
+	// floating points are compared as such
+	if (ElementProperty.IsA<FFloatProperty>()) {
+		return CountEqual(reinterpret_cast<const float*>(Data), Num,
+		                  *static_cast<const float*>(Value));
+	}
+	if (ElementProperty.IsA<FDoubleProperty>()) {
+		return CountEqual(reinterpret_cast<const double*>(Data), Num,
+		                  *static_cast<const double*>(Value));
+	}
+
+	// bools are compared by their values
+	if (const auto* const BoolProperty =
+	        CastField<FBoolProperty>(&ElementProperty)) {
+		const auto bValue = BoolProperty->GetPropertyValue(Value);
+		auto       Count  = 0;
+		for (auto i = 0; i < Num; ++i) {
+			Count += BoolProperty->GetPropertyValue(Data + i * ElementSize) ==
+			                 bValue
+			             ? 1
+			             : 0;
+		}
+		return Count;
+	}
+
+	// names are compared by FName::operator== (case insensitively)
+	if (ElementProperty.IsA<FNameProperty>()) {
+		return CountEqual(reinterpret_cast<const FName*>(Data), Num,
+		                  *static_cast<const FName*>(Value));
+	}
+
+	// object references are compared by the objects they point to
+	if (ElementProperty.IsA<FObjectProperty>()) {
+		const auto* const Objects =
+		    reinterpret_cast<const TObjectPtr<UObject>*>(Data);
+		const auto& ValueObject = *static_cast<const TObjectPtr<UObject>*>(Value);
+		auto        Count       = 0;
+		for (auto i = 0; i < Num; ++i) {
+			Count += Objects[i] == ValueObject ? 1 : 0;
+		}
+		return Count;
+	}
+
+	// integers, enums and plain old data structs are compared bitwise
+	if (IsBitwiseComparable(ElementProperty)) {
+		return CountEqualBySize(Data, Num, ElementSize, Value);
+	}
+
+	return {};
+}
+
+void FillElements(FScriptArrayHelper& ArrayHelper,
+                  const FProperty& ElementProperty, const int32 First,
+                  const int32 Last, const void* const Value) {
+	// if there is nothing to fill
+	if (First >= Last) {
+		return;
+	}
+
+	const auto   ElementSize = GetElementSize(ElementProperty);
+	auto* const  Data        = ArrayHelper.GetRawPtr(First);
+	const auto   Num         = Last - First;
+
+	// if the elements are not plain old data
+	if (!(ElementProperty.PropertyFlags & CPF_IsPlainOldData)) {
+		// deep copy Value to each element
+		for (auto i = 0; i < Num; ++i) {
+			ElementProperty.CopySingleValue(
+			    Data + static_cast<int64>(i) * ElementSize, Value);
+		}
+
+		// finish
+		return;
+	}
+
+	// copy Value with a typed loop by its size
+	switch (ElementSize) {
+	case 1:
+		FMemory::Memset(Data, *static_cast<const uint8*>(Value), Num);
+		return;
+	case 2:
+		FillTyped<uint16>(Data, Num, Value);
+		return;
+	case 4:
+		FillTyped<uint32>(Data, Num, Value);
+		return;
+	case 8:
+		FillTyped<uint64>(Data, Num, Value);
+		return;
+	default:
+		for (auto i = 0; i < Num; ++i) {
+			FMemory::Memcpy(Data + static_cast<int64>(i) * ElementSize, Value,
+			                ElementSize);
+		}
+		return;
+	}
+}
+
+bool SumTyped(FScriptArrayHelper& ArrayHelper,
+              const FProperty& ElementProperty, void* const OutSum) {
+	const auto  Num  = ArrayHelper.Num();
+	const auto* Data = Num > 0 ? ArrayHelper.GetRawPtr(0) : nullptr;
+
+	switch (GetNumericType(ElementProperty)) {
+	case ENumericType::Int32:
+		*static_cast<int32*>(OutSum) = static_cast<int32>(
+		    FMath::Clamp<int64>(SumInt32(reinterpret_cast<const int32*>(Data), Num),
+		                        MIN_int32, MAX_int32));
+		return true;
+	case ENumericType::Int64:
+		*static_cast<int64*>(OutSum) =
+		    SumInt64(reinterpret_cast<const int64*>(Data), Num);
+		return true;
+	case ENumericType::Float:
+		*static_cast<float*>(OutSum) =
+		    SumFloat(reinterpret_cast<const float*>(Data), Num);
+		return true;
+	case ENumericType::Double:
+		*static_cast<double*>(OutSum) =
+		    SumDouble(reinterpret_cast<const double*>(Data), Num);
+		return true;
+	case ENumericType::Vector:
+		*static_cast<FVector*>(OutSum) =
+		    SumVector(reinterpret_cast<const FVector*>(Data), Num);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool AverageTyped(FScriptArrayHelper& ArrayHelper,
+                  const FProperty& ElementProperty, void* const OutAverage) {
+	const auto  Num  = ArrayHelper.Num();
+	const auto* Data = Num > 0 ? ArrayHelper.GetRawPtr(0) : nullptr;
+	const auto  Divisor = FMath::Max(Num, 1);
+
+	switch (GetNumericType(ElementProperty)) {
+	case ENumericType::Int32:
+		*static_cast<int32*>(OutAverage) = static_cast<int32>(
+		    SumInt32(reinterpret_cast<const int32*>(Data), Num) / Divisor);
+		return true;
+	case ENumericType::Int64:
+		*static_cast<int64*>(OutAverage) =
+		    AverageInt64(reinterpret_cast<const int64*>(Data), Num);
+		return true;
+	case ENumericType::Float:
+		*static_cast<float*>(OutAverage) =
+		    SumFloat(reinterpret_cast<const float*>(Data), Num) / Divisor;
+		return true;
+	case ENumericType::Double:
+		*static_cast<double*>(OutAverage) =
+		    SumDouble(reinterpret_cast<const double*>(Data), Num) / Divisor;
+		return true;
+	case ENumericType::Vector:
+		*static_cast<FVector*>(OutAverage) =
+		    SumVector(reinterpret_cast<const FVector*>(Data), Num) / Divisor;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool MinMaxIndicesTyped(FScriptArrayHelper& ArrayHelper,
+                        const FProperty& ElementProperty, int32& OutMinIndex,
+                        int32& OutMaxIndex) {
+	const auto  Num  = ArrayHelper.Num();
+	const auto* Data = Num > 0 ? ArrayHelper.GetRawPtr(0) : nullptr;
+
+	switch (GetNumericType(ElementProperty)) {
+	case ENumericType::Int32:
+		MinMaxIndices(reinterpret_cast<const int32*>(Data), Num, OutMinIndex,
+		              OutMaxIndex);
+		return true;
+	case ENumericType::Int64:
+		MinMaxIndices(reinterpret_cast<const int64*>(Data), Num, OutMinIndex,
+		              OutMaxIndex);
+		return true;
+	case ENumericType::Float:
+		MinMaxIndices(reinterpret_cast<const float*>(Data), Num, OutMinIndex,
+		              OutMaxIndex);
+		return true;
+	case ENumericType::Double:
+		MinMaxIndices(reinterpret_cast<const double*>(Data), Num, OutMinIndex,
+		              OutMaxIndex);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool DotProductTyped(FScriptArrayHelper& ArrayHelperA,
+                     FScriptArrayHelper& ArrayHelperB,
+                     const FProperty& ElementProperty, double& OutResult) {
+	check(ArrayHelperA.Num() == ArrayHelperB.Num());
+
+	const auto  Num = ArrayHelperA.Num();
+	const auto* A   = Num > 0 ? ArrayHelperA.GetRawPtr(0) : nullptr;
+	const auto* B   = Num > 0 ? ArrayHelperB.GetRawPtr(0) : nullptr;
+
+	switch (GetNumericType(ElementProperty)) {
+	case ENumericType::Int32:
+		OutResult = DotInteger(reinterpret_cast<const int32*>(A),
+		                       reinterpret_cast<const int32*>(B), Num);
+		return true;
+	case ENumericType::Int64:
+		OutResult = DotInteger(reinterpret_cast<const int64*>(A),
+		                       reinterpret_cast<const int64*>(B), Num);
+		return true;
+	case ENumericType::Float:
+		OutResult = DotFloat(reinterpret_cast<const float*>(A),
+		                     reinterpret_cast<const float*>(B), Num);
+		return true;
+	case ENumericType::Double:
+		OutResult = DotDouble(reinterpret_cast<const double*>(A),
+		                      reinterpret_cast<const double*>(B), Num);
+		return true;
+	case ENumericType::Vector:
+		// the sum of the dot products is the dot product of the components
+		OutResult = DotDouble(reinterpret_cast<const double*>(A),
+		                      reinterpret_cast<const double*>(B),
+		                      static_cast<int64>(Num) * 3);
+		return true;
+	default:
+		return false;
+	}
+}
+} // namespace udon
@@ -0,0 +1,102 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+namespace udon {
+/**
+ * Whether comparing values of Property with memcmp gives the same result as
+ * FProperty::Identical. This holds for integers, enums, and plain old data
+ * structs without padding whose members are all such values.
+ */
+bool IsBitwiseComparable(const FProperty& Property);
+
+/**
+ * Counts the elements of an array that are identical to Value, with a loop
+ * specialized for the type of the elements. The type is recognized once per
+ * call, so no virtual function is called per element.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param Value  pointer to the value to count
+ * @return
+ *    The count, or an unset value if the type of the elements has no
+ *    specialized loop.
+ */
+TOptional<int32> CountIdenticalTyped(FScriptArrayHelper& ArrayHelper,
+                                     const FProperty&    ElementProperty,
+                                     const void*         Value);
+
+/**
+ * Overwrites the elements [First, Last) of an array with copies of Value.
+ * Plain old data is copied with a typed or bitwise loop, and other types are
+ * deep copied through the property, so that elements owning memory (such as
+ * strings and arrays) don't share it.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param First  the index of the first element to overwrite
+ * @param Last  the next index of the last element to overwrite
+ * @param Value  pointer to the value to write
+ */
+void FillElements(FScriptArrayHelper& ArrayHelper,
+                  const FProperty& ElementProperty, int32 First, int32 Last,
+                  const void* Value);
+
+/**
+ * Computes the sum of the elements of a numeric array. int32 elements are
+ * summed in 64 bits and clamped to the range of int32, int64 elements wrap
+ * around on overflow, and FVector elements are summed component-wise.
+ * Floating point elements are summed in several lanes with SIMD instructions,
+ * so the rounding may differ slightly from summing them in order.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param[out] OutSum  pointer to a value of the element type to set
+ * @return  false if the type of the elements is not supported.
+ */
+bool SumTyped(FScriptArrayHelper& ArrayHelper,
+              const FProperty& ElementProperty, void* OutSum);
+
+/**
+ * Computes the average of the elements of a numeric array (see SumTyped for
+ * the supported types). The average of integers is truncated toward zero. The
+ * average of an empty array is zero.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param[out] OutAverage  pointer to a value of the element type to set
+ * @return  false if the type of the elements is not supported.
+ */
+bool AverageTyped(FScriptArrayHelper& ArrayHelper,
+                  const FProperty& ElementProperty, void* OutAverage);
+
+/**
+ * Finds the minimum and maximum elements of an array of int32, int64, float
+ * or double. The values are found with SIMD instructions (except for int64),
+ * and then their first indices in a second scan that stops when both are
+ * found. The first of equal elements is found. NaNs are ignored unless all
+ * elements are NaN, in which case both indices are 0.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param[out] OutMinIndex  the index of the minimum (INDEX_NONE if empty)
+ * @param[out] OutMaxIndex  the index of the maximum (INDEX_NONE if empty)
+ * @return  false if the type of the elements is not supported.
+ */
+bool MinMaxIndicesTyped(FScriptArrayHelper& ArrayHelper,
+                        const FProperty& ElementProperty, int32& OutMinIndex,
+                        int32& OutMaxIndex);
+
+/**
+ * Computes the sum of the products of the elements at the same index of two
+ * numeric arrays of the same length (see SumTyped for the supported types).
+ * For FVector elements, the dot products of the vectors are summed. Integers
+ * are multiplied and summed in 64 bits.
+ * @param ArrayHelperA  helper of the first array
+ * @param ArrayHelperB  helper of the second array
+ * @param ElementProperty  property of the elements of both arrays
+ * @param[out] OutResult  the sum of the products
+ * @return  false if the type of the elements is not supported.
+ */
+bool DotProductTyped(FScriptArrayHelper& ArrayHelperA,
+                     FScriptArrayHelper& ArrayHelperB,
+                     const FProperty& ElementProperty, double& OutResult);
+} // namespace udon
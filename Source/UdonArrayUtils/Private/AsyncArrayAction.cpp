@@ -0,0 +1,142 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "AsyncArrayAction.h"
+
+#include "Async/Async.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace udon {
+struct FAsyncArrayAction::FState {
+	// constructor
+	FState(const FArrayProperty& InArrayProperty, FWork InWork)
+	    : ArrayProperty(InArrayProperty),
+	      ArrayPropertyOwner(InArrayProperty.GetOwnerStruct()),
+	      Work(MoveTemp(InWork)) {
+		ArrayProperty.InitializeValue(&Elements);
+	}
+
+	// destructor
+	~FState() {
+		ArrayProperty.DestroyValue(&Elements);
+	}
+
+	// property of the array
+	const FArrayProperty& ArrayProperty;
+
+	// the class, function or struct that owns ArrayProperty, kept alive so
+	// that ArrayProperty isn't destroyed while the action is running
+	const TStrongObjectPtr<UStruct> ArrayPropertyOwner;
+
+	// work on a background thread
+	FWork Work;
+
+	// copy of the elements. owned by the background work until bFinished is
+	// set.
+	FScriptArray Elements;
+
+	// set to cancel the work
+	std::atomic<bool> bCancelled{false};
+
+	// set when the background work is finished
+	std::atomic<bool> bFinished{false};
+};
+
+namespace {
+/**
+ * Async array actions that are running, with their callback targets.
+ * Accessed only on the game thread.
+ */
+TArray<TPair<FWeakObjectPtr, FAsyncArrayAction*>>& GetRunningActions() {
+	static TArray<TPair<FWeakObjectPtr, FAsyncArrayAction*>> RunningActions;
+	return RunningActions;
+}
+} // namespace
+
+FAsyncArrayAction::FAsyncArrayAction(const FLatentActionInfo& LatentInfo,
+                                     const void* const        TargetArray,
+                                     const FArrayProperty&    ArrayProperty,
+                                     const UObject* const InTargetArrayOwner,
+                                     FWork Work, FApply InApply)
+    : State(MakeUnique<FState>(ArrayProperty, MoveTemp(Work))),
+      Apply(MoveTemp(InApply)), TargetArrayOwner(InTargetArrayOwner),
+      bHasTargetArrayOwner(InTargetArrayOwner != nullptr),
+      ExecutionFunction(LatentInfo.ExecutionFunction),
+      OutputLink(LatentInfo.Linkage), CallbackTarget(LatentInfo.CallbackTarget) {
+	check(IsInGameThread());
+
+	// copy the elements
+	ArrayProperty.CopyCompleteValue(&State->Elements, TargetArray);
+
+	// register this action for cancellation
+	GetRunningActions().Emplace(CallbackTarget, this);
+
+	// start the work on a background thread. the destructor waits for the
+	// work, so the state outlives it.
+	Task = Async(EAsyncExecution::ThreadPool, [State = State.Get()] {
+		// if not cancelled before starting
+		if (!State->bCancelled.load(std::memory_order_relaxed)) {
+			FScriptArrayHelper ElementsHelper(&State->ArrayProperty,
+			                                  &State->Elements);
+			State->Work(ElementsHelper, State->bCancelled);
+		}
+
+		State->bFinished.store(true, std::memory_order_release);
+	});
+}
+
+FAsyncArrayAction::~FAsyncArrayAction() {
+	// stop the work if still running, and wait for it, so that the elements
+	// are destroyed on the game thread after the work is done with them
+	State->bCancelled.store(true, std::memory_order_relaxed);
+	Task.Wait();
+
+	// unregister this action
+	GetRunningActions().RemoveAll(
+	    [this](const auto& Pair) { return Pair.Value == this; });
+}
+
+void FAsyncArrayAction::CancelActions(const UObject& Object) {
+	check(IsInGameThread());
+
+	for (const auto& [Target, Action] : GetRunningActions()) {
+		if (Target.Get() == &Object) {
+			Action->State->bCancelled.store(true, std::memory_order_relaxed);
+		}
+	}
+}
+
+void FAsyncArrayAction::UpdateOperation(FLatentResponse& Response) {
+	// if the object that owns the target array is destroyed
+	if (bHasTargetArrayOwner && !TargetArrayOwner.IsValid()) {
+		// cancel, as the result can't be applied
+		State->bCancelled.store(true, std::memory_order_relaxed);
+	}
+
+	// if cancelled
+	if (State->bCancelled.load(std::memory_order_relaxed)) {
+		// finish without triggering the output
+		Response.DoneIf(true);
+		return;
+	}
+
+	// if the background work is still running
+	if (!State->bFinished.load(std::memory_order_acquire)) {
+		// check again on the next tick
+		return;
+	}
+
+	// apply the result on the game thread
+	Apply(State->Elements);
+
+	Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink,
+	                            CallbackTarget);
+}
+
+#if WITH_EDITOR
+FString FAsyncArrayAction::GetDescription() const {
+	return FString::Printf(
+	    TEXT("Processing %d elements on a background thread"),
+	    State->Elements.Num());
+}
+#endif
+} // namespace udon
@@ -0,0 +1,95 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "Engine/LatentActionManager.h"
+#include "LatentActions.h"
+#include "UObject/UnrealType.h"
+
+#include <atomic>
+
+namespace udon {
+/**
+ * A latent action that processes a copy of an array on a background thread.
+ * The elements are copied on the game thread when the action starts, and the
+ * copy is passed to Work on a background thread. When Work is finished, Apply
+ * is called with the copy on the game thread, and the output of the node is
+ * triggered.
+ * Work must not touch UObjects or call Blueprint functions, and must only move
+ * the elements bitwise (without constructing or destroying them).
+ */
+class FAsyncArrayAction : public FPendingLatentAction {
+public:
+	/**
+	 * Work on a background thread. Receives the copy of the elements and a
+	 * flag which is set when the action is cancelled, so that long work can
+	 * stop early.
+	 */
+	using FWork = TUniqueFunction<void(FScriptArrayHelper& Elements,
+	                                   const std::atomic<bool>& bCancelled)>;
+
+	/**
+	 * Work on the game thread after Work. Receives the copy of the elements,
+	 * which may be modified or swapped with the target array.
+	 */
+	using FApply = TUniqueFunction<void(FScriptArray& Elements)>;
+
+public:
+	/**
+	 * Copies the elements of TargetArray and starts Work.
+	 * @param LatentInfo  the latent info of the node
+	 * @param TargetArray  pointer to the array to process
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray, if Apply modifies TargetArray. If
+	 *    it is destroyed, the action is cancelled. nullptr if Apply doesn't
+	 *    touch TargetArray.
+	 * @param Work  work on a background thread
+	 * @param Apply  work on the game thread after Work
+	 */
+	FAsyncArrayAction(const FLatentActionInfo& LatentInfo,
+	                  const void*              TargetArray,
+	                  const FArrayProperty&    ArrayProperty,
+	                  const UObject* TargetArrayOwner, FWork Work,
+	                  FApply Apply);
+
+	// destructor (cancels the work if still running, and waits for it)
+	virtual ~FAsyncArrayAction() override;
+
+public:
+	/**
+	 * Cancels the async array actions of which Object is the callback target.
+	 * Cancelled actions finish without triggering their output.
+	 */
+	static void CancelActions(const UObject& Object);
+
+public:
+	virtual void UpdateOperation(FLatentResponse& Response) override;
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override;
+#endif
+
+private:
+	// state used by the background work
+	struct FState;
+	const TUniquePtr<FState> State;
+
+	// the background work
+	TFuture<void> Task;
+
+	// work on the game thread after the background work
+	FApply Apply;
+
+	// the object that owns the target array, if Apply modifies it
+	const FWeakObjectPtr TargetArrayOwner;
+	const bool           bHasTargetArrayOwner;
+
+	// callback of the latent action
+	const FName          ExecutionFunction;
+	const int32          OutputLink;
+	const FWeakObjectPtr CallbackTarget;
+};
+} // namespace udon
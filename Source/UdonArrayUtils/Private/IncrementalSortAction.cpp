@@ -0,0 +1,204 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "IncrementalSortAction.h"
+
+#include "LogUdonArrayUtilsLibrary.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "SortAlgorithms.h"
+
+namespace udon {
+namespace {
+// number of comparisons between checks of the time budget
+constexpr int32 ComparisonsPerTimeCheck = 8;
+
+inline int32 GetElementSize(const FProperty& Property) {
+	return
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    Property.ElementSize
+#else
+	    Property.GetElementSize()
+#endif
+	    ;
+}
+} // namespace
+
+FIncrementalSortAction::FIncrementalSortAction(
+    const FLatentActionInfo& LatentInfo, void* const InTargetArray,
+    const FArrayProperty& InArrayProperty, UObject& InTargetArrayOwner,
+    const UObject* const InComparisonContext,
+    TFunction<bool(const void*, const void*)> InLess,
+    const double InTimeBudgetSeconds, const int32 InComparisonBudget)
+    : TargetArray(InTargetArray), ArrayProperty(InArrayProperty),
+      ElementSize(GetElementSize(*InArrayProperty.Inner)),
+      TargetArrayOwner(&InTargetArrayOwner),
+      ExecutionFunction(LatentInfo.ExecutionFunction),
+      OutputLink(LatentInfo.Linkage), CallbackTarget(LatentInfo.CallbackTarget),
+      ComparisonContext(InComparisonContext),
+      bHasComparisonContext(InComparisonContext != nullptr),
+      Less(MoveTemp(InLess)), TimeBudgetSeconds(InTimeBudgetSeconds),
+      ComparisonBudget(InComparisonBudget),
+      Num(static_cast<const FScriptArray*>(InTargetArray)->Num()) {
+	// initialize the indices
+	Indices[0].SetNumUninitialized(Num);
+	Indices[1].SetNumUninitialized(Num);
+	for (auto i = 0; i < Num; ++i) {
+		Indices[0][i] = i;
+	}
+
+	// set up the first merge
+	Right = FMath::Min(Width, Num);
+}
+
+void FIncrementalSortAction::UpdateOperation(FLatentResponse& Response) {
+	// if the object that owns the target array was destroyed
+	if (!TargetArrayOwner.IsValid()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("The object that owns the array was destroyed while "
+		            "sorting. The sort is cancelled."));
+
+		// finish without triggering the output
+		Response.DoneIf(true);
+		return;
+	}
+
+	// if the object of the comparison function was destroyed
+	if (bHasComparisonContext && !ComparisonContext.IsValid()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("The object of the comparison function was destroyed while "
+		            "sorting. The sort is cancelled."));
+
+		// finish without triggering the output
+		Response.DoneIf(true);
+		return;
+	}
+
+	// if elements were added or removed since the last tick
+	if (IsTargetArrayResized()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("The array was resized while sorting. The sort is "
+		            "cancelled."));
+
+		// finish without triggering the output
+		Response.DoneIf(true);
+		return;
+	}
+
+	// if the sort isn't finished within this tick
+	if (!Advance()) {
+		// continue on the next tick
+		return;
+	}
+
+	// if the comparison function resized the array
+	if (IsTargetArrayResized()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("The array was resized by the comparison function. The "
+		            "sort is cancelled."));
+
+		// finish without triggering the output
+		Response.DoneIf(true);
+		return;
+	}
+
+	// move the sorted elements to the target array
+	Complete();
+
+	Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink,
+	                            CallbackTarget);
+}
+
+#if WITH_EDITOR
+FString FIncrementalSortAction::GetDescription() const {
+	return FString::Printf(
+	    TEXT("Sorting %d elements (run width %d, %lld comparisons so far)"),
+	    Num, Width, NumComparisons);
+}
+#endif
+
+bool FIncrementalSortAction::Advance() {
+	// comparisons and time spent in this tick
+	const auto StartTime            = FPlatformTime::Seconds();
+	auto       NumComparisonsInTick = 0;
+
+	// whether a budget of this tick is used up
+	const auto IsBudgetExhausted = [&] {
+		if (ComparisonBudget > 0 && NumComparisonsInTick >= ComparisonBudget) {
+			return true;
+		}
+		return TimeBudgetSeconds > 0 &&
+		       NumComparisonsInTick % ComparisonsPerTimeCheck == 0 &&
+		       FPlatformTime::Seconds() - StartTime >= TimeBudgetSeconds;
+	};
+
+	// merge runs of Width until one run covers the whole array
+	while (Width < Num) {
+		const auto* const From = Indices[Source].GetData();
+		auto* const       To   = Indices[1 - Source].GetData();
+
+		const auto Mid  = FMath::Min(MergeFirst + Width, Num);
+		const auto Last = FMath::Min(MergeFirst + Width * 2, Num);
+
+		// merge the left run [MergeFirst, Mid) and the right run [Mid, Last)
+		while (Left < Mid && Right < Last) {
+			// if a budget is used up (each tick makes at least one comparison)
+			if (NumComparisonsInTick > 0 && IsBudgetExhausted()) {
+				// resume from here on the next tick
+				return false;
+			}
+
+			// take the right element only if it precedes the left one, so that
+			// equivalent elements keep their order
+			if (Less(GetElement(From[Right]), GetElement(From[Left]))) {
+				To[Out++] = From[Right++];
+			} else {
+				To[Out++] = From[Left++];
+			}
+
+			++NumComparisonsInTick;
+			++NumComparisons;
+		}
+
+		// move the rest of the runs
+		while (Left < Mid) {
+			To[Out++] = From[Left++];
+		}
+		while (Right < Last) {
+			To[Out++] = From[Right++];
+		}
+
+		// go to the next pair of runs
+		MergeFirst = Last;
+
+		// if all pairs of runs of this width are merged
+		if (MergeFirst >= Num) {
+			// merge the merged runs next
+			Source     = 1 - Source;
+			Width      = Width * 2;
+			MergeFirst = 0;
+		}
+
+		// set up the next merge
+		Left  = MergeFirst;
+		Right = FMath::Min(MergeFirst + Width, Num);
+		Out   = MergeFirst;
+	}
+
+	return true;
+}
+
+void FIncrementalSortAction::Complete() {
+	// move the elements to their sorted positions
+	FScriptArrayHelper TargetArrayHelper(&ArrayProperty, TargetArray);
+	ApplyPermutation(TargetArrayHelper, ElementSize, Indices[Source]);
+
+	// notify that the target array was changed
+	if (auto* const Owner = TargetArrayOwner.Get()) {
+		MARK_PROPERTY_DIRTY(Owner, &ArrayProperty);
+	}
+}
+} // namespace udon
@@ -0,0 +1,118 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/LatentActionManager.h"
+#include "LatentActions.h"
+#include "UObject/UnrealType.h"
+
+namespace udon {
+/**
+ * A latent action that sorts an array over several ticks.
+ * The indices of the elements of the target array are sorted by a bottom-up
+ * merge sort that can stop after any comparison and resume on the next tick.
+ * The elements stay in the target array, so that the garbage collector keeps
+ * seeing the objects they reference, and are moved to their sorted positions
+ * at once when the sort is finished, so the target array is never seen
+ * partially sorted. If the length of the target array changes while sorting,
+ * or the object that owns it is destroyed, the sort is cancelled. The sort is
+ * stable.
+ */
+class FIncrementalSortAction : public FPendingLatentAction {
+public:
+	/**
+	 * @param LatentInfo  the latent info of the node
+	 * @param InTargetArray  pointer to sort target array
+	 * @param InArrayProperty  property of InTargetArray
+	 * @param InTargetArrayOwner
+	 *    The object that owns InTargetArray. If it is destroyed, the sort is
+	 *    cancelled.
+	 * @param InComparisonContext
+	 *    An object that must be alive to call InLess (nullptr if none). If it
+	 *    is destroyed, the sort is cancelled.
+	 * @param InLess
+	 *    returns whether the first element should precede the second
+	 * @param InTimeBudgetSeconds
+	 *    time spent comparing elements per tick (<= 0 for no limit)
+	 * @param InComparisonBudget
+	 *    number of comparisons per tick (<= 0 for no limit)
+	 */
+	FIncrementalSortAction(const FLatentActionInfo& LatentInfo,
+	                       void*                    InTargetArray,
+	                       const FArrayProperty&    InArrayProperty,
+	                       UObject&                 InTargetArrayOwner,
+	                       const UObject*           InComparisonContext,
+	                       TFunction<bool(const void*, const void*)> InLess,
+	                       double InTimeBudgetSeconds,
+	                       int32  InComparisonBudget);
+
+public:
+	virtual void UpdateOperation(FLatentResponse& Response) override;
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override;
+#endif
+
+private:
+	// advance the sort within the budgets. returns true when finished.
+	bool Advance();
+
+	// move the elements of the target array to their sorted positions
+	void Complete();
+
+	// whether the length of the target array was changed since the start
+	bool IsTargetArrayResized() const {
+		return static_cast<const FScriptArray*>(TargetArray)->Num() != Num;
+	}
+
+	// get pointer to the element of the target array at Index
+	const void* GetElement(const int32 Index) const {
+		return static_cast<const uint8*>(
+		           static_cast<const FScriptArray*>(TargetArray)->GetData()) +
+		       static_cast<int64>(Index) * ElementSize;
+	}
+
+private:
+	// the target array and its property
+	void* const           TargetArray;
+	const FArrayProperty& ArrayProperty;
+	const int32           ElementSize;
+
+	// the object that owns the target array
+	const TWeakObjectPtr<UObject> TargetArrayOwner;
+
+	// callback of the latent action
+	const FName          ExecutionFunction;
+	const int32          OutputLink;
+	const FWeakObjectPtr CallbackTarget;
+
+	// object of the comparison function
+	const TWeakObjectPtr<const UObject> ComparisonContext;
+	const bool                          bHasComparisonContext;
+
+	// comparison function and budgets
+	const TFunction<bool(const void*, const void*)> Less;
+	const double                                    TimeBudgetSeconds;
+	const int32                                     ComparisonBudget;
+
+	// number of the elements being sorted
+	const int32 Num;
+
+	// indices being merged: read from Indices[Source], written to the other
+	TArray<int32> Indices[2];
+	int32         Source = 0;
+
+	// state of the merge sort: the width of the runs being merged, the first
+	// index of the current merge, and the cursors of the left run, the right
+	// run and the output
+	int32 Width      = 1;
+	int32 MergeFirst = 0;
+	int32 Left       = 0;
+	int32 Right      = 0;
+	int32 Out        = 0;
+
+	// total number of comparisons, for the description
+	int64 NumComparisons = 0;
+};
+} // namespace udon
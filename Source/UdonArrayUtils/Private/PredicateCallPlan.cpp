@@ -0,0 +1,493 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "PredicateCallPlan.h"
+
+#include "LogUdonArrayUtilsLibrary.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeLock.h"
+
+namespace udon {
+namespace {
+/**
+ * Returns the object that distinguishes properties of the same field class
+ * (e.g. the struct of FStructProperty).
+ */
+const UObject* GetPropertyTypeObject(const FProperty& Property) {
+	if (const auto* const StructProperty = CastField<FStructProperty>(&Property)) {
+		return StructProperty->Struct;
+	}
+	if (const auto* const ClassProperty = CastField<FClassProperty>(&Property)) {
+		return ClassProperty->MetaClass;
+	}
+	if (const auto* const SoftClassProperty =
+	        CastField<FSoftClassProperty>(&Property)) {
+		return SoftClassProperty->MetaClass;
+	}
+	if (const auto* const ObjectProperty =
+	        CastField<FObjectPropertyBase>(&Property)) {
+		return ObjectProperty->PropertyClass;
+	}
+	if (const auto* const InterfaceProperty =
+	        CastField<FInterfaceProperty>(&Property)) {
+		return InterfaceProperty->InterfaceClass;
+	}
+	if (const auto* const EnumProperty = CastField<FEnumProperty>(&Property)) {
+		return EnumProperty->GetEnum();
+	}
+	if (const auto* const ByteProperty = CastField<FByteProperty>(&Property)) {
+		return ByteProperty->Enum;
+	}
+
+	return nullptr;
+}
+
+inline int32 GetElementSize(const FProperty& Property) {
+	return
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    Property.ElementSize
+#else
+	    Property.GetElementSize()
+#endif
+	    ;
+}
+
+/**
+ * Whether Function can be called through its native thunk. Native functions
+ * are, unless ProcessEvent has to decide where they run (RPCs, authority-only
+ * or cosmetic functions).
+ */
+bool CanCallNativeThunk(const UFunction& Function) {
+	return Function.HasAnyFunctionFlags(FUNC_Native) &&
+	       Function.GetNativeFunc() != nullptr &&
+	       !Function.HasAnyFunctionFlags(FUNC_Net | FUNC_BlueprintAuthorityOnly |
+	                                     FUNC_BlueprintCosmetic);
+}
+
+// key of the plan cache
+struct FPlanKey {
+	const UFunction*   Function;
+	const FFieldClass* ElementFieldClass;
+	const UObject*     ElementTypeObject;
+	int32              NumArguments;
+
+	bool operator==(const FPlanKey& Other) const noexcept {
+		return Function == Other.Function &&
+		       ElementFieldClass == Other.ElementFieldClass &&
+		       ElementTypeObject == Other.ElementTypeObject &&
+		       NumArguments == Other.NumArguments;
+	}
+
+	friend uint32 GetTypeHash(const FPlanKey& Key) {
+		auto Hash = GetTypeHash(Key.Function);
+		Hash      = HashCombine(Hash, GetTypeHash(Key.ElementFieldClass));
+		Hash      = HashCombine(Hash, GetTypeHash(Key.ElementTypeObject));
+		return HashCombine(Hash, GetTypeHash(Key.NumArguments));
+	}
+};
+
+// key of the function cache
+struct FFunctionKey {
+	const UClass* Class;
+	FName         FunctionName;
+
+	bool operator==(const FFunctionKey& Other) const noexcept {
+		return Class == Other.Class && FunctionName == Other.FunctionName;
+	}
+
+	friend uint32 GetTypeHash(const FFunctionKey& Key) {
+		return HashCombine(GetTypeHash(Key.Class), GetTypeHash(Key.FunctionName));
+	}
+};
+
+// value of the function cache
+struct FFunctionCacheEntry {
+	TWeakObjectPtr<UClass>    Class;
+	TWeakObjectPtr<UFunction> Function;
+};
+
+FCriticalSection& GetCacheLock() {
+	static FCriticalSection CacheLock;
+	return CacheLock;
+}
+
+TMap<FPlanKey, TSharedPtr<FPredicateCallPlan, ESPMode::ThreadSafe>>&
+    GetPlanCache() {
+	static TMap<FPlanKey, TSharedPtr<FPredicateCallPlan, ESPMode::ThreadSafe>>
+	    PlanCache;
+	return PlanCache;
+}
+
+TMap<FFunctionKey, FFunctionCacheEntry>& GetFunctionCache() {
+	static TMap<FFunctionKey, FFunctionCacheEntry> FunctionCache;
+	return FunctionCache;
+}
+} // namespace
+
+FPredicateCallFrame::FPredicateCallFrame(const FPredicateCallPlan& InPlan)
+    : Plan(InPlan),
+      Parms(static_cast<uint8*>(
+          FMemory::Malloc(FMath::Max(InPlan.ParmsSize, 1),
+                          FMath::Max(InPlan.ParmsAlignment, 1)))) {
+	// clear the frame (the parameters are only copied bitwise)
+	FMemory::Memzero(Parms, FMath::Max(Plan.ParmsSize, 1));
+
+	// if the function is called through its native thunk
+	if (Plan.bCallNativeThunk) {
+		// create out parameter records in the same way as ProcessEvent
+		for (TFieldIterator<FProperty> It(Plan.Function);
+		     It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+			if (It->HasAnyPropertyFlags(CPF_OutParm)) {
+				OutParms.Add(FOutParmRec{
+				    *It, It->ContainerPtrToValuePtr<uint8>(Parms), nullptr});
+			}
+		}
+
+		// link the records
+		for (auto i = 0; i + 1 < OutParms.Num(); ++i) {
+			OutParms[i].NextOutParm = &OutParms[i + 1];
+		}
+	}
+}
+
+FPredicateCallFrame::~FPredicateCallFrame() noexcept {
+	FMemory::Free(Parms);
+}
+
+const void* FPredicateCallFrame::Invoke(UObject&                 Context,
+                                        const void* const* const Arguments) {
+	// pass the arguments to the frame
+	for (auto i = 0; i < Plan.ArgumentOffsets.Num(); ++i) {
+		// if the argument is bound by reference
+		if (const auto OutParmIndex = Plan.ArgumentOutParmIndices[i];
+		    OutParmIndex != INDEX_NONE) {
+			// point the out parameter record to the element itself
+			OutParms[OutParmIndex].PropAddr =
+			    static_cast<uint8*>(const_cast<void*>(Arguments[i]));
+		}
+		// otherwise, copy the element to the frame
+		else {
+			FMemory::Memcpy(Parms + Plan.ArgumentOffsets[i], Arguments[i],
+			                Plan.ElementSize);
+		}
+	}
+
+	// call the function
+	Call(Context);
+
+	// return the pointer to the return value
+	return Parms + Plan.ReturnValueOffset;
+}
+
+void FPredicateCallFrame::InvokeBatch(UObject&            Context,
+                                      FScriptArrayHelper& ArrayHelper,
+                                      const int32 First, const int32 Count,
+                                      TArray<bool>& OutResults) {
+	check(Plan.IsBatchPredicate());
+
+	// get the chunk argument in this frame
+	const auto* const ArgumentProperty = Plan.BatchArgumentProperty;
+	const auto* const ElementProperty  = ArgumentProperty->Inner;
+	FScriptArrayHelper ChunkHelper(ArgumentProperty,
+	                               Parms + Plan.ArgumentOffsets[0]);
+
+	// copy the elements of the chunk
+	ChunkHelper.Resize(Count);
+	if (ElementProperty->HasAnyPropertyFlags(CPF_IsPlainOldData)) {
+		FMemory::Memcpy(ChunkHelper.GetRawPtr(0), ArrayHelper.GetRawPtr(First),
+		                static_cast<SIZE_T>(Count) * Plan.ElementSize);
+	} else {
+		for (auto i = 0; i < Count; ++i) {
+			ElementProperty->CopySingleValue(ChunkHelper.GetRawPtr(i),
+			                                 ArrayHelper.GetRawPtr(First + i));
+		}
+	}
+
+	// call the function
+	Call(Context);
+
+	// get the returned array
+	FScriptArrayHelper ResultHelper(Plan.BatchReturnProperty,
+	                                Parms + Plan.ReturnValueOffset);
+
+	// if the length of the returned array is different from the chunk
+	const auto NumResults = ResultHelper.Num();
+	if (NumResults != Count) {
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Batch predicate '%s' returned %d result(s) for %d "
+		            "element(s). Missing results are treated as false."),
+		       *Plan.Function->GetName(), NumResults, Count);
+	}
+
+	// copy the results
+	OutResults.SetNumUninitialized(Count);
+	for (auto i = 0; i < Count; ++i) {
+		OutResults[i] = i < NumResults &&
+		                *reinterpret_cast<const bool*>(ResultHelper.GetRawPtr(i));
+	}
+}
+
+void FPredicateCallFrame::ResetBatchValues() {
+	// if not a batch predicate
+	if (!Plan.IsBatchPredicate()) {
+		// nothing to do
+		return;
+	}
+
+	// destroy the chunk argument and the returned array, and clear them so that
+	// they can be used as empty arrays again
+	auto* const ArgumentAddr = Parms + Plan.ArgumentOffsets[0];
+	auto* const ReturnAddr   = Parms + Plan.ReturnValueOffset;
+	Plan.BatchArgumentProperty->DestroyValue(ArgumentAddr);
+	Plan.BatchReturnProperty->DestroyValue(ReturnAddr);
+	FMemory::Memzero(ArgumentAddr, Plan.BatchArgumentProperty->GetSize());
+	FMemory::Memzero(ReturnAddr, Plan.BatchReturnProperty->GetSize());
+}
+
+void FPredicateCallFrame::Call(UObject& Context) {
+	// if the function has a native body
+	if (Plan.bCallNativeThunk) {
+		// create a stack frame reading the parameters from Parms
+		FFrame Stack(&Context, Plan.Function, Parms, nullptr,
+		             Plan.Function->ChildProperties);
+		Stack.OutParms = OutParms.Num() > 0 ? OutParms.GetData() : nullptr;
+
+		// call the native thunk directly
+		Plan.Function->Invoke(&Context, Stack, Parms + Plan.ReturnValueOffset);
+	}
+	// otherwise, the function runs on the script VM
+	else {
+		Context.ProcessEvent(Plan.Function, Parms);
+	}
+}
+
+TSharedPtr<FPredicateCallPlan, ESPMode::ThreadSafe>
+    FPredicateCallPlan::FindOrCreate(UFunction&       Function,
+                                     const FProperty& ElementProperty,
+                                     const int32      NumArguments) {
+	// create the key
+	const FPlanKey Key{&Function, ElementProperty.GetClass(),
+	                   GetPropertyTypeObject(ElementProperty), NumArguments};
+
+	FScopeLock Lock(&GetCacheLock());
+
+	// if a plan of the live function is cached
+	if (const auto* const CachedPlan = GetPlanCache().Find(Key);
+	    CachedPlan && (*CachedPlan)->WeakFunction.IsValid()) {
+		// return it
+		return *CachedPlan;
+	}
+
+	// build a new plan
+	TSharedPtr<FPredicateCallPlan, ESPMode::ThreadSafe> Plan(
+	    new FPredicateCallPlan());
+	if (!Plan->Build(Function, ElementProperty, NumArguments)) {
+		return nullptr;
+	}
+
+	// drop plans of destroyed functions
+	for (auto It = GetPlanCache().CreateIterator(); It; ++It) {
+		if (!It->Value->WeakFunction.IsValid()) {
+			It.RemoveCurrent();
+		}
+	}
+
+	// cache the new plan
+	GetPlanCache().Add(Key, Plan);
+
+	return Plan;
+}
+
+UFunction* FPredicateCallPlan::FindFunction(const UObject& Object,
+                                            const FName&   FunctionName) {
+	// get class of Object
+	auto* const Class = Object.GetClass();
+
+	// create the key
+	const FFunctionKey Key{Class, FunctionName};
+
+	FScopeLock Lock(&GetCacheLock());
+
+	// if the function of the live class is cached
+	if (const auto* const Entry = GetFunctionCache().Find(Key);
+	    Entry && Entry->Class.IsValid()) {
+		// if the function is still alive and still belongs to the class or one
+		// of its super classes. a recompiled Blueprint class gets new
+		// functions, and its old functions are moved out of it.
+		auto* const Function = Entry->Function.Get();
+		const auto* const OwnerClass =
+		    Function ? Cast<UClass>(Function->GetOuter()) : nullptr;
+		if (OwnerClass && Class->IsChildOf(OwnerClass)) {
+			// return it
+			return Function;
+		}
+	}
+
+	// find the function
+	auto* const Function = Object.FindFunction(FunctionName);
+
+	// if found, cache it (not-found results are not cached)
+	if (Function) {
+		// drop entries of destroyed classes or functions
+		for (auto It = GetFunctionCache().CreateIterator(); It; ++It) {
+			if (!It->Value.Class.IsValid() || !It->Value.Function.IsValid()) {
+				It.RemoveCurrent();
+			}
+		}
+
+		GetFunctionCache().Add(Key, FFunctionCacheEntry{Class, Function});
+	}
+
+	return Function;
+}
+
+FPredicateCallPlan::~FPredicateCallPlan() noexcept {
+	// delete pooled frames
+	for (auto* const Frame : FreeFrames) {
+		delete Frame;
+	}
+}
+
+std::shared_ptr<FPredicateCallFrame> FPredicateCallPlan::AcquireFrame() {
+	FPredicateCallFrame* Frame = nullptr;
+
+	// take a pooled frame if any
+	{
+		FScopeLock Lock(&FramesLock);
+		if (FreeFrames.Num() > 0) {
+			Frame = FreeFrames.Pop();
+		}
+	}
+
+	// otherwise, create a new frame
+	if (!Frame) {
+		Frame = new FPredicateCallFrame(*this);
+	}
+
+	// return the frame to the pool on release (keeps this plan alive)
+	return std::shared_ptr<FPredicateCallFrame>(
+	    Frame, [PlanRef = AsShared()](FPredicateCallFrame* const ReleasedFrame) {
+		    ReleasedFrame->ResetBatchValues();
+
+		    FScopeLock Lock(&PlanRef->FramesLock);
+		    PlanRef->FreeFrames.Push(ReleasedFrame);
+	    });
+}
+
+bool FPredicateCallPlan::Build(UFunction&       InFunction,
+                               const FProperty& ElementProperty,
+                               const int32      NumArguments) {
+	Function     = &InFunction;
+	WeakFunction = &InFunction;
+	ElementSize  = GetElementSize(ElementProperty);
+
+	// if a unary predicate is requested and Function is a batch predicate
+	if (NumArguments == 1 && BuildBatch(InFunction, ElementProperty)) {
+		return true;
+	}
+
+	// native functions are called through their thunk
+	bCallNativeThunk = CanCallNativeThunk(InFunction);
+
+	// index of the next out parameter record in a frame
+	auto NextOutParmIndex = 0;
+
+	// collect offsets of the arguments
+	for (TFieldIterator<FProperty> It(&InFunction);
+	     It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+		// get index of the out parameter record of the parameter
+		const auto OutParmIndex =
+		    It->HasAnyPropertyFlags(CPF_OutParm) ? NextOutParmIndex++ : INDEX_NONE;
+
+		// skip the return value
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm)) {
+			continue;
+		}
+
+		// if the argument is not the same type as the elements
+		if (!It->SameType(&ElementProperty)) {
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Argument '%s' of '%s' is not the same type as the "
+			            "array elements."),
+			       *It->GetName(), *InFunction.GetName());
+			return false;
+		}
+
+		ArgumentOffsets.Add(It->GetOffset_ForUFunction());
+
+		// a const reference parameter (UPARAM(ref) const T&) of a native
+		// function reads the element through its out parameter record, so the
+		// element doesn't have to be copied
+		const auto bBindByReference =
+		    bCallNativeThunk && OutParmIndex != INDEX_NONE &&
+		    It->HasAllPropertyFlags(CPF_ConstParm | CPF_ReferenceParm);
+		ArgumentOutParmIndices.Add(bBindByReference ? OutParmIndex : INDEX_NONE);
+	}
+
+	// if the number of arguments is different
+	if (ArgumentOffsets.Num() != NumArguments) {
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("'%s' must have %d argument(s), but has %d."),
+		       *InFunction.GetName(), NumArguments, ArgumentOffsets.Num());
+		return false;
+	}
+
+	// if the function doesn't return a bool
+	const auto* const ReturnProperty = InFunction.GetReturnProperty();
+	if (!ReturnProperty || !ReturnProperty->IsA<FBoolProperty>()) {
+		UE_LOG(LogUdonArrayUtilsLibrary, Error, TEXT("'%s' must return a bool."),
+		       *InFunction.GetName());
+		return false;
+	}
+
+	ReturnValueOffset = ReturnProperty->GetOffset_ForUFunction();
+	ParmsSize         = InFunction.ParmsSize;
+	ParmsAlignment    = InFunction.GetMinAlignment();
+
+	return true;
+}
+
+bool FPredicateCallPlan::BuildBatch(UFunction&       InFunction,
+                                    const FProperty& ElementProperty) {
+	FArrayProperty* ArgumentProperty = nullptr;
+
+	// find the only argument
+	for (TFieldIterator<FProperty> It(&InFunction);
+	     It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+		// skip the return value
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm)) {
+			continue;
+		}
+
+		// if there are two or more arguments
+		if (ArgumentProperty) {
+			return false;
+		}
+
+		// if the argument is not an array of the elements
+		ArgumentProperty = CastField<FArrayProperty>(*It);
+		if (!ArgumentProperty ||
+		    !ArgumentProperty->Inner->SameType(&ElementProperty)) {
+			return false;
+		}
+	}
+
+	// if the function doesn't return an array of bools
+	auto* const ReturnProperty =
+	    CastField<FArrayProperty>(InFunction.GetReturnProperty());
+	if (!ArgumentProperty || !ReturnProperty ||
+	    !ReturnProperty->Inner->IsA<FBoolProperty>()) {
+		return false;
+	}
+
+	BatchArgumentProperty = ArgumentProperty;
+	BatchReturnProperty   = ReturnProperty;
+	ArgumentOffsets.Add(ArgumentProperty->GetOffset_ForUFunction());
+	ArgumentOutParmIndices.Add(INDEX_NONE);
+	ReturnValueOffset = ReturnProperty->GetOffset_ForUFunction();
+	ParmsSize         = InFunction.ParmsSize;
+	ParmsAlignment    = InFunction.GetMinAlignment();
+	bCallNativeThunk  = CanCallNativeThunk(InFunction);
+
+	return true;
+}
+} // namespace udon
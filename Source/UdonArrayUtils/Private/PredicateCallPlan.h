@@ -0,0 +1,173 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Stack.h"
+#include "UObject/UnrealType.h"
+
+#include <memory>
+
+namespace udon {
+class FPredicateCallPlan;
+
+/**
+ * A parameter frame to call the UFunction of a FPredicateCallPlan.
+ * Frames are pooled by the plan and reused across calls.
+ */
+class FPredicateCallFrame {
+public:
+	// constructor
+	explicit FPredicateCallFrame(const FPredicateCallPlan& InPlan);
+
+	// destructor
+	~FPredicateCallFrame() noexcept;
+
+	// non-copyable
+	FPredicateCallFrame(const FPredicateCallFrame&)            = delete;
+	FPredicateCallFrame& operator=(const FPredicateCallFrame&) = delete;
+
+public:
+	/**
+	 * Calls the function of the plan.
+	 * @param Context  An object on which the function is called.
+	 * @param Arguments
+	 *    Pointers to the elements passed as the arguments. The number of
+	 *    pointers must be the number of arguments of the plan. Elements bound
+	 *    by reference are read in place and must not move during the call.
+	 * @return  A pointer to the return value in this frame.
+	 */
+	const void* Invoke(UObject& Context, const void* const* Arguments);
+
+	/**
+	 * Calls the batch predicate of the plan with a chunk of elements.
+	 * @param Context  An object on which the function is called.
+	 * @param ArrayHelper  helper of the array containing the elements
+	 * @param First  the index of the first element of the chunk
+	 * @param Count  the number of elements of the chunk
+	 * @param[out] OutResults  results for each element of the chunk
+	 */
+	void InvokeBatch(UObject& Context, FScriptArrayHelper& ArrayHelper,
+	                 int32 First, int32 Count, TArray<bool>& OutResults);
+
+	/**
+	 * Destroys the values held by this frame for batch calls.
+	 */
+	void ResetBatchValues();
+
+private:
+	// call the function with the arguments already in Parms
+	void Call(UObject& Context);
+
+private:
+	const FPredicateCallPlan& Plan;
+	uint8* const              Parms;
+
+	// out parameter records for the native dispatch
+	TArray<FOutParmRec, TInlineAllocator<3>> OutParms;
+};
+
+/**
+ * A resolved plan to call a predicate UFunction with array elements.
+ * A plan is built once per (function, element type, number of arguments),
+ * validated at build time, and cached for the process lifetime of the
+ * function.
+ */
+class FPredicateCallPlan
+    : public TSharedFromThis<FPredicateCallPlan, ESPMode::ThreadSafe> {
+	friend class FPredicateCallFrame;
+
+public:
+	/**
+	 * Finds a cached plan, or builds a new one.
+	 * @param Function  the predicate function
+	 * @param ElementProperty  property of the elements passed to Function
+	 * @param NumArguments  number of elements passed to Function at once
+	 * @return
+	 *    The plan. If Function can't be called with the elements, an error is
+	 *    logged and nullptr is returned.
+	 */
+	static TSharedPtr<FPredicateCallPlan, ESPMode::ThreadSafe>
+	    FindOrCreate(UFunction& Function, const FProperty& ElementProperty,
+	                 int32 NumArguments);
+
+	/**
+	 * Finds a function named FunctionName on Object. Results are cached per
+	 * class, and looked up again once the cached function no longer belongs
+	 * to the class (e.g. after the Blueprint is recompiled).
+	 * @return  the function, or nullptr if not found.
+	 */
+	static UFunction* FindFunction(const UObject& Object,
+	                               const FName&   FunctionName);
+
+public:
+	// number of elements passed to a batch predicate at once
+	static constexpr int32 BatchChunkSize = 256;
+
+public:
+	// destructor
+	~FPredicateCallPlan() noexcept;
+
+public:
+	/**
+	 * Whether the function is a batch predicate, which takes an array of
+	 * elements and returns an array of bools.
+	 */
+	[[nodiscard]] bool IsBatchPredicate() const noexcept {
+		return BatchArgumentProperty != nullptr;
+	}
+
+public:
+	/**
+	 * Acquires a parameter frame from the pool of this plan. The frame is
+	 * returned to the pool when the last copy of the pointer is released.
+	 */
+	std::shared_ptr<FPredicateCallFrame> AcquireFrame();
+
+private:
+	// constructor
+	FPredicateCallPlan() = default;
+
+	// build the layout of Function. returns false if not callable.
+	bool Build(UFunction& InFunction, const FProperty& ElementProperty,
+	           int32 NumArguments);
+
+	// build the layout of Function as a batch predicate, if it is one.
+	bool BuildBatch(UFunction& InFunction, const FProperty& ElementProperty);
+
+private:
+	// the predicate function
+	UFunction* Function = nullptr;
+
+	// to check whether Function is still alive
+	TWeakObjectPtr<UFunction> WeakFunction;
+
+	// offsets of element arguments in a parameter frame
+	TArray<int32, TInlineAllocator<2>> ArgumentOffsets;
+
+	// indices of the out parameter records through which element arguments
+	// are bound by reference (INDEX_NONE if the element is copied)
+	TArray<int32, TInlineAllocator<2>> ArgumentOutParmIndices;
+
+	// size of one element
+	int32 ElementSize = 0;
+
+	// offset of the return value in a parameter frame
+	int32 ReturnValueOffset = 0;
+
+	// the array argument and return value of a batch predicate
+	FArrayProperty* BatchArgumentProperty = nullptr;
+	FArrayProperty* BatchReturnProperty   = nullptr;
+
+	// whether Function is called through its native thunk, not ProcessEvent
+	bool bCallNativeThunk = false;
+
+	// size and alignment of a parameter frame
+	int32 ParmsSize      = 0;
+	int32 ParmsAlignment = 0;
+
+	// pool of frames not currently in use
+	FCriticalSection            FramesLock;
+	TArray<FPredicateCallFrame*> FreeFrames;
+};
+} // namespace udon
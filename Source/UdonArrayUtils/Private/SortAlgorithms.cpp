@@ -0,0 +1,593 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "SortAlgorithms.h"
+
+#include "ArrayKernels.h"
+#include "Async/ParallelFor.h"
+#include "Misc/EngineVersionComparison.h"
+
+#include <algorithm>
+
+namespace udon {
+namespace {
+// below this number of keys, a comparison sort is faster than radix passes
+constexpr int32 MinNumToRadixSort = 64;
+
+// maximum size of a scratch buffer kept on a thread after a sort. Larger
+// buffers are freed, so that one sort of a huge array doesn't hold its memory
+// for the lifetime of the thread.
+constexpr SIZE_T MaxRetainedScratchBytes = 1024 * 1024;
+
+// scratch buffer of RadixSort, reused across calls on each thread
+TArray<FSortKeyIndex>& GetRadixSortScratch() {
+	thread_local TArray<FSortKeyIndex> Scratch;
+	return Scratch;
+}
+
+// scratch buffer of StableSort, reused across calls on each thread. A sort
+// takes the buffer while running (see StableSort).
+TArray<uint8>& GetStableSortScratch() {
+	thread_local TArray<uint8> Scratch;
+	return Scratch;
+}
+
+/**
+ * Merge sort on raw element bytes, used by StableSort.
+ */
+class FRawMergeSorter {
+public:
+	FRawMergeSorter(
+	    uint8* const InData, const int32 InNum, const int32 InElementSize,
+	    const TFunctionRef<bool(const void*, const void*)> InLess,
+	    uint8* const                                       InScratch)
+	    : Data(InData), Num(InNum), ElementSize(InElementSize), Less(InLess),
+	      Scratch(InScratch) {}
+
+public:
+	/**
+	 * Returns the minimum run length for Num elements, in the same way as
+	 * TimSort (between 32 and 64 so that Num / MinRun is close to a power of 2).
+	 */
+	static int32 ComputeMinRun(int32 Num) {
+		auto Remainder = 0;
+		while (Num >= 64) {
+			Remainder |= Num & 1;
+			Num >>= 1;
+		}
+		return Num + Remainder;
+	}
+
+	void Sort(const bool bAdaptive, const std::atomic<bool>* const bCancelled) {
+		const auto MinRun = ComputeMinRun(Num);
+
+		// split the array into sorted runs
+		TArray<int32, TInlineAllocator<64>> RunStarts;
+		for (auto Start = 0; Start < Num;) {
+			RunStarts.Add(Start);
+
+			// length of the run already sorted at Start
+			auto SortedLength = 1;
+			if (bAdaptive) {
+				SortedLength = CountRunAndMakeAscending(Start);
+			}
+
+			// extend a short run to MinRun elements with insertion sort
+			const auto End = FMath::Max(Start + SortedLength,
+			                            FMath::Min(Start + MinRun, Num));
+			BinaryInsertionSort(Start, Start + SortedLength, End);
+
+			Start = End;
+		}
+		RunStarts.Add(Num);
+
+		// merge adjacent runs until one run remains
+		while (RunStarts.Num() > 2) {
+			// if cancelled
+			if (bCancelled && bCancelled->load(std::memory_order_relaxed)) {
+				// finish
+				return;
+			}
+
+			auto NumMerged = 0;
+			for (auto i = 0; i + 2 < RunStarts.Num(); i += 2) {
+				Merge(RunStarts[i], RunStarts[i + 1], RunStarts[i + 2]);
+				RunStarts[NumMerged++] = RunStarts[i];
+			}
+
+			// keep the last run if the number of runs is odd
+			if (RunStarts.Num() % 2 == 0) {
+				RunStarts[NumMerged++] = RunStarts[RunStarts.Num() - 2];
+			}
+			RunStarts[NumMerged++] = Num;
+			RunStarts.SetNum(NumMerged);
+		}
+	}
+
+private:
+	[[nodiscard]] uint8* At(const int32 Index) const noexcept {
+		return Data + static_cast<SIZE_T>(Index) * ElementSize;
+	}
+
+	void Copy(void* const Dest, const void* const Src, const int32 Count) const {
+		FMemory::Memmove(Dest, Src, static_cast<SIZE_T>(Count) * ElementSize);
+	}
+
+	/**
+	 * Returns the length of the run starting at Start. If the run is strictly
+	 * descending, reverses it (strict, so that the order of equal elements
+	 * is kept).
+	 */
+	int32 CountRunAndMakeAscending(const int32 Start) {
+		auto End = Start + 1;
+		if (End == Num) {
+			return 1;
+		}
+
+		// if descending
+		if (Less(At(End), At(Start))) {
+			while (End + 1 < Num && Less(At(End + 1), At(End))) {
+				++End;
+			}
+			++End;
+			Reverse(Start, End);
+		} else {
+			while (End + 1 < Num && !Less(At(End + 1), At(End))) {
+				++End;
+			}
+			++End;
+		}
+
+		return End - Start;
+	}
+
+	void Reverse(int32 First, int32 Last) {
+		for (--Last; First < Last; ++First, --Last) {
+			FMemory::Memswap(At(First), At(Last), ElementSize);
+		}
+	}
+
+	/**
+	 * Sorts [First, Last) with binary insertion, where [First, Sorted) is
+	 * already sorted.
+	 */
+	void BinaryInsertionSort(const int32 First, const int32 Sorted,
+	                         const int32 Last) {
+		for (auto i = Sorted; i < Last; ++i) {
+			// take the element out
+			Copy(Scratch, At(i), 1);
+
+			// find the position after equal elements
+			const auto Position = UpperBound(First, i, Scratch);
+
+			// shift the elements after the position and insert
+			Copy(At(Position + 1), At(Position), i - Position);
+			Copy(At(Position), Scratch, 1);
+		}
+	}
+
+	// first index in [First, Last) whose element Value should precede
+	int32 UpperBound(int32 First, int32 Last, const void* const Value) const {
+		while (First < Last) {
+			const auto Middle = First + (Last - First) / 2;
+			if (Less(Value, At(Middle))) {
+				Last = Middle;
+			} else {
+				First = Middle + 1;
+			}
+		}
+		return First;
+	}
+
+	// first index in [First, Last) whose element doesn't precede Value
+	int32 LowerBound(int32 First, int32 Last, const void* const Value) const {
+		while (First < Last) {
+			const auto Middle = First + (Last - First) / 2;
+			if (Less(At(Middle), Value)) {
+				First = Middle + 1;
+			} else {
+				Last = Middle;
+			}
+		}
+		return First;
+	}
+
+	// merge sorted [First, Middle) and [Middle, Last)
+	void Merge(int32 First, const int32 Middle, int32 Last) {
+		// if already in order
+		if (!Less(At(Middle), At(Middle - 1))) {
+			return;
+		}
+
+		// skip the elements of the left run that are already in place
+		First = UpperBound(First, Middle, At(Middle));
+
+		// skip the elements of the right run that are already in place
+		Last = LowerBound(Middle, Last, At(Middle - 1));
+
+		// copy the smaller run to the scratch buffer
+		if (Middle - First <= Last - Middle) {
+			MergeLow(First, Middle, Last);
+		} else {
+			MergeHigh(First, Middle, Last);
+		}
+	}
+
+	// merge from the front, with the left run in the scratch buffer
+	void MergeLow(const int32 First, const int32 Middle, const int32 Last) {
+		const auto NumLeft = Middle - First;
+		Copy(Scratch, At(First), NumLeft);
+
+		auto Left  = 0;
+		auto Right = Middle;
+		auto Dest  = First;
+		while (Left < NumLeft && Right < Last) {
+			auto* const LeftPtr =
+			    Scratch + static_cast<SIZE_T>(Left) * ElementSize;
+			if (Less(At(Right), LeftPtr)) {
+				Copy(At(Dest++), At(Right++), 1);
+			} else {
+				Copy(At(Dest++), LeftPtr, 1);
+				++Left;
+			}
+		}
+
+		// the rest of the right run is already in place
+		Copy(At(Dest), Scratch + static_cast<SIZE_T>(Left) * ElementSize,
+		     NumLeft - Left);
+	}
+
+	// merge from the back, with the right run in the scratch buffer
+	void MergeHigh(const int32 First, const int32 Middle, const int32 Last) {
+		const auto NumRight = Last - Middle;
+		Copy(Scratch, At(Middle), NumRight);
+
+		auto Left  = Middle - 1;
+		auto Right = NumRight - 1;
+		auto Dest  = Last - 1;
+		while (Left >= First && Right >= 0) {
+			auto* const RightPtr =
+			    Scratch + static_cast<SIZE_T>(Right) * ElementSize;
+			if (Less(RightPtr, At(Left))) {
+				Copy(At(Dest--), At(Left--), 1);
+			} else {
+				Copy(At(Dest--), RightPtr, 1);
+				--Right;
+			}
+		}
+
+		// the rest of the left run is already in place
+		Copy(At(First), Scratch, Right + 1);
+	}
+
+private:
+	uint8* const                                       Data;
+	const int32                                        Num;
+	const int32                                        ElementSize;
+	const TFunctionRef<bool(const void*, const void*)> Less;
+	uint8* const                                       Scratch;
+};
+} // namespace
+
+void ApplyPermutation(FScriptArrayHelper&          ArrayHelper,
+                      const int32                  ElementSize,
+                      const TConstArrayView<int32> Order) {
+	check(Order.Num() == ArrayHelper.Num());
+
+	// buffer to hold the first element of a cycle
+	TArray<uint8, TInlineAllocator<256>> Temp;
+	Temp.SetNumUninitialized(ElementSize);
+
+	// indices already in place
+	TBitArray<> Placed(false, Order.Num());
+
+	for (auto Start = 0; Start < Order.Num(); ++Start) {
+		// if the element is already in place
+		if (Placed[Start] || Order[Start] == Start) {
+			continue;
+		}
+
+		// take the first element of the cycle out
+		FMemory::Memcpy(Temp.GetData(), ArrayHelper.GetRawPtr(Start),
+		                ElementSize);
+
+		// move each element of the cycle to its destination
+		auto Current = Start;
+		while (Order[Current] != Start) {
+			const auto Next = Order[Current];
+			FMemory::Memcpy(ArrayHelper.GetRawPtr(Current),
+			                ArrayHelper.GetRawPtr(Next), ElementSize);
+			Placed[Current] = true;
+			Current         = Next;
+		}
+
+		// put the first element at the end of the cycle
+		FMemory::Memcpy(ArrayHelper.GetRawPtr(Current), Temp.GetData(),
+		                ElementSize);
+		Placed[Current] = true;
+	}
+}
+
+void RadixSort(TArray<FSortKeyIndex>& Keys, const int32 KeyBytes) {
+	check(1 <= KeyBytes && KeyBytes <= 8);
+
+	const auto NumKeys = Keys.Num();
+
+	// if there are few keys
+	if (NumKeys < MinNumToRadixSort) {
+		// sort by comparison
+		std::sort(Keys.GetData(), Keys.GetData() + NumKeys);
+
+		// finish
+		return;
+	}
+
+	// count the occurrences of each byte value at each byte position
+	TArray<int32> Counts;
+	Counts.SetNumZeroed(KeyBytes * 256);
+	for (const auto& Key : Keys) {
+		for (auto Byte = 0; Byte < KeyBytes; ++Byte) {
+			++Counts[Byte * 256 + ((Key.Key >> (Byte * 8)) & 0xFF)];
+		}
+	}
+
+	// get the scratch buffer
+	auto& Scratch = GetRadixSortScratch();
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	Scratch.SetNumUninitialized(NumKeys, false);
+#else
+	Scratch.SetNumUninitialized(NumKeys, EAllowShrinking::No);
+#endif
+
+	auto* Source      = &Keys;
+	auto* Destination = &Scratch;
+
+	for (auto Byte = 0; Byte < KeyBytes; ++Byte) {
+		auto* const ByteCounts = Counts.GetData() + Byte * 256;
+
+		// if all keys have the same value at this byte
+		const auto FirstValue = (Keys[0].Key >> (Byte * 8)) & 0xFF;
+		if (ByteCounts[FirstValue] == NumKeys) {
+			// skip this pass
+			continue;
+		}
+
+		// convert the counts to the first positions of the values
+		auto Position = 0;
+		for (auto Value = 0; Value < 256; ++Value) {
+			const auto Count  = ByteCounts[Value];
+			ByteCounts[Value] = Position;
+			Position += Count;
+		}
+
+		// scatter the keys by the values of this byte (keeps the order of
+		// equal values)
+		auto* const SourceData      = Source->GetData();
+		auto* const DestinationData = Destination->GetData();
+		for (auto i = 0; i < NumKeys; ++i) {
+			const auto Value = (SourceData[i].Key >> (Byte * 8)) & 0xFF;
+			DestinationData[ByteCounts[Value]++] = SourceData[i];
+		}
+
+		Swap(Source, Destination);
+	}
+
+	// if the result is in the scratch buffer
+	if (Source != &Keys) {
+		// exchange the buffers, so that Keys holds the result and the old
+		// buffer of Keys is reused as the scratch buffer
+		Swap(Keys, Scratch);
+	}
+
+	// if the scratch buffer is too large to keep
+	if (Scratch.GetAllocatedSize() > MaxRetainedScratchBytes) {
+		// free it
+		Scratch.Empty();
+	}
+}
+
+void ParallelSortIndices(
+    FScriptArrayHelper&                                ArrayHelper,
+    const TFunctionRef<bool(const void*, const void*)> Less,
+    const int32 NumWorkers, TArray<int32>& OutOrder) {
+	const auto Num = ArrayHelper.Num();
+
+	// initialize the indices
+	OutOrder.SetNumUninitialized(Num);
+	for (auto i = 0; i < Num; ++i) {
+		OutOrder[i] = i;
+	}
+
+	// compare the elements at the indices
+	const auto compare_indices = [&](const int32 A, const int32 B) {
+		return Less(ArrayHelper.GetRawPtr(A), ArrayHelper.GetRawPtr(B));
+	};
+
+	// split the indices into runs of almost the same length
+	const auto NumRuns = FMath::Clamp(NumWorkers, 1, FMath::Max(Num, 1));
+	TArray<int32> RunStarts;
+	RunStarts.SetNumUninitialized(NumRuns + 1);
+	for (auto i = 0; i <= NumRuns; ++i) {
+		RunStarts[i] = static_cast<int32>(static_cast<int64>(Num) * i / NumRuns);
+	}
+
+	// sort each run
+	ParallelFor(NumRuns, [&](const int32 RunIndex) {
+		std::stable_sort(OutOrder.GetData() + RunStarts[RunIndex],
+		                 OutOrder.GetData() + RunStarts[RunIndex + 1],
+		                 compare_indices);
+	});
+
+	// merge adjacent runs in pairs until one run is left. std::merge takes
+	// equivalent elements from the left run first, so the order is stable.
+	TArray<int32> Buffer;
+	Buffer.SetNumUninitialized(Num);
+	auto* Source = OutOrder.GetData();
+	auto* Dest   = Buffer.GetData();
+	for (auto Width = 1; Width < NumRuns; Width *= 2) {
+		const auto NumMerges = FMath::DivideAndRoundUp(NumRuns, Width * 2);
+		ParallelFor(NumMerges, [&](const int32 MergeIndex) {
+			const auto First = RunStarts[MergeIndex * Width * 2];
+			const auto Mid   = RunStarts[FMath::Min(MergeIndex * Width * 2 + Width,
+			                                        NumRuns)];
+			const auto Last =
+			    RunStarts[FMath::Min(MergeIndex * Width * 2 + Width * 2, NumRuns)];
+			std::merge(Source + First, Source + Mid, Source + Mid, Source + Last,
+			           Dest + First, compare_indices);
+		});
+		Swap(Source, Dest);
+	}
+
+	// if the result is in the buffer
+	if (Source != OutOrder.GetData()) {
+		OutOrder = MoveTemp(Buffer);
+	}
+}
+
+bool SortIndicesByProperty(FScriptArrayHelper& ArrayHelper,
+                           const FProperty&    ElementProperty,
+                           const FString& PropertyPath, const bool bDescending,
+                           TArray<int32>&          OutOrder,
+                           const EUdonNaturalOrder Order) {
+	// resolve the key of the elements
+	const auto Accessor =
+	    FSortKeyAccessor::Resolve(ElementProperty, PropertyPath, Order);
+
+	// if the key can't be used for sorting
+	if (!Accessor) {
+		// finish
+		return false;
+	}
+
+	const auto NumArray = ArrayHelper.Num();
+	OutOrder.Reset(NumArray);
+
+	// if the keys can be converted to unsigned integers
+	if (Accessor->IsOrdered()) {
+		// extract the keys to a contiguous buffer
+		TArray<FSortKeyIndex> Keys;
+		Keys.SetNumUninitialized(NumArray);
+		for (auto i = 0; i < NumArray; ++i) {
+			const auto Key = Accessor->GetOrderedKey(ArrayHelper.GetRawPtr(i));
+			Keys[i]        = FSortKeyIndex{bDescending ? ~Key : Key, i};
+		}
+
+		// sort the keys (indices break ties, so this is stable)
+		RadixSort(Keys, Accessor->GetOrderedKeyBytes());
+
+		for (const auto& Key : Keys) {
+			OutOrder.Add(Key.Index);
+		}
+	}
+	// otherwise, compare the keys in place
+	else {
+		for (auto i = 0; i < NumArray; ++i) {
+			OutOrder.Add(i);
+		}
+
+		std::stable_sort(OutOrder.GetData(), OutOrder.GetData() + NumArray,
+		                 [&](const int32 A, const int32 B) {
+			                 const auto* const ElementA = ArrayHelper.GetRawPtr(A);
+			                 const auto* const ElementB = ArrayHelper.GetRawPtr(B);
+			                 return bDescending ? Accessor->Less(ElementB, ElementA)
+			                                    : Accessor->Less(ElementA, ElementB);
+		                 });
+	}
+
+	return true;
+}
+
+bool FindMinMaxIndicesByValue(FScriptArrayHelper&     ArrayHelper,
+                              const FProperty&        ElementProperty,
+                              const EUdonNaturalOrder Order,
+                              int32&                  OutMinIndex,
+                              int32&                  OutMaxIndex) {
+	// if the type of the elements has a specialized loop
+	if (MinMaxIndicesTyped(ArrayHelper, ElementProperty, OutMinIndex,
+	                       OutMaxIndex)) {
+		return true;
+	}
+
+	// resolve the values of the elements as the key
+	const auto Accessor = FSortKeyAccessor::Resolve(ElementProperty, {}, Order);
+
+	// if the elements can't be compared by their values
+	if (!Accessor) {
+		// finish
+		return false;
+	}
+
+	const auto NumArray = ArrayHelper.Num();
+	OutMinIndex = OutMaxIndex = NumArray > 0 ? 0 : INDEX_NONE;
+
+	// if the keys can be converted to unsigned integers
+	if (Accessor->IsOrdered()) {
+		// compare the converted keys
+		auto MinKey = NumArray > 0
+		                  ? Accessor->GetOrderedKey(ArrayHelper.GetRawPtr(0))
+		                  : uint64{0};
+		auto MaxKey = MinKey;
+		for (auto i = 1; i < NumArray; ++i) {
+			const auto Key = Accessor->GetOrderedKey(ArrayHelper.GetRawPtr(i));
+			if (Key < MinKey) {
+				MinKey      = Key;
+				OutMinIndex = i;
+			}
+			if (MaxKey < Key) {
+				MaxKey      = Key;
+				OutMaxIndex = i;
+			}
+		}
+	}
+	// otherwise, compare the keys in place
+	else {
+		for (auto i = 1; i < NumArray; ++i) {
+			const auto* const Element = ArrayHelper.GetRawPtr(i);
+			if (Accessor->Less(Element, ArrayHelper.GetRawPtr(OutMinIndex))) {
+				OutMinIndex = i;
+			}
+			if (Accessor->Less(ArrayHelper.GetRawPtr(OutMaxIndex), Element)) {
+				OutMaxIndex = i;
+			}
+		}
+	}
+
+	return true;
+}
+
+void StableSort(FScriptArrayHelper& ArrayHelper, const int32 ElementSize,
+                const TFunctionRef<bool(const void*, const void*)> Less,
+                const bool                     bAdaptive,
+                const std::atomic<bool>* const bCancelled) {
+	const auto Num = ArrayHelper.Num();
+
+	// if there is nothing to sort
+	if (Num < 2) {
+		// finish
+		return;
+	}
+
+	// take the scratch buffer of this thread (at least one element for
+	// insertion). It is moved out rather than referenced, so that a sort
+	// started by Less on the same thread, such as a Blueprint comparison
+	// function sorting another array, uses a buffer of its own instead of
+	// reallocating this one.
+	auto Scratch = MoveTemp(GetStableSortScratch());
+	const auto ScratchSize =
+	    static_cast<int64>(FMath::Max(Num / 2, 1)) * ElementSize;
+	if (Scratch.Num() < ScratchSize) {
+		Scratch.SetNumUninitialized(ScratchSize);
+	}
+
+	FRawMergeSorter(ArrayHelper.GetRawPtr(0), Num, ElementSize, Less,
+	                Scratch.GetData())
+	    .Sort(bAdaptive, bCancelled);
+
+	// give the buffer back for the next sort, unless a nested sort left a
+	// larger one or it is too large to keep
+	auto& CachedScratch = GetStableSortScratch();
+	if (CachedScratch.Max() < Scratch.Max() &&
+	    Scratch.GetAllocatedSize() <= MaxRetainedScratchBytes) {
+		CachedScratch = MoveTemp(Scratch);
+	}
+}
+} // namespace udon
@@ -0,0 +1,107 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SortKey.h"
+#include "UObject/UnrealType.h"
+
+#include <atomic>
+
+namespace udon {
+/**
+ * Rearranges the elements of an array so that the element at Order[i] moves
+ * to index i. Each element is moved bitwise at most once, by following the
+ * cycles of the permutation.
+ * @param ArrayHelper  helper of the array to rearrange
+ * @param ElementSize  size of one element
+ * @param Order  a permutation of the indices of the array
+ */
+void ApplyPermutation(FScriptArrayHelper& ArrayHelper, int32 ElementSize,
+                      TConstArrayView<int32> Order);
+
+/**
+ * Sorts pairs of keys and indices by (Key, Index) with an LSD radix sort.
+ * Keys must be in index order before sorting, and only the low KeyBytes
+ * bytes of the keys are compared (the other bytes must be equal in all
+ * keys). Passes over bytes that are the same in all keys are skipped. The
+ * scratch buffer is kept per thread and reused across calls.
+ * @param Keys  pairs to sort
+ * @param KeyBytes  number of low bytes of the keys to compare (1 to 8)
+ */
+void RadixSort(TArray<FSortKeyIndex>& Keys, int32 KeyBytes);
+
+/**
+ * Finds the minimum and maximum elements of an array by their values, without
+ * calling any comparison function. Arrays of int32, int64, float and double
+ * are searched with SIMD instructions (see MinMaxIndicesTyped), and
+ * other types are compared like the keys of FSortKeyAccessor. If several
+ * elements are equal, the first one is found.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param Order  how strings and names are compared
+ * @param[out] OutMinIndex  the index of the minimum (INDEX_NONE if empty)
+ * @param[out] OutMaxIndex  the index of the maximum (INDEX_NONE if empty)
+ * @return
+ *    false if the elements can't be compared by their values (an error is
+ *    logged).
+ */
+bool FindMinMaxIndicesByValue(FScriptArrayHelper& ArrayHelper,
+                              const FProperty&    ElementProperty,
+                              EUdonNaturalOrder Order, int32& OutMinIndex,
+                              int32& OutMaxIndex);
+
+/**
+ * Computes the order of the elements of an array with a parallel merge sort.
+ * The indices are split into NumWorkers runs that are sorted on worker
+ * threads, and then merged in pairs, each round of merges in parallel. The
+ * order is stable, so the result doesn't depend on NumWorkers or on the
+ * scheduling of the threads.
+ * @param ArrayHelper  helper of the array
+ * @param Less
+ *    returns whether the first element should precede the second. Called
+ *    from several threads at once.
+ * @param NumWorkers  number of runs sorted in parallel
+ * @param[out] OutOrder  The indices of the elements in sorted order.
+ */
+void ParallelSortIndices(FScriptArrayHelper& ArrayHelper,
+                         TFunctionRef<bool(const void*, const void*)> Less,
+                         int32 NumWorkers, TArray<int32>& OutOrder);
+
+/**
+ * Computes the order of the elements of an array sorted by a property of the
+ * elements. The order is stable.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param PropertyPath  path of the key property (see FSortKeyAccessor)
+ * @param bDescending  If true, the order is descending.
+ * @param[out] OutOrder
+ *    The indices of the elements in sorted order. Not modified on failure.
+ * @param Order  how string and name keys are compared
+ * @return  false if the key can't be resolved (an error is logged).
+ */
+bool SortIndicesByProperty(
+    FScriptArrayHelper& ArrayHelper, const FProperty& ElementProperty,
+    const FString& PropertyPath, bool bDescending, TArray<int32>& OutOrder,
+    EUdonNaturalOrder Order = EUdonNaturalOrder::CaseInsensitive);
+
+/**
+ * Sorts the elements of an array stably with a merge sort that moves raw
+ * element bytes. The scratch buffer holds at most half of the elements, and
+ * is kept per thread and reused across calls.
+ * @param ArrayHelper  helper of the array to sort
+ * @param ElementSize  size of one element
+ * @param Less  returns whether the first element should precede the second
+ * @param bAdaptive
+ *    If true, already sorted (or strictly descending) runs in the array are
+ *    detected and merged, so nearly sorted arrays take close to linear time.
+ *    If false, the array is split into runs of a fixed length.
+ * @param bCancelled
+ *    If given, checked between merge passes. Once it is set, the sort stops
+ *    and leaves the elements partially sorted.
+ */
+void StableSort(FScriptArrayHelper& ArrayHelper, int32 ElementSize,
+                TFunctionRef<bool(const void*, const void*)> Less,
+                bool                     bAdaptive,
+                const std::atomic<bool>* bCancelled = nullptr);
+} // namespace udon
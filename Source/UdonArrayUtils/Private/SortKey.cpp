@@ -0,0 +1,247 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "SortKey.h"
+
+#include "LogUdonArrayUtilsLibrary.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace udon {
+namespace {
+inline int32 GetElementSize(const FProperty& Property) {
+	return
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    Property.ElementSize
+#else
+	    Property.GetElementSize()
+#endif
+	    ;
+}
+
+// read an unsigned integer of Size bytes
+uint64 ReadUnsigned(const void* const Ptr, const int32 Size) {
+	switch (Size) {
+	case 1:
+		return *static_cast<const uint8*>(Ptr);
+	case 2:
+		return *static_cast<const uint16*>(Ptr);
+	case 4:
+		return *static_cast<const uint32*>(Ptr);
+	default:
+		return *static_cast<const uint64*>(Ptr);
+	}
+}
+
+// find a property named Name in Struct
+const FProperty* FindPropertyByName(const UStruct& Struct,
+                                   const FString& Name) {
+	for (TFieldIterator<FProperty> It(&Struct); It; ++It) {
+		// names of Blueprint struct members have suffixes, so the authored
+		// name is also compared
+		if (It->GetAuthoredName() == Name || It->GetName() == Name) {
+			return *It;
+		}
+	}
+
+	return nullptr;
+}
+
+// whether Property is a signed integer property
+bool IsSignedIntegerProperty(const FProperty& Property) {
+	return Property.IsA<FInt8Property>() || Property.IsA<FInt16Property>() ||
+	       Property.IsA<FIntProperty>() || Property.IsA<FInt64Property>();
+}
+} // namespace
+
+TOptional<FSortKeyAccessor>
+    FSortKeyAccessor::Resolve(const FProperty&        ElementProperty,
+                              const FString&          PropertyPath,
+                              const EUdonNaturalOrder Order) {
+	FSortKeyAccessor Accessor;
+	Accessor.KeyProperty = &ElementProperty;
+	Accessor.Order       = Order;
+
+	// split the path into names
+	TArray<FString> Names;
+	PropertyPath.ParseIntoArray(Names, TEXT("."));
+
+	// follow the path
+	for (const auto& Name : Names) {
+		// if the current property is not a struct
+		const auto* const StructProperty =
+		    CastField<FStructProperty>(Accessor.KeyProperty);
+		if (!StructProperty) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Can't resolve '%s' in property path '%s': '%s' is not "
+			            "a struct."),
+			       *Name, *PropertyPath, *Accessor.KeyProperty->GetName());
+
+			// finish
+			return {};
+		}
+
+		// find the member
+		const auto* const Member =
+		    FindPropertyByName(*StructProperty->Struct, Name);
+
+		// if not found
+		if (!Member) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Property '%s' in property path '%s' not found in "
+			            "struct: %s"),
+			       *Name, *PropertyPath, *StructProperty->Struct->GetName());
+
+			// finish
+			return {};
+		}
+
+		Accessor.Offset += Member->GetOffset_ForInternal();
+		Accessor.KeyProperty = Member;
+	}
+
+	const auto& KeyProperty = *Accessor.KeyProperty;
+
+	// get the numeric property of the key (enums by their underlying type)
+	const auto* NumericProperty = CastField<FNumericProperty>(&KeyProperty);
+	if (const auto* const EnumProperty = CastField<FEnumProperty>(&KeyProperty)) {
+		NumericProperty = EnumProperty->GetUnderlyingProperty();
+	}
+
+	// determine the kind of the key
+	if (NumericProperty && NumericProperty->IsA<FFloatProperty>()) {
+		Accessor.Kind = EKind::Float;
+	} else if (NumericProperty && NumericProperty->IsA<FDoubleProperty>()) {
+		Accessor.Kind = EKind::Double;
+	} else if (NumericProperty && NumericProperty->IsInteger()) {
+		Accessor.Kind = IsSignedIntegerProperty(*NumericProperty)
+		                    ? EKind::Signed
+		                    : EKind::Unsigned;
+	} else if (KeyProperty.IsA<FBoolProperty>()) {
+		Accessor.Kind = EKind::Bool;
+	} else if (KeyProperty.IsA<FStrProperty>()) {
+		Accessor.Kind = EKind::String;
+	} else if (KeyProperty.IsA<FNameProperty>()) {
+		Accessor.Kind = EKind::Name;
+	} else if (KeyProperty.IsA<FTextProperty>()) {
+		Accessor.Kind = EKind::Text;
+	} else {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Can't sort by '%s' of type %s. The key must be a number, "
+		            "bool, enum, String, Name or Text."),
+		       *KeyProperty.GetName(), *KeyProperty.GetCPPType());
+
+		// finish
+		return {};
+	}
+
+	Accessor.KeySize = GetElementSize(NumericProperty ? *NumericProperty
+	                                                   : KeyProperty);
+
+	return Accessor;
+}
+
+uint64 FSortKeyAccessor::GetOrderedKey(const void* const Element) const {
+	const auto* const KeyPtr = GetKeyPtr(Element);
+
+	switch (Kind) {
+	case EKind::Signed: {
+		// move the range of signed values to that of unsigned values
+		const auto SignBit = uint64{1} << (KeySize * 8 - 1);
+		return ReadUnsigned(KeyPtr, KeySize) ^ SignBit;
+	}
+	case EKind::Unsigned:
+		return ReadUnsigned(KeyPtr, KeySize);
+	case EKind::Float: {
+		const auto Value = *static_cast<const float*>(KeyPtr);
+		if (FMath::IsNaN(Value)) {
+			return MAX_uint32;
+		}
+
+		// flip all bits of negative values, and the sign bit of the others
+		const auto Bits = *static_cast<const uint32*>(KeyPtr);
+		return Bits & 0x80000000u ? ~Bits : Bits | 0x80000000u;
+	}
+	case EKind::Double: {
+		const auto Value = *static_cast<const double*>(KeyPtr);
+		if (FMath::IsNaN(Value)) {
+			return MAX_uint64;
+		}
+
+		// flip all bits of negative values, and the sign bit of the others
+		const auto Bits    = *static_cast<const uint64*>(KeyPtr);
+		const auto SignBit = uint64{1} << 63;
+		return Bits & SignBit ? ~Bits : Bits | SignBit;
+	}
+	case EKind::Bool:
+		return static_cast<const FBoolProperty*>(KeyProperty)->GetPropertyValue(
+		           KeyPtr)
+		           ? 1
+		           : 0;
+	default:
+		checkNoEntry();
+		return 0;
+	}
+}
+
+double FSortKeyAccessor::GetNumber(const void* const Element) const {
+	const auto* const KeyPtr = GetKeyPtr(Element);
+
+	switch (Kind) {
+	case EKind::Signed: {
+		// extend the sign of the value to 64 bits
+		const auto Shift = 64 - KeySize * 8;
+		return static_cast<double>(
+		    static_cast<int64>(ReadUnsigned(KeyPtr, KeySize) << Shift) >> Shift);
+	}
+	case EKind::Unsigned:
+		return static_cast<double>(ReadUnsigned(KeyPtr, KeySize));
+	case EKind::Float:
+		return *static_cast<const float*>(KeyPtr);
+	case EKind::Double:
+		return *static_cast<const double*>(KeyPtr);
+	default:
+		checkNoEntry();
+		return 0.0;
+	}
+}
+
+int32 FSortKeyAccessor::GetOrderedKeyBytes() const noexcept {
+	return Kind == EKind::Bool ? 1 : KeySize;
+}
+
+bool FSortKeyAccessor::Less(const void* const A, const void* const B) const {
+	const auto* const KeyA = GetKeyPtr(A);
+	const auto* const KeyB = GetKeyPtr(B);
+
+	switch (Kind) {
+	case EKind::String: {
+		const auto& StringA = *static_cast<const FString*>(KeyA);
+		const auto& StringB = *static_cast<const FString*>(KeyB);
+		return Order == EUdonNaturalOrder::CaseSensitive
+		           ? StringA.Compare(StringB, ESearchCase::CaseSensitive) < 0
+		           : StringA < StringB;
+	}
+	case EKind::Name: {
+		const auto& NameA = *static_cast<const FName*>(KeyA);
+		const auto& NameB = *static_cast<const FName*>(KeyB);
+		switch (Order) {
+		case EUdonNaturalOrder::CaseSensitive:
+			// FName comparison ignores case, so compare the strings
+			return FCString::Strcmp(*FNameBuilder(NameA), *FNameBuilder(NameB)) <
+			       0;
+		case EUdonNaturalOrder::NameIndex:
+			return NameA.CompareIndexes(NameB) < 0;
+		default:
+			return NameA.Compare(NameB) < 0;
+		}
+	}
+	case EKind::Text:
+		return static_cast<const FText*>(KeyA)->CompareTo(
+		           *static_cast<const FText*>(KeyB)) < 0;
+	default:
+		return GetOrderedKey(A) < GetOrderedKey(B);
+	}
+}
+} // namespace udon
@@ -0,0 +1,131 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UdonNaturalOrder.h"
+
+namespace udon {
+/**
+ * A pair of a sort key and the index of the element it was extracted from.
+ * Sorting pairs by (Key, Index) is stable.
+ */
+struct FSortKeyIndex {
+	uint64 Key;
+	int32  Index;
+
+	[[nodiscard]] bool operator<(const FSortKeyIndex& Other) const noexcept {
+		return Key < Other.Key || (Key == Other.Key && Index < Other.Index);
+	}
+};
+
+/**
+ * Reads a sort key from elements of an array. The key is a property of the
+ * element, or of a struct nested in the element, resolved once by its path.
+ */
+class FSortKeyAccessor {
+public:
+	/**
+	 * Resolves PropertyPath on the elements.
+	 * @param ElementProperty  property of the elements
+	 * @param PropertyPath
+	 *    Names of properties separated by '.', such as "Stats.Score". Each
+	 *    name but the last must be a struct property. If empty, the element
+	 *    itself is the key.
+	 * @param Order  how string and name keys are compared
+	 * @return
+	 *    The accessor. If the path can't be resolved or the key type can't be
+	 *    sorted, an error is logged and an unset value is returned.
+	 */
+	static TOptional<FSortKeyAccessor>
+	    Resolve(const FProperty& ElementProperty, const FString& PropertyPath,
+	            EUdonNaturalOrder Order = EUdonNaturalOrder::CaseInsensitive);
+
+public:
+	/**
+	 * Whether the key can be converted to an unsigned integer that keeps the
+	 * order (integers, floating points, bools and enums).
+	 */
+	[[nodiscard]] bool IsOrdered() const noexcept {
+		return Kind != EKind::String && Kind != EKind::Name &&
+		       Kind != EKind::Text;
+	}
+
+	/**
+	 * Whether the key is a number (an integer, a floating point or an enum).
+	 */
+	[[nodiscard]] bool IsNumeric() const noexcept {
+		return Kind == EKind::Signed || Kind == EKind::Unsigned ||
+		       Kind == EKind::Float || Kind == EKind::Double;
+	}
+
+	/**
+	 * Whether keys can be compared on a background thread. Texts are compared
+	 * by the current culture, which may be changed on the game thread.
+	 */
+	[[nodiscard]] bool IsThreadSafe() const noexcept {
+		return Kind != EKind::Text;
+	}
+
+	/**
+	 * Returns the key of Element as a double. Valid only if IsNumeric() is
+	 * true.
+	 */
+	[[nodiscard]] double GetNumber(const void* Element) const;
+
+	/**
+	 * Returns the key of Element converted to an unsigned integer. Comparing
+	 * the results gives the order of the keys. NaNs are ordered after any
+	 * other value. Valid only if IsOrdered() is true.
+	 */
+	[[nodiscard]] uint64 GetOrderedKey(const void* Element) const;
+
+	/**
+	 * Returns the number of low bytes of GetOrderedKey() results that can be
+	 * non-zero.
+	 */
+	[[nodiscard]] int32 GetOrderedKeyBytes() const noexcept;
+
+	/**
+	 * Compares the keys of A and B. Strings and names are compared as specified
+	 * by the order given to Resolve(), and texts are compared by the current
+	 * culture.
+	 * @return  whether the key of A is less than that of B.
+	 */
+	[[nodiscard]] bool Less(const void* A, const void* B) const;
+
+private:
+	enum class EKind : uint8 {
+		Signed,
+		Unsigned,
+		Float,
+		Double,
+		Bool,
+		String,
+		Name,
+		Text
+	};
+
+	// get pointer to the key in Element
+	[[nodiscard]] const void* GetKeyPtr(const void* Element) const noexcept {
+		return static_cast<const uint8*>(Element) + Offset;
+	}
+
+private:
+	// property of the key
+	const FProperty* KeyProperty = nullptr;
+
+	// offset of the key from the beginning of the element
+	int32 Offset = 0;
+
+	// size of the key
+	int32 KeySize = 0;
+
+	// kind of the key
+	EKind Kind = EKind::Unsigned;
+
+	// how string and name keys are compared
+	EUdonNaturalOrder Order = EUdonNaturalOrder::CaseInsensitive;
+};
+} // namespace udon
@@ -0,0 +1,97 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonAliasTable.h"
+
+namespace udon {
+void FAliasTable::Build(const TArrayView<const double> Weights) {
+	Probabilities.Reset();
+	Aliases.Reset();
+
+	// get the total of the positive weights
+	double Total = 0.0;
+	for (const auto Weight : Weights) {
+		Total += Weight > 0.0 ? Weight : 0.0;
+	}
+
+	// if nothing can be drawn
+	const auto Num = Weights.Num();
+	if (Num == 0 || !(Total > 0.0) || !FMath::IsFinite(Total)) {
+		// finish
+		return;
+	}
+
+	// scale the weights so that their average is 1, and stack the indices
+	// under and over the average
+	Probabilities.SetNumUninitialized(Num);
+	Aliases.SetNumUninitialized(Num);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.SetNumUninitialized(Num);
+	Large.SetNumUninitialized(Num);
+	auto NumSmall = 0;
+	auto NumLarge = 0;
+	for (auto i = 0; i < Num; ++i) {
+		const auto Weight = Weights[i] > 0.0 ? Weights[i] : 0.0;
+		Probabilities[i]  = Weight * Num / Total;
+		Aliases[i]        = i;
+		if (Probabilities[i] < 1.0) {
+			Small[NumSmall++] = i;
+		} else {
+			Large[NumLarge++] = i;
+		}
+	}
+
+	// fill each column under the average with the excess of one over it
+	while (NumSmall > 0 && NumLarge > 0) {
+		const auto Less = Small[--NumSmall];
+		const auto More = Large[--NumLarge];
+
+		Aliases[Less] = More;
+		Probabilities[More] -= 1.0 - Probabilities[Less];
+		if (Probabilities[More] < 1.0) {
+			Small[NumSmall++] = More;
+		} else {
+			Large[NumLarge++] = More;
+		}
+	}
+
+	// the rest are full up to rounding errors
+	for (auto i = 0; i < NumLarge; ++i) {
+		Probabilities[Large[i]] = 1.0;
+	}
+	for (auto i = 0; i < NumSmall; ++i) {
+		Probabilities[Small[i]] = 1.0;
+	}
+}
+} // namespace udon
+
+UUdonAliasTable*
+    UUdonAliasTable::CreateAliasTable(const TArray<double>& Weights) {
+	auto* const AliasTable = NewObject<UUdonAliasTable>();
+	AliasTable->UpdateWeights(Weights);
+	return AliasTable;
+}
+
+bool UUdonAliasTable::Update(const TArray<double>& InWeights) {
+	return UpdateWeights(InWeights);
+}
+
+bool UUdonAliasTable::UpdateWeights(const TArrayView<const double> InWeights) {
+	// if the weights are unchanged
+	if (Weights.Num() == InWeights.Num() &&
+	    FMemory::Memcmp(Weights.GetData(), InWeights.GetData(),
+	                    Weights.Num() * sizeof(double)) == 0) {
+		// finish
+		return false;
+	}
+
+	Weights = InWeights;
+	Table.Build(Weights);
+
+	return true;
+}
+
+int32 UUdonAliasTable::Draw(UUdonRandomStream* const RandomStream) {
+	return Table.Draw(RandomStream ? RandomStream->GetEngine()
+	                               : udon::FRandomEngine::GetThreadDefault());
+}
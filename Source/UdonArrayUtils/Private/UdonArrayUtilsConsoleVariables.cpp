@@ -0,0 +1,36 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonArrayUtilsConsoleVariables.h"
+
+namespace udon {
+TAutoConsoleVariable<int32> CVarIndexSortElementSizeThreshold(
+    TEXT("udon.ArrayUtils.IndexSortElementSizeThreshold"), 128,
+    TEXT("Arrays whose elements are at least this many bytes are sorted by "
+         "sorting their indices and then moving each element once, instead "
+         "of swapping the elements while sorting. 0 disables this."),
+    ECVF_Default);
+
+TAutoConsoleVariable<int32> CVarParallelPredicateMinNum(
+    TEXT("udon.ArrayUtils.ParallelPredicateMinNum"), 4096,
+    TEXT("Arrays with at least this many elements are evaluated in parallel "
+         "by CountIf, AllSatisfy, AnySatisfy, NoneSatisfy, FindIf and "
+         "RemoveIf, when the predicate is a native predicate registered as "
+         "thread-safe. 0 disables parallel evaluation."),
+    ECVF_Default);
+
+TAutoConsoleVariable<int32> CVarParallelSortMinNum(
+    TEXT("udon.ArrayUtils.ParallelSortMinNum"), 65536,
+    TEXT("Arrays with at least this many elements are sorted with a parallel "
+         "merge sort by SortAnyArray, StableSortAnyArray and "
+         "GetSortedIndices, when the comparison function is a native "
+         "predicate registered as thread-safe. 0 disables parallel "
+         "sorting."),
+    ECVF_Default);
+
+TAutoConsoleVariable<int32> CVarParallelSortMaxWorkers(
+    TEXT("udon.ArrayUtils.ParallelSortMaxWorkers"), 0,
+    TEXT("Maximum number of runs sorted in parallel by the parallel merge "
+         "sort. 0 uses the number of worker threads plus the calling "
+         "thread."),
+    ECVF_Default);
+} // namespace udon
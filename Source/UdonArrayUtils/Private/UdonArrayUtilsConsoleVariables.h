@@ -0,0 +1,22 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+namespace udon {
+// elements of at least this size are sorted through an array of indices
+extern TAutoConsoleVariable<int32> CVarIndexSortElementSizeThreshold;
+
+// arrays of at least this many elements are evaluated with thread-safe
+// native predicates in parallel
+extern TAutoConsoleVariable<int32> CVarParallelPredicateMinNum;
+
+// arrays of at least this many elements are sorted in parallel with
+// thread-safe native comparison functions
+extern TAutoConsoleVariable<int32> CVarParallelSortMinNum;
+
+// maximum number of runs sorted in parallel (0: number of worker threads)
+extern TAutoConsoleVariable<int32> CVarParallelSortMaxWorkers;
+} // namespace udon
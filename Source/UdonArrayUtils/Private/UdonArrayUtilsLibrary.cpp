@@ -2,12 +2,25 @@
 
 #include "UdonArrayUtilsLibrary.h"
 
+#include "ArrayKernels.h"
+#include "AsyncArrayAction.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "IncrementalSortAction.h"
+#include "Misc/App.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeRWLock.h"
+#include "PredicateCallPlan.h"
+#include "SortAlgorithms.h"
+#include "UdonArrayUtilsConsoleVariables.h"
+#include "UdonArrayUtilsStats.h"
+#include "WeightedSampling.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
-#include <optional>
-#include <random>
 #include <stdexcept>
 
 namespace udon {
@@ -60,38 +73,124 @@ public:
 	}
 
 public:
-	const void* const target_ptr;
-	const FProperty&  property;
+	const void*      target_ptr;
+	const FProperty& property;
+};
+
+/**
+ * A per-thread pool of memory blocks for temporary copies of elements that
+ * don't fit in the inline buffer of memory_transparent_reference. Blocks are
+ * kept in free lists by power-of-two size class and reused, so sorting large
+ * elements doesn't hit the allocator once per temporary.
+ */
+class temporary_element_pool {
+public:
+	// allocate a block of at least size bytes
+	static void* allocate(const SIZE_T size) {
+		auto& free_list = get().free_lists[size_class_of(size)];
+
+		// reuse a free block if any
+		if (free_list.Num() > 0) {
+			return free_list.Pop();
+		}
+
+		// otherwise, allocate a new block
+		INC_DWORD_STAT(STAT_UdonArrayUtils_TemporaryElementHeapAllocations);
+		return FMemory::Malloc(SIZE_T{1} << size_class_of(size));
+	}
+
+	// return a block allocated with the same size to the pool
+	static void deallocate(void* const ptr, const SIZE_T size) {
+		get().free_lists[size_class_of(size)].Push(ptr);
+	}
+
+public:
+	// destructor
+	~temporary_element_pool() noexcept {
+		// free all pooled blocks
+		for (auto& free_list : free_lists) {
+			for (auto* const ptr : free_list) {
+				FMemory::Free(ptr);
+			}
+		}
+	}
+
+private:
+	// get the pool of this thread
+	static temporary_element_pool& get() {
+		thread_local temporary_element_pool pool;
+		return pool;
+	}
+
+	// get the exponent of the power of two block size for size bytes
+	static uint32 size_class_of(const SIZE_T size) {
+		return FMath::CeilLogTwo64(static_cast<uint64>(size));
+	}
+
+private:
+	TArray<void*> free_lists[64];
 };
 
 /**
  * A class that can be used to swap memory areas for the actual target.
  * Swapping an instance of this class with the Swap function will swap the
  * contents in the actual memory.
+ * A copy of an instance holds a copy of the value. Values of up to
+ * inline_buffer_size bytes are held inside the instance; larger values are
+ * held in a block of temporary_element_pool.
  */
 class memory_transparent_reference: public const_memory_transparent_reference {
+public:
+	// size of values that can be copied without allocating memory
+	static constexpr SIZE_T inline_buffer_size = 64;
+
 public:
 	// constructor
 	memory_transparent_reference(void*            InTargetPtr,
 	                             const FProperty& InElementProperty) noexcept
 	    : const_memory_transparent_reference(InTargetPtr, InElementProperty),
-	      new_target_ptr(nullptr) {}
+	      owned_heap_ptr(nullptr) {}
 
 	// copy constructor
 	memory_transparent_reference(const memory_transparent_reference& other)
-	    : const_memory_transparent_reference(
-	          new_target_ptr = ::operator new(other.property.GetSize()),
-	          other.property) {
+	    : const_memory_transparent_reference(nullptr, other.property),
+	      owned_heap_ptr(nullptr) {
 		// get memory size
 		const auto& mem_size = property.GetSize();
 
+		// get memory to hold the value
+		target_ptr = allocate_storage(mem_size);
+
 		// copy value
 		std::memcpy(const_cast<void*>(target_ptr), other.target_ptr, mem_size);
 	}
 
 	// move constructor
 	memory_transparent_reference(memory_transparent_reference&& other) noexcept
-	    : memory_transparent_reference(other) {}
+	    : const_memory_transparent_reference(nullptr, other.property),
+	      owned_heap_ptr(nullptr) {
+		// if other holds its value in a pooled block
+		if (other.owned_heap_ptr) {
+			// steal the block
+			target_ptr           = other.owned_heap_ptr;
+			owned_heap_ptr       = other.owned_heap_ptr;
+			other.owned_heap_ptr = nullptr;
+			other.target_ptr     = nullptr;
+		}
+		// otherwise, other holds its value inline or refers to an element, so
+		// copy the value (an element must not be taken away from its array)
+		else {
+			// get memory size
+			const auto& mem_size = property.GetSize();
+
+			// get memory to hold the value
+			target_ptr = allocate_storage(mem_size);
+
+			// copy value
+			std::memcpy(const_cast<void*>(target_ptr), other.target_ptr,
+			            mem_size);
+		}
+	}
 
 	// converting constructor from const_memory_transparent_reference
 	explicit memory_transparent_reference(
@@ -128,6 +227,12 @@ public:
 		// check size
 		check(other.property.GetSize() == mem_size);
 
+		// if the value of this instance was moved out
+		if (!target_ptr) {
+			// get memory to hold the value again
+			target_ptr = allocate_storage(mem_size);
+		}
+
 		// copy value
 		std::memcpy(const_cast<void*>(target_ptr), other.target_ptr, mem_size);
 
@@ -171,27 +276,69 @@ public:
 		                 const_cast<void*>(b.target_ptr), mem_size);
 	}
 
+	// swap for references returned by ScriptArrayHelperIterator, which are
+	// temporaries (std::iter_swap calls swap(*a, *b))
+	friend void swap(memory_transparent_reference&& a,
+	                 memory_transparent_reference&& b) {
+		swap(a, b);
+	}
+
+	friend void swap(memory_transparent_reference& a,
+	                 memory_transparent_reference&& b) {
+		swap(a, b);
+	}
+
+	friend void swap(memory_transparent_reference&& a,
+	                 memory_transparent_reference& b) {
+		swap(a, b);
+	}
+
 public:
 	// destructor
 	~memory_transparent_reference() noexcept {
-		// if this class allocates the memory of new_target_ptr
-		if (new_target_ptr) {
-			// delete newed memory
-			::operator delete(new_target_ptr);
+		// if this instance holds its value in a pooled block
+		if (owned_heap_ptr) {
+			// return the block to the pool
+			temporary_element_pool::deallocate(owned_heap_ptr,
+			                                   property.GetSize());
+		}
+	}
+
+private:
+	// get memory to hold a copy of mem_size bytes
+	void* allocate_storage(const SIZE_T mem_size) {
+		INC_DWORD_STAT(STAT_UdonArrayUtils_TemporaryElementCopies);
+
+		// if the value fits in the inline buffer
+		if (mem_size <= inline_buffer_size) {
+			return inline_buffer;
 		}
+
+		// otherwise, use a pooled block
+		owned_heap_ptr = temporary_element_pool::allocate(mem_size);
+		return owned_heap_ptr;
 	}
 
 private:
-	void* new_target_ptr;
+	// pooled block holding the value (nullptr if not owned)
+	void* owned_heap_ptr;
+
+	// buffer holding a small value
+	alignas(16) uint8 inline_buffer[inline_buffer_size];
 };
 
+/**
+ * Iterator over the elements of an array of any type. Dereferencing returns a
+ * const_memory_transparent_reference to the element by value, so that the
+ * iterator itself holds only the array, the property and the index.
+ */
 class ScriptArrayHelperConstIterator {
 public:
 	using iterator_category = std::random_access_iterator_tag;
 	using value_type        = const_memory_transparent_reference;
-	using reference         = const value_type&;
+	using reference         = value_type;
 	using difference_type   = int32;
-	using pointer           = const value_type*;
+	using pointer           = void;
 
 public:
 	// default constructor
@@ -215,47 +362,23 @@ public:
 	// copy assignment operator
 	ScriptArrayHelperConstIterator&
 	    operator=(const ScriptArrayHelperConstIterator& other) noexcept {
-		auto old_index = index;
-
 		ArrayHelper     = other.ArrayHelper;
 		ElementProperty = other.ElementProperty;
 		index           = other.index;
 
-		// if index changed
-		if (old_index != index) {
-			need_to_rebuild_ref = true;
-		}
-
 		return *this;
 	}
 
 public:
 	// dereference operator
 	[[nodiscard]] reference operator*() const noexcept {
-		// if need to rebuild ref
-		if (need_to_rebuild_ref) {
-			// rebuild ref
-			const_cast<ScriptArrayHelperConstIterator*>(this)->ref.emplace(
-			    ArrayHelper->GetRawPtr(index), *ElementProperty);
-		}
-
-		// turn off need_to_rebuild_ref flag
-		const_cast<ScriptArrayHelperConstIterator*>(this)->need_to_rebuild_ref =
-		    false;
-
-		// return const_memory_transparent_reference
-		return ref.value();
-	}
-
-	// arrow operator
-	[[nodiscard]] pointer operator->() const noexcept {
-		return &**this;
+		return const_memory_transparent_reference(ArrayHelper->GetRawPtr(index),
+		                                          *ElementProperty);
 	}
 
 	// prefix increment operator
 	ScriptArrayHelperConstIterator& operator++() noexcept {
 		++index;
-		need_to_rebuild_ref = true;
 		return *this;
 	}
 
@@ -269,7 +392,6 @@ public:
 	// prefix decrement operator
 	ScriptArrayHelperConstIterator& operator--() noexcept {
 		--index;
-		need_to_rebuild_ref = true;
 		return *this;
 	}
 
@@ -284,7 +406,6 @@ public:
 	ScriptArrayHelperConstIterator&
 	    operator+=(const difference_type offset) noexcept {
 		index += offset;
-		need_to_rebuild_ref = true;
 		return *this;
 	}
 
@@ -364,19 +485,23 @@ public:
 	}
 
 protected:
-	FScriptArrayHelper*                         ArrayHelper;
-	const FProperty*                            ElementProperty;
-	int32                                       index;
-	std::optional<memory_transparent_reference> ref;
-	bool                                        need_to_rebuild_ref = true;
+	FScriptArrayHelper* ArrayHelper;
+	const FProperty*    ElementProperty;
+	int32               index;
 };
+/**
+ * Iterator over the elements of an array of any type that can modify them.
+ * Dereferencing returns a memory_transparent_reference to the element by
+ * value. Assigning to or swapping the returned reference changes the element,
+ * and copying it (as std::sort does for pivots) copies the value.
+ */
 class ScriptArrayHelperIterator: public ScriptArrayHelperConstIterator {
 public:
 	using iterator_category = std::random_access_iterator_tag;
 	using value_type        = memory_transparent_reference;
-	using reference         = value_type&;
+	using reference         = value_type;
 	using difference_type   = int32;
-	using pointer           = value_type*;
+	using pointer           = void;
 
 public:
 	// inheriting constructors
@@ -385,16 +510,8 @@ public:
 public:
 	// dereference operator
 	[[nodiscard]] reference operator*() const noexcept {
-		// rebuild ref as needed and explitly ignore the [[nodiscard]] return value
-		static_cast<void>(ScriptArrayHelperConstIterator::operator*());
-
-		// return memory_transparent_reference
-		return const_cast<ScriptArrayHelperIterator*>(this)->ref.value();
-	}
-
-	// arrow operator
-	[[nodiscard]] pointer operator->() const noexcept {
-		return &**this;
+		return memory_transparent_reference(ArrayHelper->GetRawPtr(index),
+		                                    *ElementProperty);
 	}
 
 	// prefix increment operator
@@ -491,6 +608,16 @@ ScriptArrayHelperConstIterator cend(FScriptArrayHelper&    ArrayHelper,
 	return ScriptArrayHelperConstIterator(ArrayHelper, ElementProperty, NumArray);
 }
 
+inline int32 GetFPropertyElementSize(const FProperty& property) {
+	return
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    property.ElementSize
+#else
+	    property.GetElementSize()
+#endif
+	    ;
+}
+
 /**
  * Template to create constant false. Use this if I want to static_assert in
  * constexpr if statement.
@@ -502,73 +629,462 @@ constexpr bool false_v = false;
  * Helper function to call a predicate function.
  */
 template <class ReturnT, class... ArgTs>
-static constexpr auto CreateLambdaToCallUFunction(UObject&    Context,
-                                                  UFunction&  Predicate,
-                                                  const int32 ElementSize) {
-	// Total memory size of Predicate arguments and return value
-	const auto& PredicateParamSize =
-	    (... + (std::is_base_of_v<const_memory_transparent_reference,
-	                              std::decay_t<ArgTs>>
-	                ? ElementSize
-	                : sizeof(ArgTs))) +
-	    sizeof(ReturnT);
-
-	// Working memory for Predicate parameters
-	std::shared_ptr<void> PredicateParamWorkingMemory(
-	    ::operator new(PredicateParamSize),
-	    [](void* const ptr) { ::operator delete(ptr); });
+static auto CreateLambdaToCallUFunction(UObject&            Context,
+                                        FPredicateCallPlan& Plan) {
+	static_assert((... && std::is_base_of_v<const_memory_transparent_reference,
+	                                        std::decay_t<ArgTs>>),
+	              "not implemented");
+
+	// parameter frame shared by the copies of the lambda
+	auto PredParamFrame = Plan.AcquireFrame();
 
 	// retun lambda
-	return [&Context, &Predicate, ElementSize,
-	        PredParamWorkingMemory =
-	            std::move(PredicateParamWorkingMemory)](ArgTs... args) {
-		// working offset on PredicateParamWorkingMemory
-		size_t working_offset = 0;
-
-		(..., [&]() {
-			// if the ArgT is derived from const_memory_transparent_reference
-			if constexpr (std::is_base_of_v<const_memory_transparent_reference,
-			                                std::decay_t<ArgTs>>) {
-				// check size
-				check(ElementSize == args.property.GetSize());
-
-				// get raw pointer
-				const auto* const ptr = args.target_ptr;
-
-				// copy data to PredParam
-				std::memcpy(static_cast<uint8*>(PredParamWorkingMemory.get()) +
-				                working_offset,
-				            ptr, ElementSize);
-
-				// add ElementSize to working_offset
-				working_offset += ElementSize;
-			} else {
-				static_assert(udon::false_v<ArgTs>, "not implemented");
-			}
-		}());
+	return [&Context, PredParamFrame = std::move(PredParamFrame)](ArgTs... args) {
+		// pointers to the arguments
+		const void* const Arguments[] = {args.target_ptr...};
 
 		// call Predicate
-		Context.ProcessEvent(&Predicate, PredParamWorkingMemory.get());
+		const auto* const ReturnValue = PredParamFrame->Invoke(Context, Arguments);
 
 		// if return value is present
 		if constexpr (!std::is_same_v<void, ReturnT>) {
 			// return the result
-			return *reinterpret_cast<ReturnT*>(
-			    static_cast<uint8*>(PredParamWorkingMemory.get()) + working_offset);
+			return *static_cast<const ReturnT*>(ReturnValue);
 		}
 	};
 }
 
-inline int32 GetFPropertyElementSize(const FProperty& property) {
-	return
-#if UE_VERSION_OLDER_THAN(5, 5, 0)
-	    property.ElementSize
-#else
-	    property.GetElementSize()
-#endif
-	    ;
+/**
+ * Helper function to call a batch predicate function chunk by chunk.
+ * Visitor is called with the index and the result of each element in order,
+ * and returns whether to continue.
+ */
+template <class VisitorT>
+static void VisitBatchPredicateResults(UObject&            Context,
+                                       FPredicateCallPlan& Plan,
+                                       FScriptArrayHelper& ArrayHelper,
+                                       VisitorT&&          Visitor) {
+	// parameter frame used for all chunks
+	const auto PredParamFrame = Plan.AcquireFrame();
+
+	// results of one chunk
+	TArray<bool> Results;
+	Results.Reserve(FPredicateCallPlan::BatchChunkSize);
+
+	const auto NumArray = ArrayHelper.Num();
+	for (auto First = 0; First < NumArray;
+	     First += FPredicateCallPlan::BatchChunkSize) {
+		// call Predicate with the chunk
+		const auto Count =
+		    FMath::Min(FPredicateCallPlan::BatchChunkSize, NumArray - First);
+		PredParamFrame->InvokeBatch(Context, ArrayHelper, First, Count, Results);
+
+		// visit the results
+		for (auto i = 0; i < Count; ++i) {
+			if (!Visitor(First + i, Results[i])) {
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * Helper function to remove the elements for which ShouldRemove returns true.
+ * The array is scanned once: kept elements are swapped toward the front, so
+ * that the removed elements gather at the end and are destroyed at once.
+ * ShouldRemove is called exactly once for each index, while the element at
+ * the index is still the original one.
+ * @param ArrayHelper  helper of the array
+ * @param ElementSize  size of one element
+ * @param bStable
+ *    If true, kept elements keep their order. Otherwise, removed elements are
+ *    replaced with kept elements from the end, which moves fewer elements.
+ * @param ShouldRemove  returns whether to remove the element at an index
+ */
+template <class ShouldRemoveT>
+static void RemoveElementsIf(FScriptArrayHelper& ArrayHelper,
+                             const int32 ElementSize, const bool bStable,
+                             ShouldRemoveT&& ShouldRemove) {
+	const auto NumArray = ArrayHelper.Num();
+
+	// the number of elements to keep
+	auto NumKept = 0;
+
+	// if the order of kept elements must be kept
+	if (bStable) {
+		for (auto i = 0; i < NumArray; ++i) {
+			// if the element is kept
+			if (!ShouldRemove(i)) {
+				// move it next to the kept elements
+				if (NumKept != i) {
+					FMemory::Memswap(ArrayHelper.GetRawPtr(NumKept),
+					                 ArrayHelper.GetRawPtr(i), ElementSize);
+				}
+				++NumKept;
+			}
+		}
+	}
+	// otherwise, fill the removed elements with kept elements from the end
+	else {
+		auto Last = NumArray;
+		while (true) {
+			// find an element to remove from the front
+			while (NumKept < Last && !ShouldRemove(NumKept)) {
+				++NumKept;
+			}
+			if (NumKept == Last) {
+				break;
+			}
+
+			// find an element to keep from the back
+			--Last;
+			while (NumKept < Last && ShouldRemove(Last)) {
+				--Last;
+			}
+			if (NumKept == Last) {
+				break;
+			}
+
+			// exchange them
+			FMemory::Memswap(ArrayHelper.GetRawPtr(NumKept),
+			                 ArrayHelper.GetRawPtr(Last), ElementSize);
+			++NumKept;
+		}
+	}
+
+	// destroy the removed elements and shrink the array once
+	if (NumKept < NumArray) {
+		ArrayHelper.RemoveValues(NumKept, NumArray - NumKept);
+	}
+}
+
+/**
+ * Helper function to remove the elements that satisfy a predicate function.
+ */
+static void RemoveElementsIfUFunction(UObject&            Context,
+                                      FPredicateCallPlan& Plan,
+                                      FScriptArrayHelper& ArrayHelper,
+                                      const FProperty&    ElementProperty,
+                                      const bool          bStable) {
+	// get the size of one element
+	const auto ElementSize = GetFPropertyElementSize(ElementProperty);
+
+	// if Predicate is a batch predicate
+	if (Plan.IsBatchPredicate()) {
+		// evaluate all elements chunk by chunk before modifying the array
+		TArray<bool> ShouldRemove;
+		ShouldRemove.Reserve(ArrayHelper.Num());
+		VisitBatchPredicateResults(Context, Plan, ArrayHelper,
+		                           [&](int32, const bool bResult) {
+			                           ShouldRemove.Add(bResult);
+			                           return true;
+		                           });
+
+		// remove elements that satisfy Predicate
+		RemoveElementsIf(ArrayHelper, ElementSize, bStable,
+		                 [&](const int32 Index) { return ShouldRemove[Index]; });
+
+		// finish
+		return;
+	}
+
+	// create lambda to call Predicate
+	const auto lambda_predicate =
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&>(
+	        Context, Plan);
+
+	// remove elements that satisfy Predicate
+	RemoveElementsIf(ArrayHelper, ElementSize, bStable, [&](const int32 Index) {
+		return lambda_predicate(const_memory_transparent_reference(
+		    ArrayHelper.GetRawPtr(Index), ElementProperty));
+	});
+}
+
+/**
+ * Helper function to call a registered native predicate.
+ */
+template <class ReturnT, class... ArgTs>
+static auto
+    CreateLambdaToCallNativePredicate(const FUdonNativePredicate& Predicate) {
+	static_assert(std::is_same_v<bool, ReturnT>, "not implemented");
+	static_assert((... && std::is_base_of_v<const_memory_transparent_reference,
+	                                        std::decay_t<ArgTs>>),
+	              "not implemented");
+
+	// if unary
+	if constexpr (sizeof...(ArgTs) == 1) {
+		check(Predicate.NumArguments == 1);
+		return [&Predicate](ArgTs... args) {
+			return Predicate.Unary(args.target_ptr...);
+		};
+	}
+	// otherwise, binary
+	else {
+		static_assert(sizeof...(ArgTs) == 2, "not implemented");
+		check(Predicate.NumArguments == 2);
+		return [&Predicate](ArgTs... args) {
+			return Predicate.Binary(args.target_ptr...);
+		};
+	}
+}
+
+/**
+ * Helper function to sort the indices of elements with a comparison lambda.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param Compare  lambda created by CreateLambdaTo... with two arguments
+ * @param bStable  If true, the order of equivalent elements is kept.
+ * @param[out] OutOrder  The indices of the elements in sorted order.
+ */
+template <class CompareT>
+static void SortIndices(FScriptArrayHelper& ArrayHelper,
+                        const FProperty& ElementProperty, CompareT&& Compare,
+                        const bool bStable, TArray<int32>& OutOrder) {
+	const auto NumArray = ArrayHelper.Num();
+
+	// initialize the indices
+	OutOrder.SetNumUninitialized(NumArray);
+	for (auto i = 0; i < NumArray; ++i) {
+		OutOrder[i] = i;
+	}
+
+	// compare the elements at the indices
+	const auto compare_indices = [&](const int32 A, const int32 B) {
+		return Compare(
+		    const_memory_transparent_reference(ArrayHelper.GetRawPtr(A),
+		                                       ElementProperty),
+		    const_memory_transparent_reference(ArrayHelper.GetRawPtr(B),
+		                                       ElementProperty));
+	};
+
+	// sort the indices
+	if (bStable) {
+		std::stable_sort(OutOrder.GetData(), OutOrder.GetData() + NumArray,
+		                 compare_indices);
+	} else {
+		std::sort(OutOrder.GetData(), OutOrder.GetData() + NumArray,
+		          compare_indices);
+	}
+}
+
+/**
+ * Helper function to sort an array with a comparison lambda. Large elements
+ * are sorted through their indices, so that each element is moved only once.
+ */
+template <class CompareT>
+static void SortElements(FScriptArrayHelper& ArrayHelper,
+                         const FProperty& ElementProperty, CompareT&& Compare) {
+	// get the size of one element
+	const auto ElementSize = GetFPropertyElementSize(ElementProperty);
+
+	// if the elements are small
+	const auto Threshold =
+	    CVarIndexSortElementSizeThreshold.GetValueOnAnyThread();
+	if (Threshold <= 0 || ElementSize < Threshold) {
+		// sort the elements directly
+		std::sort(begin(ArrayHelper, &ElementProperty),
+		          end(ArrayHelper, &ElementProperty), Compare);
+
+		// finish
+		return;
+	}
+
+	// sort the indices, and move the elements to their sorted positions
+	TArray<int32> Order;
+	SortIndices(ArrayHelper, ElementProperty, Compare, false, Order);
+	ApplyPermutation(ArrayHelper, ElementSize, Order);
+}
+
+/**
+ * Number of elements evaluated by one task of parallel evaluation.
+ */
+constexpr int32 ParallelPredicateChunkSize = 1024;
+
+/**
+ * Whether to evaluate a native predicate over NumArray elements in parallel.
+ */
+static bool ShouldEvaluateInParallel(const FUdonNativePredicate& Predicate,
+                                     const int32                 NumArray) {
+	const auto MinNum = CVarParallelPredicateMinNum.GetValueOnAnyThread();
+	return Predicate.bThreadSafe && MinNum > 0 && NumArray >= MinNum &&
+	       FApp::ShouldUseThreadingForPerformance();
+}
+
+/**
+ * Helper function to run Body over chunks of [0, Num) in parallel.
+ * Body is called with the first index and the next index of the last element
+ * of a chunk.
+ */
+template <class BodyT>
+static void ParallelForChunks(const int32 Num, BodyT&& Body) {
+	const auto NumChunks =
+	    FMath::DivideAndRoundUp(Num, ParallelPredicateChunkSize);
+
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const auto First = ChunkIndex * ParallelPredicateChunkSize;
+		const auto Last  = FMath::Min(First + ParallelPredicateChunkSize, Num);
+		Body(First, Last);
+	});
+}
+
+/**
+ * Helper function to start a latent action of a node. If the latent action of
+ * the node is already running, this does nothing.
+ * @param CreateAction  returns a new action of type ActionT
+ */
+template <class ActionT, class CreateActionT>
+static void AddLatentAction(UObject&                 WorldContextObject,
+                            const FLatentActionInfo& LatentInfo,
+                            CreateActionT&&          CreateAction) {
+	// get the world
+	auto* const World = GEngine->GetWorldFromContextObject(
+	    &WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World) {
+		// finish
+		return;
+	}
+
+	// if the action of this node is already running
+	auto& LatentActionManager = World->GetLatentActionManager();
+	if (LatentActionManager.FindExistingAction<ActionT>(
+	        LatentInfo.CallbackTarget, LatentInfo.UUID)) {
+		// finish
+		return;
+	}
+
+	// start the action
+	LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
+	                                 static_cast<ActionT*>(CreateAction()));
+}
+
+/**
+ * Helper function to start sorting an array over several frames as a latent
+ * action.
+ */
+static void StartIncrementalSort(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const UObject* const ComparisonContext,
+    TFunction<bool(const void*, const void*)> Less,
+    const float TimeBudgetMilliseconds, const int32 ComparisonBudget,
+    const FLatentActionInfo& LatentInfo) {
+	AddLatentAction<FIncrementalSortAction>(WorldContextObject, LatentInfo, [&] {
+		return new FIncrementalSortAction(
+		    LatentInfo, TargetArray, ArrayProperty, TargetArrayOwner,
+		    ComparisonContext, MoveTemp(Less), TimeBudgetMilliseconds / 1000.0,
+		    ComparisonBudget);
+	});
+}
+
+/**
+ * Number of elements processed by async work between checks for
+ * cancellation.
+ */
+constexpr int32 AsyncCancelCheckInterval = 1024;
+
+/**
+ * Helper function to start processing a copy of an array on a background
+ * thread as a latent action (see FAsyncArrayAction).
+ */
+static void StartAsyncArrayAction(UObject&                 WorldContextObject,
+                                  const FLatentActionInfo& LatentInfo,
+                                  const void* const        TargetArray,
+                                  const FArrayProperty&    ArrayProperty,
+                                  const UObject* const     TargetArrayOwner,
+                                  FAsyncArrayAction::FWork  Work,
+                                  FAsyncArrayAction::FApply Apply) {
+	AddLatentAction<FAsyncArrayAction>(WorldContextObject, LatentInfo, [&] {
+		return new FAsyncArrayAction(LatentInfo, TargetArray, ArrayProperty,
+		                             TargetArrayOwner, MoveTemp(Work),
+		                             MoveTemp(Apply));
+	});
+}
+
+/**
+ * Helper function to replace the elements of TargetArray with Elements, on
+ * completion of async work. The old elements are moved to Elements.
+ */
+static void SwapWithTargetArray(void* const           TargetArray,
+                                const FArrayProperty& ArrayProperty,
+                                FScriptArray&         Elements,
+                                UObject&              TargetArrayOwner) {
+	FMemory::Memswap(TargetArray, &Elements, sizeof(FScriptArray));
+
+	// notify that the target array was changed
+	MARK_PROPERTY_DIRTY(&TargetArrayOwner, &ArrayProperty);
+}
+
+/**
+ * Helper function to check that an array can be processed by async work.
+ * The copy of the elements processed on a background thread is not visible to
+ * the garbage collector, so arrays whose elements hold object references are
+ * rejected.
+ */
+static bool CanProcessAsync(const FArrayProperty& ArrayProperty,
+                            const TCHAR* const    OperationName) {
+	TArray<const FStructProperty*> EncounteredStructProps;
+	if (!ArrayProperty.Inner->ContainsObjectReference(EncounteredStructProps)) {
+		return true;
+	}
+
+	UE_LOG(LogUdonArrayUtilsLibrary, Error,
+	       TEXT("%s doesn't support elements of type %s, because they hold "
+	            "object references."),
+	       OperationName, *ArrayProperty.Inner->GetCPPType());
+
+	return false;
+}
+
+/**
+ * Minimum number of elements of one run sorted by a worker of parallel sort.
+ */
+constexpr int32 MinNumPerParallelSortRun = 4096;
+
+/**
+ * Returns the number of runs to sort NumArray elements in parallel with a
+ * native comparison function, or 0 if they should be sorted serially.
+ */
+static int32
+    GetParallelSortNumWorkers(const FUdonNativePredicate& ComparisonFunction,
+                              const int32                 NumArray) {
+	// if ComparisonFunction can't be called in parallel, or the array is small
+	const auto MinNum = CVarParallelSortMinNum.GetValueOnAnyThread();
+	if (!ComparisonFunction.bThreadSafe || MinNum <= 0 || NumArray < MinNum ||
+	    !FApp::ShouldUseThreadingForPerformance()) {
+		// finish
+		return 0;
+	}
+
+	// the worker threads and the calling thread
+	auto NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	const auto MaxWorkers = CVarParallelSortMaxWorkers.GetValueOnAnyThread();
+	if (MaxWorkers > 0) {
+		NumWorkers = FMath::Min(NumWorkers, MaxWorkers);
+	}
+	NumWorkers = FMath::Min(NumWorkers, NumArray / MinNumPerParallelSortRun);
+
+	return NumWorkers >= 2 ? NumWorkers : 0;
 }
 
+/**
+ * Registered native predicates.
+ */
+struct FNativePredicateRegistry {
+	FRWLock Lock;
+	TMap<FName, TArray<TSharedPtr<const FUdonNativePredicate>>> Predicates;
+
+	static FNativePredicateRegistry& Get() {
+		static FNativePredicateRegistry Registry;
+		return Registry;
+	}
+};
+
+/**
+ * An output iterator that appends deep copies of elements to a script array.
+ * The helper of the array is created once, and the capacity can be reserved
+ * in advance, so appending doesn't regrow the array element by element.
+ */
 class FScriptArrayBackInsertIterator {
 public:
 	using iterator_category = std::output_iterator_tag;
@@ -581,28 +1097,12 @@ public:
 	using difference_type = void;
 
 public:
-	FScriptArrayBackInsertIterator(FScriptArray&    InScriptArray,
-	                               const FProperty& InElementProperty) noexcept
-	    : ScriptArray(&InScriptArray), ElementProperty(&InElementProperty) {}
+	FScriptArrayBackInsertIterator(FScriptArrayHelper& InArrayHelper,
+	                               const FProperty&    InElementProperty) noexcept
+	    : ArrayHelper(&InArrayHelper), ElementProperty(&InElementProperty) {}
 
 	FScriptArrayBackInsertIterator& operator=(const void* Value) {
-		// create helper for ScriptArray
-		auto ScriptArrayHelper = FScriptArrayHelper::CreateHelperFormInnerProperty(
-		    ElementProperty, ScriptArray);
-
-		// add an element
-		ScriptArrayHelper.AddUninitializedValue();
-
-		// get a pointer to the added element
-		auto* const LastElementPtr =
-		    ScriptArrayHelper.GetRawPtr(ScriptArrayHelper.Num() - 1);
-
-		// get element size
-		const auto& ElementSize = GetFPropertyElementSize(*ElementProperty);
-
-		// copy Value to the added element
-		std::memcpy(LastElementPtr, Value, ElementSize);
-
+		Append(Value, 1);
 		return *this;
 	}
 
@@ -618,10 +1118,111 @@ public:
 		return *this;
 	}
 
+public:
+	/**
+	 * Destroys the elements of the array, and allocates memory for Capacity
+	 * elements at once.
+	 */
+	void ResetWithCapacity(const int32 Capacity) {
+		ArrayHelper->EmptyValues(Capacity);
+	}
+
+	/**
+	 * Appends copies of Count contiguous elements starting at First.
+	 */
+	void Append(const void* const First, const int32 Count) {
+		// if there is nothing to append
+		if (Count <= 0) {
+			// finish
+			return;
+		}
+
+		// get element size
+		const auto& ElementSize = GetFPropertyElementSize(*ElementProperty);
+
+		// add elements
+		const auto Index = ArrayHelper->AddUninitializedValues(Count);
+		auto* const Dest = ArrayHelper->GetRawPtr(Index);
+
+		// if the elements are plain old data
+		if (ElementProperty->HasAnyPropertyFlags(CPF_IsPlainOldData)) {
+			// copy all the elements at once
+			FMemory::Memcpy(Dest, First,
+			                static_cast<SIZE_T>(Count) * ElementSize);
+
+			// finish
+			return;
+		}
+
+		// otherwise, construct and deep copy each element
+		for (auto i = 0; i < Count; ++i) {
+			const auto Offset = static_cast<int64>(i) * ElementSize;
+			ElementProperty->InitializeValue(Dest + Offset);
+			ElementProperty->CopySingleValue(
+			    Dest + Offset, static_cast<const uint8*>(First) + Offset);
+		}
+	}
+
 protected:
-	FScriptArray*    ScriptArray;
-	const FProperty* ElementProperty;
+	FScriptArrayHelper* ArrayHelper;
+	const FProperty*    ElementProperty;
 };
+/**
+ * Random sampling selects indices with Floyd's algorithm when the array has at
+ * least this many elements per sample, and scans all the indices otherwise.
+ */
+constexpr int32 MinArrayPerSparseSample = 8;
+
+/**
+ * Randomly selects NumSamples distinct indices in [0, NumArray), in ascending
+ * order. Few samples are selected with Floyd's algorithm, which draws exactly
+ * NumSamples random numbers, so the time doesn't depend on NumArray. Many
+ * samples are selected by scanning all the indices instead, which is as fast
+ * and needs no hash set.
+ */
+static TArray<int32> SampleIndices(const int32    NumArray,
+                                   const int32    NumSamples,
+                                   FRandomEngine& Engine) {
+	TArray<int32> Indices;
+	Indices.Reserve(NumSamples);
+
+	// if many samples are needed
+	if (static_cast<int64>(NumSamples) * MinArrayPerSparseSample >= NumArray) {
+		// select each index with the probability of the rest samples
+		auto rest_samples = NumSamples;
+		for (auto i = 0; i < NumArray && rest_samples > 0; ++i) {
+			if (static_cast<int32>(Engine.NextBelow(NumArray - i)) <
+			    rest_samples) {
+				--rest_samples;
+				Indices.Add(i);
+			}
+		}
+
+		// finish
+		return Indices;
+	}
+
+	// Floyd's algorithm: for each of the last NumSamples indices j, select a
+	// random index in [0, j], or j itself if that is already selected
+	TSet<int32> Selected;
+	Selected.Reserve(NumSamples);
+	for (auto j = NumArray - NumSamples; j < NumArray; ++j) {
+		const auto t = static_cast<int32>(Engine.NextBelow(j + 1));
+		bool       bAlreadySelected;
+		Selected.Add(t, &bAlreadySelected);
+		if (bAlreadySelected) {
+			Selected.Add(j);
+		}
+	}
+
+	// keep the order of the elements in the array
+	for (const auto Index : Selected) {
+		Indices.Add(Index);
+	}
+	Indices.Sort();
+
+	return Indices;
+}
 } // namespace udon
 
 /**
@@ -654,15 +1255,27 @@ protected:
 int32 UUdonArrayUtilsLibrary::GenericAdjacentFind(
     const void* const TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& BinaryPredicate) {
+	UDON_ARRAY_UTILS_SCOPE(AdjacentFind);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// Find the first iterator that satisfy BinaryPredicate
-	const auto found_it = std::adjacent_find(
+	// get the call plan of BinaryPredicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(BinaryPredicate, *ElementProperty, 2);
+
+	// if BinaryPredicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return INDEX_NONE;
+	}
+
+	// Find the first iterator that satisfy BinaryPredicate
+	const auto found_it = std::adjacent_find(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&,
 	                                const const_memory_transparent_reference&>(
-	        Object, BinaryPredicate, ElementSize));
+	        Object, *Plan));
 
 	return found_it < cend_it ? std::distance(cbegin_it, found_it) : INDEX_NONE;
 }
@@ -670,38 +1283,124 @@ int32 UUdonArrayUtilsLibrary::GenericAdjacentFind(
 bool UUdonArrayUtilsLibrary::GenericAllSatisfy(
     const void* const TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(AllSatisfy);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
+
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return false;
+	}
+
+	// if Predicate is a batch predicate
+	if (Plan->IsBatchPredicate()) {
+		// Check chunk by chunk if all elements of TargetArray satisfy Predicate
+		auto bIsAllSatisfy = true;
+		VisitBatchPredicateResults(Object, *Plan, ArrayHelper,
+		                           [&](int32, const bool bResult) {
+			                           bIsAllSatisfy = bResult;
+			                           return bResult;
+		                           });
+		return bIsAllSatisfy;
+	}
+
 	// Check if all elements of TargetArray satisfy Predicate
 	const auto bIsAllSatisfy = std::all_of(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&>(
-	        Object, Predicate, ElementSize));
+	        Object, *Plan));
 
 	return bIsAllSatisfy;
 }
 
-bool UUdonArrayUtilsLibrary::GenericAnySatisfy(
+/**
+ * GenericAnySatisfy without a stat scope, shared with GenericNoneSatisfy.
+ */
+static bool IsAnySatisfied(
     const void* const TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& Predicate) {
 	PROCESS_ARRAY_ARGUMENTS();
 
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
+
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return false;
+	}
+
+	// if Predicate is a batch predicate
+	if (Plan->IsBatchPredicate()) {
+		// Check chunk by chunk if any element of TargetArray satisfies Predicate
+		auto bIsAnySatisfy = false;
+		VisitBatchPredicateResults(Object, *Plan, ArrayHelper,
+		                           [&](int32, const bool bResult) {
+			                           bIsAnySatisfy = bResult;
+			                           return !bResult;
+		                           });
+		return bIsAnySatisfy;
+	}
+
 	// Check if any element of TargetArray satisfies Predicate
 	const auto bIsAnySatisfy = std::any_of(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&>(
-	        Object, Predicate, ElementSize));
+	        Object, *Plan));
 
 	return bIsAnySatisfy;
 }
 
+bool UUdonArrayUtilsLibrary::GenericAnySatisfy(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(AnySatisfy);
+
+	return IsAnySatisfied(TargetArray, ArrayProperty, Object, Predicate);
+}
+
+bool UUdonArrayUtilsLibrary::GenericAverage(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    void* const OutAverage) {
+	UDON_ARRAY_UTILS_SCOPE(Average);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// compute the average with a loop specialized for the type of the elements
+	if (!AverageTyped(ArrayHelper, *ElementProperty, OutAverage)) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Average doesn't support elements of type %s"),
+		       *ElementProperty->GetCPPType());
+
+		// finish
+		return false;
+	}
+
+	return true;
+}
+
 int32 UUdonArrayUtilsLibrary::GenericCount(const void* const     TargetArray,
                                            const FArrayProperty& ArrayProperty,
                                            const void* const     ItemToCount) {
+	UDON_ARRAY_UTILS_SCOPE(Count);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
+	// if the type of the elements has a specialized loop
+	if (const auto Count =
+	        CountIdenticalTyped(ArrayHelper, *ElementProperty, ItemToCount)) {
+		return *Count;
+	}
+
 	// Count the number of elements matching ItemToCount
 	return std::count(cbegin_it, cend_it, ItemToCount);
 }
@@ -709,25 +1408,90 @@ int32 UUdonArrayUtilsLibrary::GenericCount(const void* const     TargetArray,
 int32 UUdonArrayUtilsLibrary::GenericCountIf(
     const void* const TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(CountIf);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
+
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return 0;
+	}
+
+	// if Predicate is a batch predicate
+	if (Plan->IsBatchPredicate()) {
+		// Count chunk by chunk the elements satisfying Predicate
+		auto Count = 0;
+		VisitBatchPredicateResults(Object, *Plan, ArrayHelper,
+		                           [&](int32, const bool bResult) {
+			                           Count += bResult ? 1 : 0;
+			                           return true;
+		                           });
+		return Count;
+	}
+
 	// Check if any element of TargetArray satisfies Predicate
 	const auto bCount = std::count_if(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&>(
-	        Object, Predicate, ElementSize));
+	        Object, *Plan));
 
 	return bCount;
 }
 
+bool UUdonArrayUtilsLibrary::GenericDotProduct(
+    const void* const A, const void* const B,
+    const FArrayProperty& ArrayProperty, double& OutResult) {
+	UDON_ARRAY_UTILS_SCOPE(DotProduct);
+
+	using namespace udon;
+
+	// get array helpers and element property
+	FScriptArrayHelper ArrayHelperA(&ArrayProperty, A);
+	FScriptArrayHelper ArrayHelperB(&ArrayProperty, B);
+	const auto&        ElementProperty = ArrayProperty.Inner;
+
+	// if the lengths of the arrays differ
+	if (ArrayHelperA.Num() != ArrayHelperB.Num()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("DotProduct requires arrays of the same length (%d != %d)"),
+		       ArrayHelperA.Num(), ArrayHelperB.Num());
+
+		// finish
+		return false;
+	}
+
+	// compute the dot product with a loop specialized for the type of the
+	// elements
+	if (!DotProductTyped(ArrayHelperA, ArrayHelperB, *ElementProperty,
+	                     OutResult)) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("DotProduct doesn't support elements of type %s"),
+		       *ElementProperty->GetCPPType());
+
+		// finish
+		return false;
+	}
+
+	return true;
+}
+
 void UUdonArrayUtilsLibrary::GenericFill(void*                 TargetArray,
                                          const FArrayProperty& ArrayProperty,
                                          const void*           Value) {
+	UDON_ARRAY_UTILS_SCOPE(Fill);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// Fill the all elements of TargetArray with Value
-	std::fill(begin_it, end_it, Value);
+	// Fill the all elements of TargetArray with copies of Value
+	FillElements(ArrayHelper, *ElementProperty, 0, NumArray, Value);
 }
 
 void UUdonArrayUtilsLibrary::GenericFill(void* const           TargetArray,
@@ -735,35 +1499,94 @@ void UUdonArrayUtilsLibrary::GenericFill(void* const           TargetArray,
                                          const int32           StartIndex,
                                          const int32           EndIndex,
                                          const void* const     Value) {
+	UDON_ARRAY_UTILS_SCOPE(Fill);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// Fill the elements of TargetArray with Value
-	std::fill(begin_it + StartIndex, begin_it + EndIndex, Value);
+	// Fill the elements of TargetArray with copies of Value
+	FillElements(ArrayHelper, *ElementProperty, StartIndex, EndIndex, Value);
 }
 
 int32 UUdonArrayUtilsLibrary::GenericFindIf(const void*           TargetArray,
                                             const FArrayProperty& ArrayProperty,
                                             UObject&              Object,
                                             UFunction&            Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(FindIf);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
+
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return INDEX_NONE;
+	}
+
+	// if Predicate is a batch predicate
+	if (Plan->IsBatchPredicate()) {
+		// Find chunk by chunk the first index that satisfies Predicate
+		auto FoundIndex = INDEX_NONE;
+		VisitBatchPredicateResults(Object, *Plan, ArrayHelper,
+		                           [&](const int32 Index, const bool bResult) {
+			                           if (bResult) {
+				                           FoundIndex = Index;
+			                           }
+			                           return !bResult;
+		                           });
+		return FoundIndex;
+	}
+
 	// Find the first iterator that satisfies Predicate
 	const auto found_it = std::find_if(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&>(
-	        Object, Predicate, ElementSize));
+	        Object, *Plan));
 
 	return found_it < cend_it ? std::distance(cbegin_it, found_it) : INDEX_NONE;
 }
 
+/**
+ * GenericMaxElementIndex without a stat scope, shared with GenericMax.
+ */
+static int32 FindMaxElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& ComparisonFunction) {
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return INDEX_NONE;
+	}
+
+	// Find the max element
+	const auto max_it = std::max_element(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&,
+	                                const const_memory_transparent_reference&>(
+	        Object, *Plan));
+
+	return max_it < cend_it ? std::distance(cbegin_it, max_it) : INDEX_NONE;
+}
+
 const void* UUdonArrayUtilsLibrary::GenericMax(
     const void* TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(Max);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
 	// Find the max element's index
-	const auto max_elem_index = GenericMaxElementIndex(
+	const auto max_elem_index = FindMaxElementIndex(
 	    TargetArray, ArrayProperty, Object, ComparisonFunction);
 
 	return INDEX_NONE == max_elem_index ? nullptr
@@ -771,28 +1594,95 @@ const void* UUdonArrayUtilsLibrary::GenericMax(
 }
 
 int32 UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(MaxElementIndex);
+
+	return FindMaxElementIndex(TargetArray, ArrayProperty, Object,
+	                           ComparisonFunction);
+}
+
+/**
+ * GenericMaxElementIndex without a stat scope, shared with GenericMax.
+ */
+static int32 FindMaxElementIndex(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the min and max elements by their values
+	int32 MinIndex;
+	int32 MaxIndex;
+	if (!FindMinMaxIndicesByValue(ArrayHelper, *ElementProperty, Order,
+	                              MinIndex, MaxIndex)) {
+		// finish
+		return INDEX_NONE;
+	}
+
+	return MaxIndex;
+}
+
+const void* UUdonArrayUtilsLibrary::GenericMax(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	UDON_ARRAY_UTILS_SCOPE(Max);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the max element's index
+	const auto max_elem_index =
+	    FindMaxElementIndex(TargetArray, ArrayProperty, Order);
+
+	return INDEX_NONE == max_elem_index ? nullptr
+	                                    : ArrayHelper.GetRawPtr(max_elem_index);
+}
+
+int32 UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	UDON_ARRAY_UTILS_SCOPE(MaxElementIndex);
+
+	return FindMaxElementIndex(TargetArray, ArrayProperty, Order);
+}
+
+/**
+ * GenericMinElementIndex without a stat scope, shared with GenericMin.
+ */
+static int32 FindMinElementIndex(
     const void* TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& ComparisonFunction) {
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// Find the max element
-	const auto max_it = std::max_element(
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return INDEX_NONE;
+	}
+
+	// Find the min element
+	const auto min_it = std::min_element(
 	    cbegin_it, cend_it,
 	    CreateLambdaToCallUFunction<bool,
 	                                const const_memory_transparent_reference&,
 	                                const const_memory_transparent_reference&>(
-	        Object, ComparisonFunction, ElementSize));
+	        Object, *Plan));
 
-	return max_it < cend_it ? std::distance(cbegin_it, max_it) : INDEX_NONE;
+	return min_it < cend_it ? std::distance(cbegin_it, min_it) : INDEX_NONE;
 }
 
 const void* UUdonArrayUtilsLibrary::GenericMin(
     const void* TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(Min);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
 	// Find the min element's index
-	const auto min_elem_index = GenericMinElementIndex(
+	const auto min_elem_index = FindMinElementIndex(
 	    TargetArray, ArrayProperty, Object, ComparisonFunction);
 
 	return INDEX_NONE == min_elem_index ? nullptr
@@ -802,28 +1692,94 @@ const void* UUdonArrayUtilsLibrary::GenericMin(
 int32 UUdonArrayUtilsLibrary::GenericMinElementIndex(
     const void* TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(MinElementIndex);
+
+	return FindMinElementIndex(TargetArray, ArrayProperty, Object,
+	                           ComparisonFunction);
+}
+
+/**
+ * GenericMinElementIndex without a stat scope, shared with GenericMin.
+ */
+static int32 FindMinElementIndex(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// Find the min element
-	const auto min_it = std::min_element(
-	    cbegin_it, cend_it,
-	    CreateLambdaToCallUFunction<bool,
-	                                const const_memory_transparent_reference&,
-	                                const const_memory_transparent_reference&>(
-	        Object, ComparisonFunction, ElementSize));
+	// Find the min and max elements by their values
+	int32 MinIndex;
+	int32 MaxIndex;
+	if (!FindMinMaxIndicesByValue(ArrayHelper, *ElementProperty, Order,
+	                              MinIndex, MaxIndex)) {
+		// finish
+		return INDEX_NONE;
+	}
 
-	return min_it < cend_it ? std::distance(cbegin_it, min_it) : INDEX_NONE;
+	return MinIndex;
+}
+
+const void* UUdonArrayUtilsLibrary::GenericMin(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	UDON_ARRAY_UTILS_SCOPE(Min);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the min element's index
+	const auto min_elem_index =
+	    FindMinElementIndex(TargetArray, ArrayProperty, Order);
+
+	return INDEX_NONE == min_elem_index ? nullptr
+	                                    : ArrayHelper.GetRawPtr(min_elem_index);
+}
+
+int32 UUdonArrayUtilsLibrary::GenericMinElementIndex(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	UDON_ARRAY_UTILS_SCOPE(MinElementIndex);
+
+	return FindMinElementIndex(TargetArray, ArrayProperty, Order);
+}
+
+bool UUdonArrayUtilsLibrary::GenericMinMax(const void* const     TargetArray,
+                                           const FArrayProperty& ArrayProperty,
+                                           int32&                OutMinIndex,
+                                           int32&                OutMaxIndex) {
+	UDON_ARRAY_UTILS_SCOPE(MinMax);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// find min and max with a loop specialized for the type of the elements
+	if (!MinMaxIndicesTyped(ArrayHelper, *ElementProperty, OutMinIndex,
+	                        OutMaxIndex)) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("MinMax doesn't support elements of type %s"),
+		       *ElementProperty->GetCPPType());
+
+		// not found
+		OutMinIndex = OutMaxIndex = INDEX_NONE;
+
+		// finish
+		return false;
+	}
+
+	return true;
 }
 
 bool UUdonArrayUtilsLibrary::GenericNoneSatisfy(
     const void* TargetArray, const FArrayProperty& ArrayProperty,
     UObject& Object, UFunction& Predicate) {
-	return !GenericAnySatisfy(TargetArray, ArrayProperty, Object, Predicate);
+	UDON_ARRAY_UTILS_SCOPE(NoneSatisfy);
+
+	return !IsAnySatisfied(TargetArray, ArrayProperty, Object, Predicate);
 }
 
 void UUdonArrayUtilsLibrary::GenericRemoveRange(
     void* TargetArray, const FArrayProperty& ArrayProperty, int32 StartIndex,
     int32 EndIndex) {
+	UDON_ARRAY_UTILS_SCOPE(RemoveRange);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
 	// get number of elements to remove
@@ -842,104 +1798,1360 @@ void UUdonArrayUtilsLibrary::GenericRemoveRange(
 void UUdonArrayUtilsLibrary::GenericRemoveIf(
     void* TargetArray, const FArrayProperty& ArrayProperty, UObject& Object,
     UFunction& Predicate) {
-	PROCESS_ARRAY_ARGUMENTS();
+	UDON_ARRAY_UTILS_SCOPE(RemoveIf);
 
-	// create lambda to call Predicate
-	const auto lambda_predicate =
-	    CreateLambdaToCallUFunction<bool,
-	                                const const_memory_transparent_reference&>(
-	        Object, Predicate, ElementSize);
+	PROCESS_ARRAY_ARGUMENTS();
 
-	// remove elements that satisfy Predicate
-	for (auto i = decltype(NumArray){0}; i < ArrayHelper.Num(); ++i) {
-		// get element as const_memory_transparent_reference
-		const auto& elem_trans_ref = const_memory_transparent_reference(
-		    ArrayHelper.GetRawPtr(i), *ElementProperty);
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
 
-		// if the element satisfies Predicate
-		if (lambda_predicate(elem_trans_ref)) {
-			// remove the element
-			ArrayHelper.RemoveValues(i, 1);
-			--i;
-		}
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return;
 	}
-}
-
-std::pair<std::shared_ptr<FScriptArray>, std::shared_ptr<FScriptArray>>
-    UUdonArrayUtilsLibrary::GenericRandomSample(
-        const void* TargetArray, const FArrayProperty& ArrayProperty,
-        int32 NumOfSamples) {
-	PROCESS_ARRAY_ARGUMENTS();
 
-	// create a new array to store samples
-	auto Samples = std::make_shared<FScriptArray>();
+	// remove elements that satisfy Predicate, keeping the order of the others
+	RemoveElementsIfUFunction(Object, *Plan, ArrayHelper, *ElementProperty,
+	                          true);
+}
 
-	// create a new array to store others
-	auto Others = std::make_shared<FScriptArray>();
+/**
+ * GenericRandomSample without a stat scope, so that sampling from a copy of
+ * the target array is counted once.
+ */
+static void SelectRandomSamples(const void* const    TargetArray,
+                                const FArrayProperty& ArrayProperty,
+                                const int32           NumOfSamples,
+                                void* const Samples, void* const Others,
+                                udon::FRandomEngine& Engine) {
+	// if an output array is the target array itself
+	if (Samples == TargetArray || Others == TargetArray) {
+		// sample from a copy of the target array
+		FScriptArray Copy;
+		ArrayProperty.InitializeValue(&Copy);
+		ArrayProperty.CopyCompleteValue(&Copy, TargetArray);
+		SelectRandomSamples(&Copy, ArrayProperty, NumOfSamples, Samples, Others,
+		                    Engine);
+		ArrayProperty.DestroyValue(&Copy);
 
-	// if array is empty
-	if (0 == NumArray) {
-		// return the pair of empty arrays
-		return {Samples, Others};
+		// finish
+		return;
 	}
 
-	// create a back inserter for Samples
-	FScriptArrayBackInsertIterator SamplesIt(*Samples, *ElementProperty);
+	PROCESS_ARRAY_ARGUMENTS();
 
-	// create a back inserter for Others
-	FScriptArrayBackInsertIterator OthersIt(*Others, *ElementProperty);
+	// get the number of samples
+	const auto NumSamples = FMath::Clamp(NumOfSamples, 0, NumArray);
+
+	// if Others is not needed
+	if (!Others) {
+		// copy only the selected elements to Samples
+		FScriptArrayHelper             SamplesHelper(&ArrayProperty, Samples);
+		FScriptArrayBackInsertIterator SamplesIt(SamplesHelper, *ElementProperty);
+		SamplesIt.ResetWithCapacity(NumSamples);
+		for (const auto Index : SampleIndices(NumArray, NumSamples, Engine)) {
+			*SamplesIt = ArrayHelper.GetRawPtr(Index);
+			++SamplesIt;
+		}
 
-	// create a pseudo random source engine
-	std::mt19937 mersenne_twister{std::random_device{}()};
+		// finish
+		return;
+	}
 
-	using unsigned_num_t = std::make_unsigned_t<std::decay_t<decltype(NumArray)>>;
+	// create back inserters for Samples and Others, sized exactly
+	FScriptArrayHelper             SamplesHelper(&ArrayProperty, Samples);
+	FScriptArrayHelper             OthersHelper(&ArrayProperty, Others);
+	FScriptArrayBackInsertIterator SamplesIt(SamplesHelper, *ElementProperty);
+	FScriptArrayBackInsertIterator OthersIt(OthersHelper, *ElementProperty);
+	SamplesIt.ResetWithCapacity(NumSamples);
+	OthersIt.ResetWithCapacity(NumArray - NumSamples);
 
 	// sample elements
-	unsigned_num_t rest_samples = NumOfSamples;
-	for (auto it = cbegin_it; it < cend_it; ++it) {
+	auto rest_samples = NumSamples;
+	for (auto i = 0; i < NumArray; ++i) {
 		// get rest length of the array
-		const auto& rest_length = std::distance(it, cend_it);
+		const auto rest_length = NumArray - i;
 
-		// create a uniform distribution for rest_length
-		std::uniform_int_distribution<unsigned_num_t> dist(0, rest_length - 1);
+		// if no more samples are needed
+		if (rest_samples == 0) {
+			// the rest of the elements are others
+			OthersIt.Append(ArrayHelper.GetRawPtr(i), rest_length);
+			break;
+		}
+
+		// if all the rest of the elements are needed
+		if (rest_samples == rest_length) {
+			// the rest of the elements are samples
+			SamplesIt.Append(ArrayHelper.GetRawPtr(i), rest_length);
+			break;
+		}
 
 		// if the element is selected as a sample
-		if (dist(mersenne_twister) < rest_samples) {
+		if (static_cast<int32>(Engine.NextBelow(rest_length)) < rest_samples) {
 			// decrease the number of rest samples
 			--rest_samples;
 
 			// copy the element to Samples
-			*SamplesIt = *it;
-
-			// advance SamplesIt
+			*SamplesIt = ArrayHelper.GetRawPtr(i);
 			++SamplesIt;
 		}
 		// otherwise, the element is not selected as a sample
 		else {
 			// copy the element to Others
-			*OthersIt = *it;
-
-			// advance OthersIt
+			*OthersIt = ArrayHelper.GetRawPtr(i);
 			++OthersIt;
 		}
 	}
+}
+
+void UUdonArrayUtilsLibrary::GenericRandomSample(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const int32 NumOfSamples, void* const Samples, void* const Others,
+    udon::FRandomEngine& Engine) {
+	UDON_ARRAY_UTILS_SCOPE(RandomSample);
 
-	// return the pair of Samples and Others
-	return {Samples, Others};
+	SelectRandomSamples(TargetArray, ArrayProperty, NumOfSamples, Samples,
+	                    Others, Engine);
 }
 
-void UUdonArrayUtilsLibrary::GenericSortAnyArray(
-    void* const TargetArray, const FArrayProperty& ArrayProperty,
-    UObject& Object, UFunction& ComparisonFunction) {
+TArray<int32> UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const int32 NumOfSamples, udon::FRandomEngine& Engine) {
+	UDON_ARRAY_UTILS_SCOPE(RandomSampleIndices);
+
+	using namespace udon;
+
+	// get the length of the array
+	const auto NumArray = FScriptArrayHelper(&ArrayProperty, TargetArray).Num();
+
+	return SampleIndices(NumArray, FMath::Clamp(NumOfSamples, 0, NumArray),
+	                     Engine);
+}
+
+void UUdonArrayUtilsLibrary::GenericShuffle(void* const           TargetArray,
+                                            const FArrayProperty& ArrayProperty,
+                                            udon::FRandomEngine&  Engine) {
+	UDON_ARRAY_UTILS_SCOPE(Shuffle);
+
 	PROCESS_ARRAY_ARGUMENTS();
 
-	// sort the elements of TargetArray
-	std::sort(
-	    begin_it, end_it,
-	    CreateLambdaToCallUFunction<bool,
-	                                const const_memory_transparent_reference&,
-	                                const const_memory_transparent_reference&>(
-	        Object, ComparisonFunction, ElementSize));
+	// swap each element with a random element at or before it
+	for (auto i = NumArray - 1; i > 0; --i) {
+		const auto j = static_cast<int32>(Engine.NextBelow(i + 1));
+		if (i != j) {
+			ArrayHelper.SwapValues(i, j);
+		}
+	}
+}
+
+void UUdonArrayUtilsLibrary::GenericUnstableRemoveIf(
+    void* TargetArray, const FArrayProperty& ArrayProperty, UObject& Object,
+    UFunction& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(UnstableRemoveIf);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the call plan of Predicate
+	const auto Plan =
+	    FPredicateCallPlan::FindOrCreate(Predicate, *ElementProperty, 1);
+
+	// if Predicate can't be called with the elements
+	if (!Plan) {
+		// finish
+		return;
+	}
+
+	// remove elements that satisfy Predicate
+	RemoveElementsIfUFunction(Object, *Plan, ArrayHelper, *ElementProperty,
+	                          false);
+}
+
+/**
+ * GenericWeightedRandomSample without a stat scope, so that sampling from a
+ * copy of the target array is counted once.
+ */
+static bool SelectWeightedRandomSamples(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const TArrayView<const double> Weights, const FString& WeightPropertyPath,
+    const int32 NumOfSamples, const bool bWithReplacement,
+    udon::FRandomEngine& Engine, UUdonAliasTable* const AliasTable,
+    void* const Samples) {
+	// if the output array is the target array itself
+	if (Samples == TargetArray) {
+		// sample from a copy of the target array
+		FScriptArray Copy;
+		ArrayProperty.InitializeValue(&Copy);
+		ArrayProperty.CopyCompleteValue(&Copy, TargetArray);
+		const auto bSucceeded = SelectWeightedRandomSamples(
+		    &Copy, ArrayProperty, Weights, WeightPropertyPath, NumOfSamples,
+		    bWithReplacement, Engine, AliasTable, Samples);
+		ArrayProperty.DestroyValue(&Copy);
+
+		// finish
+		return bSucceeded;
+	}
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the weights of the elements
+	TArray<double> PropertyWeights;
+	auto           ElementWeights = Weights;
+	if (Weights.Num() == 0) {
+		// read the weights from the property
+		if (!ReadWeights(ArrayHelper, *ElementProperty, WeightPropertyPath,
+		                 PropertyWeights)) {
+			// finish
+			return false;
+		}
+
+		ElementWeights = PropertyWeights;
+	}
+	// if the number of the weights is not the length of the array
+	else if (Weights.Num() != NumArray) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("WeightedRandomSample needs one weight per element, but "
+		            "%d weights are given for %d elements."),
+		       Weights.Num(), NumArray);
+
+		// finish
+		return false;
+	}
+
+	// create a back inserter for Samples
+	FScriptArrayHelper             SamplesHelper(&ArrayProperty, Samples);
+	FScriptArrayBackInsertIterator SamplesIt(SamplesHelper, *ElementProperty);
+	const auto                     NumSamples = FMath::Max(NumOfSamples, 0);
+
+	// if an element can be selected several times
+	if (bWithReplacement) {
+		// get the alias table, rebuilding the cached one only if the weights
+		// changed
+		FAliasTable        LocalTable;
+		const FAliasTable* Table = &LocalTable;
+		if (AliasTable) {
+			AliasTable->UpdateWeights(ElementWeights);
+			Table = &AliasTable->GetTable();
+		} else {
+			LocalTable.Build(ElementWeights);
+		}
+
+		// if no weight is positive, nothing can be drawn
+		SamplesIt.ResetWithCapacity(Table->Num() > 0 ? NumSamples : 0);
+		if (Table->Num() == 0) {
+			// finish
+			return true;
+		}
+
+		// draw the samples
+		for (auto i = 0; i < NumSamples; ++i) {
+			*SamplesIt = ArrayHelper.GetRawPtr(Table->Draw(Engine));
+			++SamplesIt;
+		}
+
+		// finish
+		return true;
+	}
+
+	// select distinct elements
+	const auto Indices = WeightedSampleIndices(
+	    ElementWeights, FMath::Min(NumSamples, NumArray), Engine);
+	SamplesIt.ResetWithCapacity(Indices.Num());
+	for (const auto Index : Indices) {
+		*SamplesIt = ArrayHelper.GetRawPtr(Index);
+		++SamplesIt;
+	}
+
+	return true;
+}
+
+bool UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const TArrayView<const double> Weights, const FString& WeightPropertyPath,
+    const int32 NumOfSamples, const bool bWithReplacement,
+    udon::FRandomEngine& Engine, UUdonAliasTable* const AliasTable,
+    void* const Samples) {
+	UDON_ARRAY_UTILS_SCOPE(WeightedRandomSample);
+
+	return SelectWeightedRandomSamples(
+	    TargetArray, ArrayProperty, Weights, WeightPropertyPath, NumOfSamples,
+	    bWithReplacement, Engine, AliasTable, Samples);
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArray(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArray);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return;
+	}
+
+	// sort the elements of TargetArray
+	SortElements(
+	    ArrayHelper, *ElementProperty,
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&,
+	                                const const_memory_transparent_reference&>(
+	        Object, *Plan));
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArray(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const EUdonNaturalOrder Order) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArray);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the order of the elements sorted by their values
+	TArray<int32> SortedOrder;
+	if (!SortIndicesByProperty(ArrayHelper, *ElementProperty, FString(), false,
+	                           SortedOrder, Order)) {
+		// finish
+		return;
+	}
+
+	// move the elements to their sorted positions
+	ApplyPermutation(ArrayHelper, ElementSize, SortedOrder);
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArrayIncremental(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    UObject& Object, UFunction& ComparisonFunction,
+    const float TimeBudgetMilliseconds, const int32 ComparisonBudget,
+    const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArrayIncremental);
+
+	using namespace udon;
+
+	// get property of the element
+	const auto* const ElementProperty = ArrayProperty.Inner;
+
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return;
+	}
+
+	// create lambda to call ComparisonFunction. Object is checked to be alive
+	// by the latent action before each call.
+	auto lambda_comp =
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&,
+	                                const const_memory_transparent_reference&>(
+	        Object, *Plan);
+
+	// start the sort
+	StartIncrementalSort(
+	    WorldContextObject, TargetArray, ArrayProperty, TargetArrayOwner,
+	    &Object,
+	    [Plan, ElementProperty, lambda_comp = MoveTemp(lambda_comp)](
+	        const void* const A, const void* const B) {
+		    return lambda_comp(
+		        const_memory_transparent_reference(A, *ElementProperty),
+		        const_memory_transparent_reference(B, *ElementProperty));
+	    },
+	    TimeBudgetMilliseconds, ComparisonBudget, LatentInfo);
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArrayIncremental(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const float TimeBudgetMilliseconds, const int32 ComparisonBudget,
+    const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArrayIncremental);
+
+	using namespace udon;
+
+	// resolve the values of the elements as the key
+	const auto Accessor = FSortKeyAccessor::Resolve(*ArrayProperty.Inner, {});
+
+	// if the elements can't be compared by their values
+	if (!Accessor) {
+		// finish
+		return;
+	}
+
+	// start the sort
+	StartIncrementalSort(
+	    WorldContextObject, TargetArray, ArrayProperty, TargetArrayOwner,
+	    nullptr,
+	    [Accessor = *Accessor](const void* const A, const void* const B) {
+		    return Accessor.Less(A, B);
+	    },
+	    TimeBudgetMilliseconds, ComparisonBudget, LatentInfo);
+}
+
+TArray<int32> UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(GetSortedIndices);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return {};
+	}
+
+	// sort the indices of the elements
+	TArray<int32> Order;
+	SortIndices(
+	    ArrayHelper, *ElementProperty,
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&,
+	                                const const_memory_transparent_reference&>(
+	        Object, *Plan),
+	    true, Order);
+
+	return Order;
+}
+
+TArray<int32> UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty) {
+	UDON_ARRAY_UTILS_SCOPE(GetSortedIndices);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// sort the indices of the elements by their values
+	TArray<int32> Order;
+	SortIndicesByProperty(ArrayHelper, *ElementProperty, FString(), false,
+	                      Order);
+
+	return Order;
+}
+
+void UUdonArrayUtilsLibrary::GenericSortByProperty(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FString& PropertyPath, const bool bDescending) {
+	UDON_ARRAY_UTILS_SCOPE(SortByProperty);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the order of the elements sorted by the key
+	TArray<int32> Order;
+	if (!SortIndicesByProperty(ArrayHelper, *ElementProperty, PropertyPath,
+	                           bDescending, Order)) {
+		// finish
+		return;
+	}
+
+	// move the elements to their sorted positions
+	ApplyPermutation(ArrayHelper, ElementSize, Order);
+}
+
+void UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    UObject& Object, UFunction& ComparisonFunction, const bool bAdaptive) {
+	UDON_ARRAY_UTILS_SCOPE(StableSortAnyArray);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// get the call plan of ComparisonFunction
+	const auto Plan = FPredicateCallPlan::FindOrCreate(ComparisonFunction,
+	                                                   *ElementProperty, 2);
+
+	// if ComparisonFunction can't be called with the elements
+	if (!Plan) {
+		// finish
+		return;
+	}
+
+	// create lambda to call ComparisonFunction
+	const auto lambda_comp =
+	    CreateLambdaToCallUFunction<bool,
+	                                const const_memory_transparent_reference&,
+	                                const const_memory_transparent_reference&>(
+	        Object, *Plan);
+
+	// sort the elements of TargetArray stably
+	StableSort(
+	    ArrayHelper, ElementSize,
+	    [&](const void* const A, const void* const B) {
+		    return lambda_comp(
+		        const_memory_transparent_reference(A, *ElementProperty),
+		        const_memory_transparent_reference(B, *ElementProperty));
+	    },
+	    bAdaptive);
+}
+
+bool UUdonArrayUtilsLibrary::GenericSum(const void* const     TargetArray,
+                                        const FArrayProperty& ArrayProperty,
+                                        void* const           OutSum) {
+	UDON_ARRAY_UTILS_SCOPE(Sum);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// compute the sum with a loop specialized for the type of the elements
+	if (!SumTyped(ArrayHelper, *ElementProperty, OutSum)) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Sum doesn't support elements of type %s"),
+		       *ElementProperty->GetCPPType());
+
+		// finish
+		return false;
+	}
+
+	return true;
+}
+
+void UUdonArrayUtilsLibrary::CancelAsyncArrayOperations(UObject* Object) {
+	// if no object is given
+	if (!Object) {
+		// finish
+		return;
+	}
+
+	udon::FAsyncArrayAction::CancelActions(*Object);
+}
+
+UObject* UUdonArrayUtilsLibrary::FindArrayOwner(
+    const FFrame& Stack, const void* const ArrayAddr,
+    const FArrayProperty& ArrayProperty, const TCHAR* const OperationName) {
+	// returns whether ArrayAddr is in the Size bytes from Begin
+	const auto IsWithin = [ArrayAddr](const void* const Begin,
+	                                  const int32       Size) {
+		const auto* const Addr       = static_cast<const uint8*>(ArrayAddr);
+		const auto* const BeginBytes = static_cast<const uint8*>(Begin);
+		return BeginBytes && BeginBytes <= Addr && Addr < BeginBytes + Size;
+	};
+
+#if !UE_VERSION_OLDER_THAN(5, 2, 0)
+	// if the array is a member variable of the object it was read from
+	auto* const Container = Stack.MostRecentPropertyContainer;
+	if (Container && ArrayProperty.GetOwner<UClass>() &&
+	    ArrayProperty.ContainerPtrToValuePtr<void>(Container) == ArrayAddr) {
+		return reinterpret_cast<UObject*>(Container);
+	}
+#endif
+
+	// if the array is a member variable of the object running the graph
+	auto* const Object = Stack.Object;
+	if (Object && IsWithin(Object, Object->GetClass()->GetPropertiesSize())) {
+		return Object;
+	}
+
+	// if the array is a local variable of an event graph, which lives as long
+	// as the object running it
+	if (Object && Stack.Node &&
+	    IsWithin(Stack.Locals, Stack.Node->GetPropertiesSize())) {
+		return Object;
+	}
+
+	// output error
+	UE_LOG(LogUdonArrayUtilsLibrary, Error,
+	       TEXT("%s can only modify arrays that are member variables of an "
+	            "object or local variables of an event graph."),
+	       OperationName);
+
+	return nullptr;
+}
+
+void UUdonArrayUtilsLibrary::GenericAsyncCountIf(
+    UObject& WorldContextObject, const void* const TargetArray,
+    const FArrayProperty& ArrayProperty, const FUdonNativePredicate& Predicate,
+    int32& Count, const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(AsyncCountIf);
+
+	using namespace udon;
+
+	check(Predicate.NumArguments == 1);
+
+	// if the elements can't be processed on a background thread
+	if (!CanProcessAsync(ArrayProperty, TEXT("AsyncCountIf"))) {
+		// finish before starting the work
+		return;
+	}
+
+	// the count computed on a background thread
+	const auto Result = MakeShared<int32, ESPMode::ThreadSafe>(0);
+
+	// count the elements that satisfy Predicate
+	auto Work = [Unary = Predicate.Unary, Result](
+	                FScriptArrayHelper&      Elements,
+	                const std::atomic<bool>& bCancelled) {
+		for (auto i = 0; i < Elements.Num(); ++i) {
+			// if cancelled
+			if (i % AsyncCancelCheckInterval == 0 &&
+			    bCancelled.load(std::memory_order_relaxed)) {
+				// finish
+				return;
+			}
+
+			*Result += Unary(Elements.GetRawPtr(i)) ? 1 : 0;
+		}
+	};
+
+	// output the count
+	auto Apply = [Result, &Count](FScriptArray&) { Count = *Result; };
+
+	StartAsyncArrayAction(WorldContextObject, LatentInfo, TargetArray,
+	                      ArrayProperty, nullptr, MoveTemp(Work),
+	                      MoveTemp(Apply));
+}
+
+void UUdonArrayUtilsLibrary::GenericAsyncRandomSample(
+    UObject& WorldContextObject, const void* const TargetArray,
+    const FArrayProperty& ArrayProperty, const int32 NumOfSamples,
+    udon::FRandomEngine& Engine, void* const Samples, void* const Others,
+    const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(AsyncRandomSample);
+
+	using namespace udon;
+
+	// if the elements can't be processed on a background thread
+	if (!CanProcessAsync(ArrayProperty, TEXT("AsyncRandomSample"))) {
+		// finish before starting the work
+		return;
+	}
+
+	// the indices of the samples in ascending order, selected on a background
+	// thread
+	const auto Selected = MakeShared<TArray<int32>, ESPMode::ThreadSafe>();
+
+	// seed the generator of the background work from Engine on this thread,
+	// so that the result is reproducible from the seed of Engine
+	const auto Seed = Engine.Next();
+
+	// select the samples in the same way as GenericRandomSampleIndices
+	auto Work = [NumOfSamples, Seed, Selected](FScriptArrayHelper& Elements,
+	                                           const std::atomic<bool>&) {
+		const auto NumArray = Elements.Num();
+
+		// create the random number generator of this work
+		FRandomEngine WorkEngine(Seed);
+
+		*Selected = SampleIndices(
+		    NumArray, FMath::Clamp(NumOfSamples, 0, NumArray), WorkEngine);
+	};
+
+	// copy the elements to Samples and Others
+	auto Apply = [&ArrayProperty, Selected, Samples,
+	              Others](FScriptArray& Elements) {
+		FScriptArrayHelper ElementsHelper(&ArrayProperty, &Elements);
+		FScriptArrayHelper SamplesHelper(&ArrayProperty, Samples);
+		FScriptArrayHelper OthersHelper(&ArrayProperty, Others);
+
+		// size the outputs exactly
+		const auto NumArray   = ElementsHelper.Num();
+		const auto NumSamples = Selected->Num();
+		FScriptArrayBackInsertIterator SamplesIt(SamplesHelper,
+		                                         *ArrayProperty.Inner);
+		FScriptArrayBackInsertIterator OthersIt(OthersHelper,
+		                                        *ArrayProperty.Inner);
+		SamplesIt.ResetWithCapacity(NumSamples);
+		OthersIt.ResetWithCapacity(NumArray - NumSamples);
+
+		// copy the samples, and the elements between them to Others
+		auto Next = 0;
+		for (const auto Index : *Selected) {
+			OthersIt.Append(ElementsHelper.GetRawPtr(Next), Index - Next);
+			*SamplesIt = ElementsHelper.GetRawPtr(Index);
+			++SamplesIt;
+			Next = Index + 1;
+		}
+
+		// copy the elements after the last sample to Others
+		if (Next < NumArray) {
+			OthersIt.Append(ElementsHelper.GetRawPtr(Next), NumArray - Next);
+		}
+	};
+
+	StartAsyncArrayAction(WorldContextObject, LatentInfo, TargetArray,
+	                      ArrayProperty, nullptr, MoveTemp(Work),
+	                      MoveTemp(Apply));
+}
+
+void UUdonArrayUtilsLibrary::GenericAsyncRemoveIf(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const FUdonNativePredicate& Predicate,
+    const FLatentActionInfo&    LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(AsyncRemoveIf);
+
+	using namespace udon;
+
+	check(Predicate.NumArguments == 1);
+
+	// if the elements can't be processed on a background thread
+	if (!CanProcessAsync(ArrayProperty, TEXT("AsyncRemoveIf"))) {
+		// finish before starting the work
+		return;
+	}
+
+	// whether to remove each element, computed on a background thread
+	const auto ShouldRemove = MakeShared<TArray<bool>, ESPMode::ThreadSafe>();
+
+	// evaluate Predicate for all elements
+	auto Work = [Unary = Predicate.Unary, ShouldRemove](
+	                FScriptArrayHelper&      Elements,
+	                const std::atomic<bool>& bCancelled) {
+		ShouldRemove->SetNumUninitialized(Elements.Num());
+		for (auto i = 0; i < Elements.Num(); ++i) {
+			// if cancelled
+			if (i % AsyncCancelCheckInterval == 0 &&
+			    bCancelled.load(std::memory_order_relaxed)) {
+				// finish
+				return;
+			}
+
+			(*ShouldRemove)[i] = Unary(Elements.GetRawPtr(i));
+		}
+	};
+
+	// remove the elements on the game thread, and replace TargetArray. the
+	// action applies the result only while TargetArrayOwner is alive.
+	auto Apply = [TargetArray, &ArrayProperty, &TargetArrayOwner,
+	              ShouldRemove](FScriptArray& Elements) {
+		FScriptArrayHelper ElementsHelper(&ArrayProperty, &Elements);
+		RemoveElementsIf(
+		    ElementsHelper, GetFPropertyElementSize(*ArrayProperty.Inner), true,
+		    [&](const int32 Index) { return (*ShouldRemove)[Index]; });
+
+		SwapWithTargetArray(TargetArray, ArrayProperty, Elements,
+		                    TargetArrayOwner);
+	};
+
+	StartAsyncArrayAction(WorldContextObject, LatentInfo, TargetArray,
+	                      ArrayProperty, &TargetArrayOwner, MoveTemp(Work),
+	                      MoveTemp(Apply));
+}
+
+void UUdonArrayUtilsLibrary::GenericAsyncSortAnyArray(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const FUdonNativePredicate& ComparisonFunction,
+    const FLatentActionInfo&    LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(AsyncSortAnyArray);
+
+	using namespace udon;
+
+	check(ComparisonFunction.NumArguments == 2);
+
+	// if the elements can't be processed on a background thread
+	if (!CanProcessAsync(ArrayProperty, TEXT("AsyncSortAnyArray"))) {
+		// finish before starting the work
+		return;
+	}
+
+	// sort the elements stably, stopping between merge passes if cancelled
+	auto Work = [Less = ComparisonFunction.Binary,
+	             ElementSize = GetFPropertyElementSize(*ArrayProperty.Inner)](
+	                FScriptArrayHelper&      Elements,
+	                const std::atomic<bool>& bCancelled) {
+		StableSort(Elements, ElementSize, Less, true, &bCancelled);
+	};
+
+	// replace TargetArray with the sorted elements. the action applies the
+	// result only while TargetArrayOwner is alive.
+	auto Apply = [TargetArray, &ArrayProperty,
+	              &TargetArrayOwner](FScriptArray& Elements) {
+		SwapWithTargetArray(TargetArray, ArrayProperty, Elements,
+		                    TargetArrayOwner);
+	};
+
+	StartAsyncArrayAction(WorldContextObject, LatentInfo, TargetArray,
+	                      ArrayProperty, &TargetArrayOwner, MoveTemp(Work),
+	                      MoveTemp(Apply));
+}
+
+void UUdonArrayUtilsLibrary::GenericAsyncSortByProperty(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const FString& PropertyPath, const bool bDescending,
+    const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(AsyncSortByProperty);
+
+	using namespace udon;
+
+	// if the elements can't be processed on a background thread
+	if (!CanProcessAsync(ArrayProperty, TEXT("AsyncSortByProperty"))) {
+		// finish before starting the work
+		return;
+	}
+
+	// if the key can't be used for sorting
+	const auto Accessor =
+	    FSortKeyAccessor::Resolve(*ArrayProperty.Inner, PropertyPath);
+	if (!Accessor) {
+		// finish before starting the work
+		return;
+	}
+
+	// if the key can't be compared on a background thread
+	if (!Accessor->IsThreadSafe()) {
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("AsyncSortByProperty can't sort by text property '%s', "
+		            "because texts are compared on the game thread."),
+		       *PropertyPath);
+
+		// finish before starting the work
+		return;
+	}
+
+	// sort the indices by the key, and move the elements once
+	auto Work = [&ArrayProperty, PropertyPath, bDescending](
+	                FScriptArrayHelper&      Elements,
+	                const std::atomic<bool>& bCancelled) {
+		TArray<int32> Order;
+		if (!SortIndicesByProperty(Elements, *ArrayProperty.Inner, PropertyPath,
+		                           bDescending, Order) ||
+		    bCancelled.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		ApplyPermutation(Elements, GetFPropertyElementSize(*ArrayProperty.Inner),
+		                 Order);
+	};
+
+	// replace TargetArray with the sorted elements. the action applies the
+	// result only while TargetArrayOwner is alive.
+	auto Apply = [TargetArray, &ArrayProperty,
+	              &TargetArrayOwner](FScriptArray& Elements) {
+		SwapWithTargetArray(TargetArray, ArrayProperty, Elements,
+		                    TargetArrayOwner);
+	};
+
+	StartAsyncArrayAction(WorldContextObject, LatentInfo, TargetArray,
+	                      ArrayProperty, &TargetArrayOwner, MoveTemp(Work),
+	                      MoveTemp(Apply));
+}
+
+void UUdonArrayUtilsLibrary::AddNativePredicate(
+    const FName& Name, FUdonNativePredicate&& Predicate) {
+	check(Predicate.MatchesElementProperty);
+	check(Predicate.NumArguments == 1 || Predicate.NumArguments == 2);
+
+	auto& Registry = udon::FNativePredicateRegistry::Get();
+	FWriteScopeLock Lock(Registry.Lock);
+
+	// get the predicates under Name
+	auto& Predicates = Registry.Predicates.FindOrAdd(Name);
+
+	// remove the predicate for the same element type and arity
+	Predicates.RemoveAll([&Predicate](const auto& Registered) {
+		return Registered->MatchesElementProperty ==
+		           Predicate.MatchesElementProperty &&
+		       Registered->NumArguments == Predicate.NumArguments;
+	});
+
+	// register
+	Predicates.Add(MakeShared<const FUdonNativePredicate>(MoveTemp(Predicate)));
+}
+
+void UUdonArrayUtilsLibrary::UnregisterNativePredicate(const FName& Name) {
+	auto& Registry = udon::FNativePredicateRegistry::Get();
+	FWriteScopeLock Lock(Registry.Lock);
+
+	Registry.Predicates.Remove(Name);
+}
+
+TSharedPtr<const FUdonNativePredicate>
+    UUdonArrayUtilsLibrary::FindNativePredicate(
+        const FName& Name, const FProperty& ElementProperty,
+        const int32 NumArguments) {
+	auto& Registry = udon::FNativePredicateRegistry::Get();
+	FReadScopeLock Lock(Registry.Lock);
+
+	// if nothing is registered under Name
+	const auto* const Predicates = Registry.Predicates.Find(Name);
+	if (!Predicates) {
+		return nullptr;
+	}
+
+	// find the predicate for the element type
+	for (const auto& Predicate : *Predicates) {
+		if (Predicate->NumArguments == NumArguments &&
+		    Predicate->MatchesElementProperty(ElementProperty)) {
+			return Predicate;
+		}
+	}
+
+	return nullptr;
+}
+
+TSharedPtr<const FUdonNativePredicate>
+    UUdonArrayUtilsLibrary::FindThreadSafeNativePredicate(
+        const FName& Name, const FProperty& ElementProperty,
+        const int32 NumArguments) {
+	// find the predicate
+	auto Predicate = FindNativePredicate(Name, ElementProperty, NumArguments);
+
+	// if not registered
+	if (!Predicate) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("No native predicate is registered as '%s' for elements of "
+		            "type %s. Async nodes can't call Blueprint functions, which "
+		            "must run on the game thread."),
+		       *Name.ToString(), *ElementProperty.GetCPPType());
+
+		return nullptr;
+	}
+
+	// if not thread-safe
+	if (!Predicate->bThreadSafe) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Native predicate '%s' is not registered as thread-safe, so "
+		            "it can't be used on a background thread."),
+		       *Name.ToString());
+
+		return nullptr;
+	}
+
+	return Predicate;
+}
+
+int32 UUdonArrayUtilsLibrary::GenericAdjacentFind(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& BinaryPredicate) {
+	UDON_ARRAY_UTILS_SCOPE(AdjacentFind);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the first iterator that satisfy BinaryPredicate
+	const auto found_it = std::adjacent_find(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&,
+	        const const_memory_transparent_reference&>(BinaryPredicate));
+
+	return found_it < cend_it ? std::distance(cbegin_it, found_it) : INDEX_NONE;
+}
+
+bool UUdonArrayUtilsLibrary::GenericAllSatisfy(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(AllSatisfy);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		// set when an element that doesn't satisfy Predicate is found
+		std::atomic<bool> bFoundUnsatisfied{false};
+
+		// Check chunks in parallel, stopping all chunks once found
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			for (auto i = First;
+			     i < Last && !bFoundUnsatisfied.load(std::memory_order_relaxed);
+			     ++i) {
+				if (!Predicate.Unary(ArrayHelper.GetRawPtr(i))) {
+					bFoundUnsatisfied.store(true, std::memory_order_relaxed);
+				}
+			}
+		});
+
+		return !bFoundUnsatisfied.load();
+	}
+
+	// Check if all elements of TargetArray satisfy Predicate
+	return std::all_of(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&>(Predicate));
+}
+
+/**
+ * GenericAnySatisfy without a stat scope, shared with GenericNoneSatisfy.
+ */
+static bool IsAnySatisfied(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		// set when an element that satisfies Predicate is found
+		std::atomic<bool> bFoundSatisfied{false};
+
+		// Check chunks in parallel, stopping all chunks once found
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			for (auto i = First;
+			     i < Last && !bFoundSatisfied.load(std::memory_order_relaxed);
+			     ++i) {
+				if (Predicate.Unary(ArrayHelper.GetRawPtr(i))) {
+					bFoundSatisfied.store(true, std::memory_order_relaxed);
+				}
+			}
+		});
+
+		return bFoundSatisfied.load();
+	}
+
+	// Check if any element of TargetArray satisfies Predicate
+	return std::any_of(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&>(Predicate));
+}
+
+bool UUdonArrayUtilsLibrary::GenericAnySatisfy(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(AnySatisfy);
+
+	return IsAnySatisfied(TargetArray, ArrayProperty, Predicate);
+}
+
+int32 UUdonArrayUtilsLibrary::GenericCountIf(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(CountIf);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		std::atomic<int32> Count{0};
+
+		// Count in chunks in parallel, and sum up the counts of the chunks
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			auto ChunkCount = 0;
+			for (auto i = First; i < Last; ++i) {
+				ChunkCount += Predicate.Unary(ArrayHelper.GetRawPtr(i)) ? 1 : 0;
+			}
+			Count.fetch_add(ChunkCount, std::memory_order_relaxed);
+		});
+
+		return Count.load();
+	}
+
+	// Count the elements of TargetArray that satisfy Predicate
+	return std::count_if(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&>(Predicate));
+}
+
+int32 UUdonArrayUtilsLibrary::GenericFindIf(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(FindIf);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		// the smallest index found so far (NumArray if not found)
+		std::atomic<int32> FoundIndex{NumArray};
+
+		// Search chunks in parallel. Elements after the smallest index found
+		// so far are skipped, and the minimum is kept, so the result is always
+		// the first index.
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			for (auto i = First;
+			     i < Last && i < FoundIndex.load(std::memory_order_relaxed); ++i) {
+				if (Predicate.Unary(ArrayHelper.GetRawPtr(i))) {
+					// lower FoundIndex to i
+					auto Current = FoundIndex.load(std::memory_order_relaxed);
+					while (i < Current &&
+					       !FoundIndex.compare_exchange_weak(Current, i)) {
+					}
+					break;
+				}
+			}
+		});
+
+		const auto Result = FoundIndex.load();
+		return Result < NumArray ? Result : INDEX_NONE;
+	}
+
+	// Find the first iterator that satisfies Predicate
+	const auto found_it = std::find_if(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&>(Predicate));
+
+	return found_it < cend_it ? std::distance(cbegin_it, found_it) : INDEX_NONE;
+}
+
+/**
+ * GenericMaxElementIndex without a stat scope, shared with GenericMax.
+ */
+static int32 FindMaxElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the max element
+	const auto max_it = std::max_element(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&,
+	        const const_memory_transparent_reference&>(ComparisonFunction));
+
+	return max_it < cend_it ? std::distance(cbegin_it, max_it) : INDEX_NONE;
+}
+
+const void* UUdonArrayUtilsLibrary::GenericMax(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(Max);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the max element's index
+	const auto max_elem_index =
+	    FindMaxElementIndex(TargetArray, ArrayProperty, ComparisonFunction);
+
+	return INDEX_NONE == max_elem_index ? nullptr
+	                                    : ArrayHelper.GetRawPtr(max_elem_index);
+}
+
+int32 UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(MaxElementIndex);
+
+	return FindMaxElementIndex(TargetArray, ArrayProperty, ComparisonFunction);
+}
+
+/**
+ * GenericMinElementIndex without a stat scope, shared with GenericMin.
+ */
+static int32 FindMinElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the min element
+	const auto min_it = std::min_element(
+	    cbegin_it, cend_it,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&,
+	        const const_memory_transparent_reference&>(ComparisonFunction));
+
+	return min_it < cend_it ? std::distance(cbegin_it, min_it) : INDEX_NONE;
+}
+
+const void* UUdonArrayUtilsLibrary::GenericMin(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(Min);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// Find the min element's index
+	const auto min_elem_index =
+	    FindMinElementIndex(TargetArray, ArrayProperty, ComparisonFunction);
+
+	return INDEX_NONE == min_elem_index ? nullptr
+	                                    : ArrayHelper.GetRawPtr(min_elem_index);
+}
+
+int32 UUdonArrayUtilsLibrary::GenericMinElementIndex(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(MinElementIndex);
+
+	return FindMinElementIndex(TargetArray, ArrayProperty, ComparisonFunction);
+}
+
+bool UUdonArrayUtilsLibrary::GenericNoneSatisfy(
+    const void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(NoneSatisfy);
+
+	return !IsAnySatisfied(TargetArray, ArrayProperty, Predicate);
+}
+
+void UUdonArrayUtilsLibrary::GenericRemoveIf(
+    void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(RemoveIf);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	check(Predicate.NumArguments == 1);
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		// evaluate all elements in parallel before modifying TargetArray
+		TArray<bool> ShouldRemove;
+		ShouldRemove.SetNumUninitialized(NumArray);
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			for (auto i = First; i < Last; ++i) {
+				ShouldRemove[i] = Predicate.Unary(ArrayHelper.GetRawPtr(i));
+			}
+		});
+
+		// remove elements that satisfy Predicate, keeping the order of the others
+		RemoveElementsIf(ArrayHelper, ElementSize, true,
+		                 [&](const int32 Index) { return ShouldRemove[Index]; });
+
+		// finish
+		return;
+	}
+
+	// remove elements that satisfy Predicate, keeping the order of the others
+	RemoveElementsIf(ArrayHelper, ElementSize, true, [&](const int32 Index) {
+		return Predicate.Unary(ArrayHelper.GetRawPtr(Index));
+	});
+}
+
+void UUdonArrayUtilsLibrary::GenericUnstableRemoveIf(
+    void* TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& Predicate) {
+	UDON_ARRAY_UTILS_SCOPE(UnstableRemoveIf);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	check(Predicate.NumArguments == 1);
+
+	// if Predicate can be evaluated in parallel
+	if (ShouldEvaluateInParallel(Predicate, NumArray)) {
+		// evaluate all elements in parallel before modifying TargetArray
+		TArray<bool> ShouldRemove;
+		ShouldRemove.SetNumUninitialized(NumArray);
+		ParallelForChunks(NumArray, [&](const int32 First, const int32 Last) {
+			for (auto i = First; i < Last; ++i) {
+				ShouldRemove[i] = Predicate.Unary(ArrayHelper.GetRawPtr(i));
+			}
+		});
+
+		// remove elements that satisfy Predicate
+		RemoveElementsIf(ArrayHelper, ElementSize, false,
+		                 [&](const int32 Index) { return ShouldRemove[Index]; });
+
+		// finish
+		return;
+	}
+
+	// remove elements that satisfy Predicate
+	RemoveElementsIf(ArrayHelper, ElementSize, false, [&](const int32 Index) {
+		return Predicate.Unary(ArrayHelper.GetRawPtr(Index));
+	});
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArray(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArray);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// if ComparisonFunction can be called in parallel
+	if (const auto NumWorkers =
+	        GetParallelSortNumWorkers(ComparisonFunction, NumArray)) {
+		// sort the indices in parallel, and move the elements once
+		TArray<int32> Order;
+		ParallelSortIndices(ArrayHelper, ComparisonFunction.Binary, NumWorkers,
+		                    Order);
+		ApplyPermutation(ArrayHelper, ElementSize, Order);
+
+		// finish
+		return;
+	}
+
+	// sort the elements of TargetArray
+	SortElements(
+	    ArrayHelper, *ElementProperty,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&,
+	        const const_memory_transparent_reference&>(ComparisonFunction));
+}
+
+void UUdonArrayUtilsLibrary::GenericSortAnyArrayIncremental(
+    UObject& WorldContextObject, void* const TargetArray,
+    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+    const FUdonNativePredicate& ComparisonFunction,
+    const float TimeBudgetMilliseconds, const int32 ComparisonBudget,
+    const FLatentActionInfo& LatentInfo) {
+	UDON_ARRAY_UTILS_SCOPE(SortAnyArrayIncremental);
+
+	using namespace udon;
+
+	check(ComparisonFunction.NumArguments == 2);
+
+	// start the sort
+	StartIncrementalSort(WorldContextObject, TargetArray, ArrayProperty,
+	                     TargetArrayOwner, nullptr, ComparisonFunction.Binary,
+	                     TimeBudgetMilliseconds, ComparisonBudget, LatentInfo);
+}
+
+TArray<int32> UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+    const void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction) {
+	UDON_ARRAY_UTILS_SCOPE(GetSortedIndices);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	// sort the indices of the elements
+	TArray<int32> Order;
+
+	// if ComparisonFunction can be called in parallel
+	if (const auto NumWorkers =
+	        GetParallelSortNumWorkers(ComparisonFunction, NumArray)) {
+		// sort the indices in parallel
+		ParallelSortIndices(ArrayHelper, ComparisonFunction.Binary, NumWorkers,
+		                    Order);
+
+		return Order;
+	}
+
+	SortIndices(
+	    ArrayHelper, *ElementProperty,
+	    CreateLambdaToCallNativePredicate<
+	        bool, const const_memory_transparent_reference&,
+	        const const_memory_transparent_reference&>(ComparisonFunction),
+	    true, Order);
+
+	return Order;
+}
+
+void UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+    void* const TargetArray, const FArrayProperty& ArrayProperty,
+    const FUdonNativePredicate& ComparisonFunction, const bool bAdaptive) {
+	UDON_ARRAY_UTILS_SCOPE(StableSortAnyArray);
+
+	PROCESS_ARRAY_ARGUMENTS();
+
+	check(ComparisonFunction.NumArguments == 2);
+
+	// if ComparisonFunction can be called in parallel
+	if (const auto NumWorkers =
+	        GetParallelSortNumWorkers(ComparisonFunction, NumArray)) {
+		// sort the indices in parallel (the order is stable), and move the
+		// elements once
+		TArray<int32> Order;
+		ParallelSortIndices(ArrayHelper, ComparisonFunction.Binary, NumWorkers,
+		                    Order);
+		ApplyPermutation(ArrayHelper, ElementSize, Order);
+
+		// finish
+		return;
+	}
+
+	// sort the elements of TargetArray stably
+	StableSort(ArrayHelper, ElementSize, ComparisonFunction.Binary, bAdaptive);
+}
+
+UFunction* UUdonArrayUtilsLibrary::FindPredicateFunction(
+    const UObject& Object, const FName& FunctionName) {
+	return FPredicateCallPlan::FindFunction(Object, FunctionName);
 }
 
 #undef PROCESS_ARRAY_ARGUMENTS
@@ -0,0 +1,8 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonArrayUtilsStats.h"
+
+DEFINE_STAT(STAT_UdonArrayUtils_TemporaryElementCopies);
+DEFINE_STAT(STAT_UdonArrayUtils_TemporaryElementHeapAllocations);
+
+CSV_DEFINE_CATEGORY(UdonArrayUtils, false);
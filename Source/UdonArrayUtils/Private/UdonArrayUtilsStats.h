@@ -0,0 +1,35 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("UdonArrayUtils"), STATGROUP_UdonArrayUtils,
+                    STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(UdonArrayUtils);
+
+// number of temporary copies of elements made by the algorithms
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Temporary Element Copies"),
+                                  STAT_UdonArrayUtils_TemporaryElementCopies,
+                                  STATGROUP_UdonArrayUtils, );
+
+// number of heap allocations for temporary copies of elements
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Temporary Element Heap Allocations"),
+    STAT_UdonArrayUtils_TemporaryElementHeapAllocations,
+    STATGROUP_UdonArrayUtils, );
+
+/**
+ * Times the enclosing scope as the array operation Name, both as a cycle stat
+ * ("stat UdonArrayUtils") and as a timing stat of the CSV profiler. The CSV
+ * category "UdonArrayUtils" is disabled by default, and is enabled with
+ * -csvCategories=UdonArrayUtils. Both compile to nothing when the profilers
+ * are disabled.
+ */
+#define UDON_ARRAY_UTILS_SCOPE(Name)                                            \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_UdonArrayUtils_##Name,         \
+	                            STATGROUP_UdonArrayUtils);                       \
+	CSV_SCOPED_TIMING_STAT(UdonArrayUtils, Name)
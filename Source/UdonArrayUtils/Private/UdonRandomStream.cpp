@@ -0,0 +1,54 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonRandomStream.h"
+
+#include <random>
+
+namespace udon {
+void FRandomEngine::SetSeed(uint64 Seed) {
+	// expand the seed into the state with SplitMix64, which never makes the
+	// state all zero
+	for (auto& Word : State) {
+		Seed += 0x9E3779B97F4A7C15ull;
+
+		auto Z = Seed;
+		Z      = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z      = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		Word   = Z ^ (Z >> 31);
+	}
+}
+
+FRandomEngine& FRandomEngine::GetThreadDefault() {
+	thread_local FRandomEngine Engine(
+	    (static_cast<uint64>(std::random_device{}()) << 32) ^
+	    std::random_device{}());
+	return Engine;
+}
+} // namespace udon
+
+UUdonRandomStream* UUdonRandomStream::CreateRandomStream(const int64 Seed) {
+	auto* const RandomStream = NewObject<UUdonRandomStream>();
+	RandomStream->SetSeed(Seed);
+	return RandomStream;
+}
+
+void UUdonRandomStream::SetSeed(const int64 NewSeed) {
+	Seed = NewSeed;
+	Reset();
+}
+
+void UUdonRandomStream::SeedRandomly() {
+	SetSeed(static_cast<int64>(udon::FRandomEngine::GetThreadDefault().Next()));
+}
+
+void UUdonRandomStream::Reset() {
+	Engine.SetSeed(static_cast<uint64>(Seed));
+}
+
+int32 UUdonRandomStream::RandomInteger(const int32 Max) {
+	return Max > 0 ? static_cast<int32>(Engine.NextBelow(Max)) : 0;
+}
+
+double UUdonRandomStream::RandomFraction() {
+	return Engine.NextDouble();
+}
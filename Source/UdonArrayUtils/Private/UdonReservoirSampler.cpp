@@ -0,0 +1,157 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonReservoirSampler.h"
+
+#include "LogUdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsStats.h"
+#include "WeightedSampling.h"
+
+UUdonReservoirSampler* UUdonReservoirSampler::CreateReservoirSampler(
+    const int32 Capacity, const bool bWeighted,
+    UUdonRandomStream* const RandomStream) {
+	auto* const Sampler  = NewObject<UUdonReservoirSampler>();
+	Sampler->Capacity     = FMath::Max(Capacity, 0);
+	Sampler->bWeighted    = bWeighted;
+	Sampler->RandomStream = RandomStream;
+	return Sampler;
+}
+
+void UUdonReservoirSampler::Reset() {
+	NumAdded   = 0;
+	LogW       = 0.0;
+	SkipCount  = 0;
+	SkipWeight = 0.0;
+	Keys.Reset();
+}
+
+bool UUdonReservoirSampler::GenericAdd(void* const           Reservoir,
+                                       const FArrayProperty& ReservoirProperty,
+                                       const void* const     Element,
+                                       const double          Weight) {
+	UDON_ARRAY_UTILS_SCOPE(ReservoirSamplerAdd);
+
+	using namespace udon;
+
+	FScriptArrayHelper ArrayHelper(&ReservoirProperty, Reservoir);
+	const auto&        ElementProperty = *ReservoirProperty.Inner;
+
+	// if this is the first element, allocate all the slots at once
+	if (NumAdded == 0) {
+		ArrayHelper.EmptyValues(Capacity);
+		Keys.Reset(bWeighted ? Capacity : 0);
+	}
+
+	// if the reservoir was changed by someone else
+	const auto NumSamples = bWeighted ? Keys.Num()
+	                                  : static_cast<int32>(FMath::Min<int64>(
+	                                        NumAdded, Capacity));
+	if (ArrayHelper.Num() != NumSamples) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("The reservoir has %d elements, but the sampler has kept "
+		            "%d samples. Pass the same array to every Add, or reset "
+		            "the sampler."),
+		       ArrayHelper.Num(), NumSamples);
+
+		// finish
+		return false;
+	}
+
+	++NumAdded;
+
+	// if the element can't be selected
+	if (Capacity == 0 || (bWeighted && !(Weight > 0.0))) {
+		// finish
+		return false;
+	}
+
+	auto& Engine = GetEngine();
+
+	// if the reservoir is not full yet
+	if (NumSamples < Capacity) {
+		// copy the element into a new slot
+		const auto Slot = ArrayHelper.AddValue();
+		ElementProperty.CopySingleValue(ArrayHelper.GetRawPtr(Slot), Element);
+
+		if (bWeighted) {
+			Keys.HeapPush(
+			    {FMath::Loge(NextPositiveFraction(Engine)) / Weight, Slot});
+			if (Keys.Num() == Capacity) {
+				DrawWeightedSkip(Engine);
+			}
+		} else if (Slot + 1 == Capacity) {
+			LogW = FMath::Loge(NextPositiveFraction(Engine)) / Capacity;
+			DrawUniformSkip(Engine);
+		}
+
+		return true;
+	}
+
+	// if uniform
+	if (!bWeighted) {
+		// if the element is skipped
+		if (SkipCount > 0) {
+			--SkipCount;
+
+			// finish
+			return false;
+		}
+
+		// replace a random slot
+		const auto Slot = static_cast<int32>(Engine.NextBelow(Capacity));
+		ElementProperty.CopySingleValue(ArrayHelper.GetRawPtr(Slot), Element);
+
+		LogW += FMath::Loge(NextPositiveFraction(Engine)) / Capacity;
+		DrawUniformSkip(Engine);
+
+		return true;
+	}
+
+	// if the weight to skip is not reached
+	SkipWeight -= Weight;
+	if (SkipWeight > 0.0) {
+		// finish
+		return false;
+	}
+
+	// draw the key of the element among the keys larger than the smallest,
+	// and replace the slot of the smallest
+	const auto Threshold = Keys.HeapTop().LogKey;
+	const auto Slot      = Keys.HeapTop().Slot;
+	const auto MinKey    = FMath::Exp(Threshold * Weight);
+	const auto Key = MinKey + (1.0 - MinKey) * NextPositiveFraction(Engine);
+	Keys.HeapPopDiscard();
+	Keys.HeapPush({FMath::Loge(Key) / Weight, Slot});
+	ElementProperty.CopySingleValue(ArrayHelper.GetRawPtr(Slot), Element);
+
+	DrawWeightedSkip(Engine);
+
+	return true;
+}
+
+udon::FRandomEngine& UUdonReservoirSampler::GetEngine() const {
+	return RandomStream ? RandomStream->GetEngine()
+	                    : udon::FRandomEngine::GetThreadDefault();
+}
+
+void UUdonReservoirSampler::DrawUniformSkip(udon::FRandomEngine& Engine) {
+	// the number of skipped elements is geometric with the success
+	// probability W
+	const auto LogOneMinusW = FMath::Loge(1.0 - FMath::Exp(LogW));
+	const auto Skip =
+	    LogOneMinusW < 0.0
+	        ? FMath::Loge(udon::NextPositiveFraction(Engine)) / LogOneMinusW
+	        : TNumericLimits<double>::Max();
+	SkipCount = Skip < static_cast<double>(MAX_int64)
+	                ? static_cast<int64>(Skip)
+	                : MAX_int64;
+}
+
+void UUdonReservoirSampler::DrawWeightedSkip(udon::FRandomEngine& Engine) {
+	// if the smallest key is the largest possible key, nothing can beat it
+	const auto Threshold = Keys.HeapTop().LogKey;
+	SkipWeight =
+	    Threshold < 0.0
+	        ? FMath::Loge(udon::NextPositiveFraction(Engine)) / Threshold
+	        : TNumericLimits<double>::Max();
+}
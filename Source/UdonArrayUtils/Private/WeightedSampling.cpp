@@ -0,0 +1,128 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "WeightedSampling.h"
+
+#include "LogUdonArrayUtilsLibrary.h"
+#include "SortKey.h"
+
+namespace udon {
+namespace {
+/**
+ * An index in the selection, with the logarithm of its key. The selection
+ * keeps the indices of the largest keys, so its heap has the smallest on top.
+ */
+struct FWeightedKey {
+	double LogKey;
+	int32  Index;
+
+	[[nodiscard]] bool operator<(const FWeightedKey& Other) const noexcept {
+		return LogKey < Other.LogKey;
+	}
+};
+} // namespace
+
+bool ReadWeights(FScriptArrayHelper& ArrayHelper,
+                 const FProperty& ElementProperty, const FString& PropertyPath,
+                 TArray<double>& OutWeights) {
+	// resolve the weight property
+	const auto Accessor =
+	    FSortKeyAccessor::Resolve(ElementProperty, PropertyPath);
+	if (!Accessor) {
+		// finish
+		return false;
+	}
+
+	// if the weight is not a number
+	if (!Accessor->IsNumeric()) {
+		// output error
+		UE_LOG(LogUdonArrayUtilsLibrary, Error,
+		       TEXT("Can't use '%s' as weights. The weight must be a number."),
+		       *PropertyPath);
+
+		// finish
+		return false;
+	}
+
+	// read the weights
+	const auto NumArray = ArrayHelper.Num();
+	OutWeights.SetNumUninitialized(NumArray);
+	for (auto i = 0; i < NumArray; ++i) {
+		OutWeights[i] = Accessor->GetNumber(ArrayHelper.GetRawPtr(i));
+	}
+
+	return true;
+}
+
+TArray<int32> WeightedSampleIndices(const TArrayView<const double> Weights,
+                                    const int32 NumSamples,
+                                    FRandomEngine& Engine) {
+	TArray<FWeightedKey> Selection;
+	Selection.Reserve(FMath::Max(NumSamples, 0));
+
+	// the key of an index is U^(1/Weight) for a uniform U, and the indices of
+	// the largest keys are selected. keys are compared by their logarithms,
+	// log(U) / Weight, which don't underflow for small weights.
+	const auto Num = Weights.Num();
+	auto       i   = 0;
+
+	// fill the selection with the first positive weights
+	for (; i < Num && Selection.Num() < NumSamples; ++i) {
+		const auto Weight = Weights[i];
+		if (Weight > 0.0) {
+			Selection.Add(
+			    {FMath::Loge(NextPositiveFraction(Engine)) / Weight, i});
+		}
+	}
+	Selection.Heapify();
+
+	// replace the smallest key while the rest of the weights are enough to
+	// beat it
+	while (i < Num && Selection.Num() > 0) {
+		// if the smallest key is the largest possible key, nothing can beat it
+		const auto Threshold = Selection.HeapTop().LogKey;
+		if (Threshold >= 0.0) {
+			break;
+		}
+
+		// draw how much weight to skip over before the next replacement
+		auto Skip = FMath::Loge(NextPositiveFraction(Engine)) / Threshold;
+
+		// skip the indices whose weights don't reach it
+		for (; i < Num; ++i) {
+			const auto Weight = Weights[i];
+			if (Weight > 0.0) {
+				Skip -= Weight;
+				if (Skip <= 0.0) {
+					break;
+				}
+			}
+		}
+
+		// if no index replaces the smallest key
+		if (i == Num) {
+			break;
+		}
+
+		// draw the key of the index among the keys larger than the smallest
+		const auto Weight = Weights[i];
+		const auto MinKey = FMath::Exp(Threshold * Weight);
+		const auto Key = MinKey + (1.0 - MinKey) * NextPositiveFraction(Engine);
+		const FWeightedKey Entry{FMath::Loge(Key) / Weight, i};
+
+		// replace the smallest key
+		Selection.HeapPopDiscard();
+		Selection.HeapPush(Entry);
+		++i;
+	}
+
+	// keep the order of the elements in the array
+	TArray<int32> Indices;
+	Indices.Reserve(Selection.Num());
+	for (const auto& Entry : Selection) {
+		Indices.Add(Entry.Index);
+	}
+	Indices.Sort();
+
+	return Indices;
+}
+} // namespace udon
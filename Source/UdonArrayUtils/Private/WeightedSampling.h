@@ -0,0 +1,47 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UdonRandomStream.h"
+
+namespace udon {
+// returns a uniformly distributed number in (0, 1], whose logarithm is finite
+inline double NextPositiveFraction(FRandomEngine& Engine) {
+	return 1.0 - Engine.NextDouble();
+}
+
+/**
+ * Reads the weights of the elements of an array from a numeric property.
+ * @param ArrayHelper  helper of the array
+ * @param ElementProperty  property of the elements
+ * @param PropertyPath
+ *    path of the weight property (see FSortKeyAccessor::Resolve). If empty,
+ *    the elements themselves are the weights.
+ * @param[out] OutWeights  the weights of the elements
+ * @return
+ *    false if the path can't be resolved or the property is not a number (an
+ *    error is logged).
+ */
+bool ReadWeights(FScriptArrayHelper& ArrayHelper,
+                 const FProperty& ElementProperty, const FString& PropertyPath,
+                 TArray<double>& OutWeights);
+
+/**
+ * Randomly selects distinct indices with probabilities proportional to their
+ * weights, like drawing them one by one without replacement
+ * (Efraimidis-Spirakis sampling with exponential jumps, A-ExpJ). Only about
+ * NumSamples * log(Num / NumSamples) random numbers are drawn, as the indices
+ * that can't enter the selection are skipped over in one go. Negative and NaN
+ * weights are treated as zero, and indices with zero weight are never
+ * selected. Indices with infinite weights are selected before any other.
+ * @param Weights  the weights of the indices
+ * @param NumSamples
+ *    number of indices to select (clamped to the number of positive weights)
+ * @param Engine  the random number generator to draw from
+ * @return  The selected indices, in ascending order.
+ */
+TArray<int32> WeightedSampleIndices(TArrayView<const double> Weights,
+                                    int32 NumSamples, FRandomEngine& Engine);
+} // namespace udon
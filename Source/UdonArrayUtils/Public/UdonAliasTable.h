@@ -0,0 +1,125 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UdonRandomStream.h"
+
+#include "UdonAliasTable.generated.h"
+
+namespace udon {
+/**
+ * A table for drawing indices with probabilities proportional to weights in
+ * constant time (Vose's alias method). Building the table takes time linear
+ * in the number of weights.
+ */
+class UDONARRAYUTILS_API FAliasTable {
+public:
+	/**
+	 * Rebuilds the table from Weights. Negative and NaN weights are treated as
+	 * zero, and indices with zero weight are never drawn. If a weight is
+	 * infinite or the total of the weights overflows, nothing can be drawn.
+	 */
+	void Build(TArrayView<const double> Weights);
+
+	/**
+	 * Draws an index with the probability of its weight over the total weight.
+	 * @return  the index, or INDEX_NONE if no weight is positive.
+	 */
+	int32 Draw(FRandomEngine& Engine) const {
+		// if nothing can be drawn
+		if (Probabilities.Num() == 0) {
+			// finish
+			return INDEX_NONE;
+		}
+
+		// pick a column, then the index itself or its alias
+		const auto Index = static_cast<int32>(Engine.NextBelow(Num()));
+		return Engine.NextDouble() < Probabilities[Index] ? Index
+		                                                  : Aliases[Index];
+	}
+
+	// returns the number of weights the table was built from, or 0 if no
+	// weight is positive
+	int32 Num() const {
+		return Probabilities.Num();
+	}
+
+private:
+	// probability of drawing the index itself in each column
+	TArray<double> Probabilities;
+
+	// index drawn instead of the column's index
+	TArray<int32> Aliases;
+};
+} // namespace udon
+
+/**
+ * A weighted random table that can be kept across frames. Drawing from it
+ * takes constant time, and it is rebuilt only when it is updated with
+ * different weights, so weighted selections with the same weights repeated
+ * every frame don't pay for building it again.
+ */
+UCLASS(BlueprintType)
+class UDONARRAYUTILS_API UUdonAliasTable: public UObject {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates an alias table.
+	 * @param Weights
+	 *    The weights of the indices. Negative weights are treated as zero.
+	 * @return  the created alias table
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random",
+	          meta = (KeyWords = "random weighted alias table loot create"))
+	static UUdonAliasTable* CreateAliasTable(const TArray<double>& Weights);
+
+	/**
+	 * Rebuilds the table if Weights differ from the weights it was built from.
+	 * @param Weights
+	 *    The weights of the indices. Negative weights are treated as zero.
+	 * @return  whether the table was rebuilt.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	bool Update(const TArray<double>& Weights);
+
+	/**
+	 * Draws an index with the probability of its weight over the total weight.
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 * @return  the index, or INDEX_NONE if no weight is positive.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random",
+	          meta = (AdvancedDisplay = "RandomStream"))
+	int32 Draw(UUdonRandomStream* RandomStream);
+
+	/**
+	 * Returns the weights the table was built from.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities|Random")
+	const TArray<double>& GetWeights() const {
+		return Weights;
+	}
+
+public:
+	/**
+	 * Rebuilds the table if Weights differ from the weights it was built from.
+	 * @return  whether the table was rebuilt.
+	 */
+	bool UpdateWeights(TArrayView<const double> InWeights);
+
+	// get the table
+	const udon::FAliasTable& GetTable() const {
+		return Table;
+	}
+
+private:
+	// the weights the table was built from
+	TArray<double> Weights;
+
+	// the table
+	udon::FAliasTable Table;
+};
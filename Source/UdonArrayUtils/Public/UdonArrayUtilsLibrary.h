@@ -3,12 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/LatentActionManager.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "LogUdonArrayUtilsLibrary.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "UObject/UnrealType.h"
-
-#include <memory>
+#include "UdonAliasTable.h"
+#include "UdonNativePredicate.h"
+#include "UdonNaturalOrder.h"
+#include "UdonRandomStream.h"
 
 #include "UdonArrayUtilsLibrary.generated.h"
 
@@ -59,6 +62,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 * @return
 	 *    If the function specified in PredicateName for all elements returns
 	 *    true, this function returns true; otherwise, returns false.
@@ -82,6 +88,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 * @return
 	 *    If the function specified in PredicateName for any element returns
 	 *    true, this function returns true; otherwise, returns false.
@@ -95,6 +104,23 @@ public:
 	static bool AnySatisfy(const TArray<int32>& TargetArray, UObject* Object,
 	                       const FName& PredicateName);
 
+	/**
+	 * Computes the average of the elements of a numeric array.
+	 * Supported element types are int32, int64, float, double and Vector.
+	 * The average of integers is truncated toward zero.
+	 * @param TargetArray  target array
+	 * @param[out] Average
+	 *    The average of the elements. If the array is empty, it is zero. If the
+	 *    type of the elements is not supported, this lvalue is not modified.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Utilities|Array|Math",
+	          CustomThunk,
+	          meta = (CompactNodeTitle = "AVERAGE", ArrayParm = "TargetArray",
+	                  ArrayTypeDependentParams = "Average",
+	                  KeyWords = "average mean numeric"))
+	static void Average(const TArray<int32>& TargetArray,
+	                    /*out*/ int32&       Average);
+
 	/**
 	 * Count the number of elements that match the specified element.
 	 * @param TargetArray  target array
@@ -119,6 +145,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 * @return
 	 *    The total number of elements that returned true when the function with
 	 *    the name specified in PredicateName was applied to each elements.
@@ -132,6 +161,24 @@ public:
 	static int32 CountIf(const TArray<int32>& TargetArray, UObject* Object,
 	                     const FName& PredicateName);
 
+	/**
+	 * Computes the sum of the products of the elements at the same index of two
+	 * numeric arrays of the same length.
+	 * Supported element types are int32, int64, float, double and Vector. For
+	 * Vector elements, the dot products of the vectors are summed.
+	 * @param A  the first array
+	 * @param B  the second array
+	 * @return
+	 *    The sum of the products. If the lengths of the arrays differ or the type
+	 *    of the elements is not supported, an error is logged and 0 is returned.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Utilities|Array|Math",
+	          CustomThunk,
+	          meta = (CompactNodeTitle = "DOT", ArrayParm = "A,B",
+	                  ArrayTypeDependentParams = "B",
+	                  KeyWords = "dot product inner numeric"))
+	static double DotProduct(const TArray<int32>& A, const TArray<int32>& B);
+
 	/**
 	 * Overwrites the entire array with Value.
 	 * @param TargetArray  target array
@@ -168,6 +215,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 * @return
 	 *    Returns the index of the first element that satisfies the predicate.
 	 *    If not found, returns INDEX_NONE (means out of index).
@@ -181,6 +231,31 @@ public:
 	static int32 FindIf(const TArray<int32>& TargetArray, UObject* Object,
 	                    const FName& PredicateName);
 
+	/**
+	 * Returns the indices of the elements in the order sorted by the specified
+	 * comparison function, without modifying the array. Equivalent elements
+	 * keep their order.
+	 * @param TargetArray  target array
+	 * @param Object  An object for which the comparison function is defined.
+	 * @param ComparisonFunctionName
+	 *    The name of a comparison function used to specify if one element
+	 *    should precede another. This must be a function that has two arguments
+	 *    of the same type as the array elements and returns a bool. You should
+	 *    return true if the first argument should precede the second; otherwise,
+	 *    return false. If None, the elements are ordered in ascending order of
+	 *    their values.
+	 * @return
+	 *    The indices of the elements of TargetArray, in sorted order. The i-th
+	 *    element of the sorted array is TargetArray[ReturnValue[i]].
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
+	          meta = (DefaultToSelf = "Object", ArrayParm = "TargetArray",
+	                  AutoCreateRefTerm = "ComparisonFunctionName",
+	                  KeyWords = "sort order arrange index indices permutation"))
+	static TArray<int32> GetSortedIndices(const TArray<int32>& TargetArray,
+	                                      UObject*             Object,
+	                                      const FName& ComparisonFunctionName);
+
 	/**
 	 * Finds the maximum element in the array using a comparison function.
 	 * @param TargetArray  target array
@@ -188,7 +263,8 @@ public:
 	 * @param ComparisonFunctionName
 	 *    The Name of a comparison function that determines which of two elements
 	 *    is greater. You should return true if the first argument is less than
-	 *    the second; otherwise, return false.
+	 *    the second; otherwise, return false. If None, the elements are compared
+	 *    by their values (numbers, bools, enums, Strings, Names and Texts).
 	 * @param[out] MaxValue
 	 *    The maximum element in the array. If the array is empty, this lvalue is
 	 *    not modified.
@@ -214,7 +290,9 @@ public:
 	 *    that defines the order of elements. This function must have two
 	 *    arguments of the same type as the array elements and return a bool. If
 	 *    the first element is considered to be less than the second element,
-	 *    return true; otherwise, return false.
+	 *    return true; otherwise, return false. If None, the elements are
+	 *    compared by their values (numbers, bools, enums, Strings, Names and
+	 *    Texts).
 	 * @return
 	 *    The index of the maximum element in the array. If the array is
 	 *    empty, returns INDEX_NONE.
@@ -239,7 +317,8 @@ public:
 	 * @param ComparisonFunctionName
 	 *    The Name of a comparison function that determines which of two elements
 	 *    is greater. You should return true if the first argument is less than
-	 *    the second; otherwise, return false.
+	 *    the second; otherwise, return false. If None, the elements are compared
+	 *    by their values (numbers, bools, enums, Strings, Names and Texts).
 	 * @param[out] MinValue
 	 *    The minimum element in the array. If the array is empty, this lvalue is
 	 *    not modified.
@@ -265,7 +344,9 @@ public:
 	 *    that defines the order of elements. This function must have two
 	 *    arguments of the same type as the array elements and return a bool. If
 	 *    the first element is considered to be less than the second element,
-	 *    return true; otherwise, return false.
+	 *    return true; otherwise, return false. If None, the elements are
+	 *    compared by their values (numbers, bools, enums, Strings, Names and
+	 *    Texts).
 	 * @return
 	 *    The index of the minimum element in the array. If the array is
 	 *    empty, returns INDEX_NONE.
@@ -283,6 +364,32 @@ public:
 	                             UObject*             Object,
 	                             const FName&         ComparisonFunctionName);
 
+	/**
+	 * Finds both the minimum and maximum elements of a numeric array, with
+	 * SIMD instructions (except for int64).
+	 * Supported element types are int32, int64, float and double. If several
+	 * elements are equal, the first one is found. NaNs are ignored.
+	 * @param TargetArray  target array
+	 * @param[out] MinValue
+	 *    The minimum element. If the array is empty, this lvalue is not
+	 *    modified.
+	 * @param[out] MaxValue
+	 *    The maximum element. If the array is empty, this lvalue is not
+	 *    modified.
+	 * @param[out] MinIndex
+	 *    The index of the minimum element (INDEX_NONE if the array is empty).
+	 * @param[out] MaxIndex
+	 *    The index of the maximum element (INDEX_NONE if the array is empty).
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Utilities|Array|Math",
+	          CustomThunk,
+	          meta = (CompactNodeTitle = "MIN MAX", ArrayParm = "TargetArray",
+	                  ArrayTypeDependentParams = "MinValue,MaxValue",
+	                  KeyWords = "min max minimum maximum numeric"))
+	static void MinMax(const TArray<int32>& TargetArray,
+	                   /*out*/ int32& MinValue, /*out*/ int32& MaxValue,
+	                   /*out*/ int32& MinIndex, /*out*/ int32& MaxIndex);
+
 	/**
 	 * Checks whether none elements of the array satisfy the specified predicate.
 	 * @param TargetArray  target array
@@ -293,6 +400,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 * @return
 	 *    If the function specified in PredicateName for any element returns
 	 *    true, this function returns false; otherwise, returns true.
@@ -329,6 +439,9 @@ public:
 	 *    of the same type as the array elements and returns a bool. If the
 	 *    element is considered to meet your intended condition, return true;
 	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
 	          meta = (CompactNodeTitle = "REMOVE IF", DefaultToSelf = "Object",
@@ -342,17 +455,81 @@ public:
 	 * Randomly select the specified number of samples from the target array.
 	 * @param TargetArray  target array
 	 * @param NumOfSamples  number of samples to randomly select
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
 	 * @param[out] Samples  output array to store the randomly selected samples
 	 * @param[out] Others output array to store the remaining elements
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
-	          meta = (AdvancedDisplay          = "Others",
+	          meta = (AdvancedDisplay          = "RandomStream,Others",
 	                  ArrayParm                = "TargetArray,Samples,Others",
 	                  ArrayTypeDependentParams = "TargetArray,Samples,Others",
 	                  NumOfSamples = 1, KeyWords = "random sample items"))
 	static void RandomSample(const TArray<int32>& TargetArray, int32 NumOfSamples,
+	                         UUdonRandomStream* RandomStream,
 	                         TArray<int32>& Samples, TArray<int32>& Others);
 
+	/**
+	 * Randomly select the specified number of distinct indices of the target
+	 * array. When NumOfSamples is much smaller than the length of the array,
+	 * the time depends only on NumOfSamples, so this is suitable for picking a
+	 * few elements of a large array.
+	 * @param TargetArray  target array
+	 * @param NumOfSamples  number of indices to randomly select
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 * @return  The selected indices, in ascending order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
+	          meta = (AdvancedDisplay = "RandomStream", ArrayParm = "TargetArray",
+	                  NumOfSamples    = 1,
+	                  KeyWords        = "random sample index indices sparse"))
+	static TArray<int32> RandomSampleIndices(const TArray<int32>& TargetArray,
+	                                         int32              NumOfSamples,
+	                                         UUdonRandomStream* RandomStream);
+
+	/**
+	 * Randomly select the specified number of samples from the target array,
+	 * without building the array of the remaining elements. When NumOfSamples
+	 * is much smaller than the length of the array, only the samples are
+	 * visited, so this is suitable for picking a few elements of a large array.
+	 * @param TargetArray  target array
+	 * @param NumOfSamples  number of samples to randomly select
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 * @param[out] Samples
+	 *    output array to store the randomly selected samples, in the same order
+	 *    as in TargetArray
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
+	          meta = (AdvancedDisplay          = "RandomStream",
+	                  ArrayParm                = "TargetArray,Samples",
+	                  ArrayTypeDependentParams = "TargetArray,Samples",
+	                  NumOfSamples             = 1,
+	                  KeyWords = "random sample items sparse pick"))
+	static void RandomSampleSparse(const TArray<int32>& TargetArray,
+	                               int32                NumOfSamples,
+	                               UUdonRandomStream*   RandomStream,
+	                               TArray<int32>&       Samples);
+
+	/**
+	 * Shuffles the elements of the array randomly. Every order is equally
+	 * likely.
+	 * @param TargetArray  target array
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
+	          meta = (CompactNodeTitle = "SHUFFLE", ArrayParm = "TargetArray",
+	                  AdvancedDisplay = "RandomStream",
+	                  KeyWords        = "shuffle random order permutation"))
+	static void Shuffle(UPARAM(ref) TArray<int32>& TargetArray,
+	                    UUdonRandomStream*         RandomStream);
+
 	/**
 	 * Sort an array of any type according to the order of the specified
 	 * comparison function.
@@ -363,7 +540,8 @@ public:
 	 *    should precede another. This must be a function that has two arguments
 	 *    of the same type as the array elements and returns a bool. You should
 	 *    return true if the first argument should precede the second; otherwise,
-	 *    return false.
+	 *    return false. If None, the elements are sorted in ascending order of
+	 *    their values; numbers, bools and enums are then sorted by a radix sort.
 	 */
 	UFUNCTION(
 	    BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
@@ -375,6 +553,195 @@ public:
 	                         UObject*                   Object,
 	                         const FName&               ComparisonFunctionName);
 
+	/**
+	 * Sort an array of any type over several frames, so that sorting a large
+	 * array with a slow comparison function doesn't stall a frame. The
+	 * elements are compared in place, and are moved to their sorted positions
+	 * at once when the sort is finished, so TargetArray is never seen
+	 * partially sorted. If elements are added to or removed from TargetArray
+	 * while sorting, or the object that owns TargetArray is destroyed, the
+	 * sort is cancelled. Elements that are equivalent keep their order.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  sort target array
+	 * @param Object  An object for which the comparison function is defined.
+	 * @param ComparisonFunctionName
+	 *    The name of a comparison function used to specify if one element
+	 *    should precede another. This must be a function that has two arguments
+	 *    of the same type as the array elements and returns a bool. You should
+	 *    return true if the first argument should precede the second; otherwise,
+	 *    return false. If None, the elements are sorted in ascending order of
+	 *    their values.
+	 * @param TimeBudgetMilliseconds
+	 *    Time spent sorting per frame, in milliseconds. 0 means no limit.
+	 * @param ComparisonBudget
+	 *    Number of comparisons per frame. 0 means no limit. If both budgets
+	 *    are 0, the sort is finished in the first frame.
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext = "WorldContextObject", DefaultToSelf = "Object",
+	                  ArrayParm         = "TargetArray",
+	                  AutoCreateRefTerm = "ComparisonFunctionName",
+	                  AdvancedDisplay   = "ComparisonBudget",
+	                  KeyWords = "sort order arrange predicate compare comparison "
+	                             "incremental latent frame budget time slice"))
+	static void SortAnyArrayIncremental(UObject* WorldContextObject,
+	                                    UPARAM(ref) TArray<int32>& TargetArray,
+	                                    UObject*                   Object,
+	                                    const FName& ComparisonFunctionName,
+	                                    float TimeBudgetMilliseconds = 1.0f,
+	                                    int32 ComparisonBudget       = 0,
+	                                    FLatentActionInfo LatentInfo = {});
+
+	/**
+	 * Sort an array by the value of a property of the elements, without
+	 * calling a comparison function. Elements with equal keys keep their
+	 * order.
+	 * @param TargetArray  sort target array
+	 * @param PropertyPath
+	 *    The names of the properties to sort by, separated by '.', such as
+	 *    "Stats.Score". Each name but the last must be a struct property. If
+	 *    empty, the elements themselves are sorted. The key must be a number,
+	 *    bool, enum, String, Name or Text. Numbers, bools and enums are sorted
+	 *    by a radix sort. Strings and Names are compared case insensitively.
+	 * @param bDescending  If true, sort in descending order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
+	          meta = (ArrayParm = "TargetArray",
+	                  KeyWords  = "sort order arrange property member field key"))
+	static void SortByProperty(UPARAM(ref) TArray<int32>& TargetArray,
+	                           const FString& PropertyPath,
+	                           bool           bDescending = false);
+
+	/**
+	 * Sort an array in ascending order of the values of the elements, without
+	 * calling a comparison function. Elements with equal values keep their
+	 * order.
+	 * @param TargetArray  sort target array
+	 * @param Order
+	 *    How strings and names are compared. Numbers, bools and enums are
+	 *    always sorted by value, and texts by the current culture.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
+	          meta = (ArrayParm = "TargetArray",
+	                  KeyWords  = "sort order arrange natural value string name"))
+	static void SortNatural(UPARAM(ref) TArray<int32>& TargetArray,
+	                        EUdonNaturalOrder          Order);
+
+	/**
+	 * Sort an array of any type according to the order of the specified
+	 * comparison function. Unlike SortAnyArray, elements that are equivalent
+	 * keep their order.
+	 * @param TargetArray  sort target array
+	 * @param Object  An object for which the comparison function is defined.
+	 * @param ComparisonFunctionName
+	 *    The name of a comparison function used to specify if one element
+	 *    should precede another. This must be a function that has two arguments
+	 *    of the same type as the array elements and returns a bool. You should
+	 *    return true if the first argument should precede the second; otherwise,
+	 *    return false. If None, the elements are sorted in ascending order of
+	 *    their values.
+	 * @param bAdaptive
+	 *    If true, already sorted parts of the array are detected and reused,
+	 *    which makes sorting nearly sorted arrays much faster.
+	 */
+	UFUNCTION(
+	    BlueprintCallable, Category = "Utilities|Array|Sort", CustomThunk,
+	    meta = (CompactNodeTitle = "STABLE SORT", DefaultToSelf = "Object",
+	            ArrayParm = "TargetArray", AdvancedDisplay = "bAdaptive",
+	            AutoCreateRefTerm = "ComparisonFunctionName",
+	            KeyWords =
+	                "sort order arrange predicate compare comparison stable"))
+	static void StableSortAnyArray(UPARAM(ref) TArray<int32>& TargetArray,
+	                               UObject*                   Object,
+	                               const FName& ComparisonFunctionName,
+	                               bool         bAdaptive = true);
+
+	/**
+	 * Computes the sum of the elements of a numeric array.
+	 * Supported element types are int32, int64, float, double and Vector
+	 * (summed component-wise). The sum of int32 elements is clamped to the range
+	 * of int32, and the sum of int64 elements wraps around on overflow.
+	 * @param TargetArray  target array
+	 * @param[out] Sum
+	 *    The sum of the elements. If the type of the elements is not supported,
+	 *    this lvalue is not modified.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Utilities|Array|Math",
+	          CustomThunk,
+	          meta = (CompactNodeTitle = "SUM", ArrayParm = "TargetArray",
+	                  ArrayTypeDependentParams = "Sum",
+	                  KeyWords = "sum total add numeric"))
+	static void Sum(const TArray<int32>& TargetArray, /*out*/ int32& Sum);
+
+	/**
+	 * Removes elements from the array that satisfy the specified predicate.
+	 * Unlike RemoveIf, the order of the remaining elements is not kept: each
+	 * removed element is replaced with a remaining element from the end.
+	 * @param TargetArray  target array
+	 * @param Object  An object for which the predicate is defined.
+	 * @param PredicateName
+	 *    The name of a unary predicate function that defines whether the element
+	 *    satisfies the condition. This must be a function that has one argument
+	 *    of the same type as the array elements and returns a bool. If the
+	 *    element is considered to meet your intended condition, return true;
+	 *    otherwise, return false.
+	 *    A batch predicate, which has one argument of an array of the elements
+	 *    and returns an array of bools of the same length, can also be
+	 *    specified. It is called once per chunk of elements.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
+	          meta = (CompactNodeTitle = "REMOVE IF (UNSTABLE)",
+	                  DefaultToSelf = "Object", ArrayParm = "TargetArray",
+	                  AutoCreateRefTerm = "PredicateName",
+	                  KeyWords          = "remove delete erase if predicate "
+	                                      "condition unstable swap"))
+	static void UnstableRemoveIf(UPARAM(ref) TArray<int32>& TargetArray,
+	                             UObject* Object, const FName& PredicateName);
+
+	/**
+	 * Randomly select the specified number of samples from the target array,
+	 * with the probability of each element proportional to its weight.
+	 * @param TargetArray  target array
+	 * @param Weights
+	 *    The weights of the elements, of the same length as TargetArray. If
+	 *    empty, the weights are read from WeightPropertyPath. Negative weights
+	 *    are treated as zero, and elements with zero weight are never selected.
+	 * @param WeightPropertyPath
+	 *    Names of properties separated by '.', such as "Drop.Weight", of a
+	 *    numeric property of the elements to use as the weights when Weights
+	 *    is empty. If also empty, the elements themselves are the weights.
+	 * @param NumOfSamples  number of samples to randomly select
+	 * @param bWithReplacement
+	 *    If true, each sample is drawn from all the elements, so an element
+	 *    can be selected several times, and the samples are in the order they
+	 *    are drawn. If false, each element is selected at most once, and the
+	 *    samples are in the same order as in TargetArray.
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 * @param AliasTable
+	 *    An alias table to keep across calls when drawing with replacement. It
+	 *    is rebuilt only when the weights change, so repeated draws with the
+	 *    same weights take time depending only on NumOfSamples. If not given,
+	 *    a table is built on every call.
+	 * @param[out] Samples  output array to store the randomly selected samples
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array", CustomThunk,
+	          meta = (AdvancedDisplay =
+	                      "WeightPropertyPath,RandomStream,AliasTable",
+	                  ArrayParm                = "TargetArray,Samples",
+	                  ArrayTypeDependentParams = "TargetArray,Samples",
+	                  AutoCreateRefTerm        = "Weights,WeightPropertyPath",
+	                  NumOfSamples             = 1,
+	                  KeyWords = "random sample weighted loot table spawn"))
+	static void WeightedRandomSample(
+	    const TArray<int32>& TargetArray, const TArray<double>& Weights,
+	    const FString& WeightPropertyPath, int32 NumOfSamples,
+	    bool bWithReplacement, UUdonRandomStream* RandomStream,
+	    UUdonAliasTable* AliasTable, TArray<int32>& Samples);
+
 public:
 	/**
 	 * Searches for the first pair of adjacent elements that satisfy the
@@ -438,6 +805,19 @@ public:
 	                              const FArrayProperty& ArrayProperty,
 	                              UObject& Object, UFunction& Predicate);
 
+	/**
+	 * Computes the average of the elements of a numeric array.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param[out] OutAverage  pointer to a value of the element type to set
+	 * @return
+	 *    false if the type of the elements is not supported (an error is
+	 *    logged).
+	 */
+	static bool GenericAverage(const void*           TargetArray,
+	                           const FArrayProperty& ArrayProperty,
+	                           void*                 OutAverage);
+
 	/**
 	 * Count the number of elements that match the specified element.
 	 * @param TargetArray  target array
@@ -469,6 +849,21 @@ public:
 	                            const FArrayProperty& ArrayProperty,
 	                            UObject& Object, UFunction& Predicate);
 
+	/**
+	 * Computes the sum of the products of the elements at the same index of two
+	 * numeric arrays.
+	 * @param A  the first array
+	 * @param B  the second array (of the same type as A)
+	 * @param ArrayProperty  property of A
+	 * @param[out] OutResult  the sum of the products
+	 * @return
+	 *    false if the lengths of the arrays differ or the type of the elements
+	 *    is not supported (an error is logged).
+	 */
+	static bool GenericDotProduct(const void* A, const void* B,
+	                              const FArrayProperty& ArrayProperty,
+	                              double&               OutResult);
+
 	/**
 	 * Overwrites the entire array with Value.
 	 * @param TargetArray  target array
@@ -512,6 +907,39 @@ public:
 	                           const FArrayProperty& ArrayProperty,
 	                           UObject& Object, UFunction& Predicate);
 
+	/**
+	 * Returns the indices of the elements in the order sorted by the specified
+	 * comparison function. The order is stable.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Object  An object for which the binary comparison function is
+	 *                defined.
+	 * @param ComparisonFunction
+	 *    A comparison function used to specify if one element should
+	 *    precede another. This must be a function that has two arguments of the
+	 *    same type as the array elements and returns a bool. You should return
+	 *    true if the first argument should precede the second; otherwise,
+	 *    return false.
+	 * @return  The indices of the elements in sorted order.
+	 */
+	static TArray<int32> GenericGetSortedIndices(
+	    const void* TargetArray, const FArrayProperty& ArrayProperty,
+	    UObject& Object, UFunction& ComparisonFunction);
+
+	/**
+	 * Returns the indices of the elements in ascending order of their values.
+	 * The order is stable.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @return
+	 *    The indices of the elements in sorted order. If the elements can't be
+	 *    ordered by their values, an error is logged and an empty array is
+	 *    returned.
+	 */
+	static TArray<int32>
+	    GenericGetSortedIndices(const void*           TargetArray,
+	                            const FArrayProperty& ArrayProperty);
+
 	/**
 	 * Finds the maximum element in the array using a comparison function.
 	 * @param TargetArray  target array
@@ -528,6 +956,20 @@ public:
 	                              const FArrayProperty& ArrayProperty,
 	                              UObject& Object, UFunction& ComparisonFunction);
 
+	/**
+	 * Finds the maximum element in the array by the values of the elements,
+	 * without calling a comparison function.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Order  how strings and names are compared
+	 * @return
+	 *    The pointer to the maximum element in the array. If the array is empty
+	 *    or the elements can't be compared by their values, returns nullptr.
+	 */
+	static const void* GenericMax(const void*           TargetArray,
+	                              const FArrayProperty& ArrayProperty,
+	                              EUdonNaturalOrder     Order);
+
 	/**
 	 * Searches for the index of the maximum element in the array using a custom
 	 * comparison function.
@@ -549,6 +991,21 @@ public:
 	                                    UObject&              Object,
 	                                    UFunction&            ComparisonFunction);
 
+	/**
+	 * Searches for the index of the maximum element in the array by the values
+	 * of the elements, without calling a comparison function.
+	 * @param TargetArray  The target array to search.
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Order  how strings and names are compared
+	 * @return
+	 *    The index of the maximum element in the array. If the array is empty
+	 *    or the elements can't be compared by their values, returns
+	 *    INDEX_NONE.
+	 */
+	static int32 GenericMaxElementIndex(const void*           TargetArray,
+	                                    const FArrayProperty& ArrayProperty,
+	                                    EUdonNaturalOrder     Order);
+
 	/**
 	 * Finds the minimum element in the array using a comparison function.
 	 * @param TargetArray  target array
@@ -566,6 +1023,20 @@ public:
 	                              const FArrayProperty& ArrayProperty,
 	                              UObject& Object, UFunction& ComparisonFunction);
 
+	/**
+	 * Finds the minimum element in the array by the values of the elements,
+	 * without calling a comparison function.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Order  how strings and names are compared
+	 * @return
+	 *    The pointer to the minimum element in the array. If the array is empty
+	 *    or the elements can't be compared by their values, returns nullptr.
+	 */
+	static const void* GenericMin(const void*           TargetArray,
+	                              const FArrayProperty& ArrayProperty,
+	                              EUdonNaturalOrder     Order);
+
 	/**
 	 * Searches for the index of the minimum element in the array using a custom
 	 * comparison function.
@@ -587,6 +1058,38 @@ public:
 	                                    UObject&              Object,
 	                                    UFunction&            ComparisonFunction);
 
+	/**
+	 * Searches for the index of the minimum element in the array by the values
+	 * of the elements, without calling a comparison function.
+	 * @param TargetArray  The target array to search.
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Order  how strings and names are compared
+	 * @return
+	 *    The index of the minimum element in the array. If the array is empty
+	 *    or the elements can't be compared by their values, returns
+	 *    INDEX_NONE.
+	 */
+	static int32 GenericMinElementIndex(const void*           TargetArray,
+	                                    const FArrayProperty& ArrayProperty,
+	                                    EUdonNaturalOrder     Order);
+
+	/**
+	 * Finds the indices of the minimum and maximum elements of a numeric array
+	 * (see MinMax).
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param[out] OutMinIndex
+	 *    The index of the minimum element (INDEX_NONE if the array is empty).
+	 * @param[out] OutMaxIndex
+	 *    The index of the maximum element (INDEX_NONE if the array is empty).
+	 * @return
+	 *    false if the type of the elements is not supported (an error is
+	 *    logged).
+	 */
+	static bool GenericMinMax(const void*           TargetArray,
+	                          const FArrayProperty& ArrayProperty,
+	                          int32& OutMinIndex, int32& OutMaxIndex);
+
 	/**
 	 * Checks whether none elements of the array satisfy the specified predicate.
 	 * @param TargetArray  target array
@@ -638,17 +1141,51 @@ public:
 
 	/**
 	 * Randomly select the specified number of samples from the target array.
+	 * The output arrays are overwritten, and each of them is allocated once
+	 * with its exact size.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray, Samples and Others
+	 * @param NumOfSamples
+	 *    number of samples to randomly select (clamped to the length of
+	 *    TargetArray)
+	 * @param[out] Samples  array to store the randomly selected samples
+	 * @param[out] Others
+	 *    array to store the remaining elements. If null, the remaining elements
+	 *    are not visited, and the samples are selected in time depending only
+	 *    on NumOfSamples when it is small.
+	 * @param Engine  the random number generator to draw from
+	 */
+	static void GenericRandomSample(const void*           TargetArray,
+	                                const FArrayProperty& ArrayProperty,
+	                                int32 NumOfSamples, void* Samples,
+	                                void* Others, udon::FRandomEngine& Engine);
+
+	/**
+	 * Randomly select distinct indices of an array (Floyd's algorithm when
+	 * NumOfSamples is small compared to the length of the array).
 	 * @param TargetArray  target array
 	 * @param ArrayProperty  property of TargetArray
-	 * @param NumOfSamples  number of samples to randomly select
-	 * @return
-	 *    A pair of two arrays. The first array contains the randomly
-	 *    selected samples, and the second array contains the remaining elements.
+	 * @param NumOfSamples
+	 *    number of indices to randomly select (clamped to the length of
+	 *    TargetArray)
+	 * @param Engine  the random number generator to draw from
+	 * @return  The selected indices, in ascending order.
 	 */
-	static std::pair<std::shared_ptr<FScriptArray>, std::shared_ptr<FScriptArray>>
-	    GenericRandomSample(const void*           TargetArray,
-	                        const FArrayProperty& ArrayProperty,
-	                        int32                 NumOfSamples);
+	static TArray<int32>
+	    GenericRandomSampleIndices(const void*           TargetArray,
+	                               const FArrayProperty& ArrayProperty,
+	                               int32                 NumOfSamples,
+	                               udon::FRandomEngine&  Engine);
+
+	/**
+	 * Shuffles the elements of an array randomly (Fisher-Yates shuffle).
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Engine  the random number generator to draw from
+	 */
+	static void GenericShuffle(void* TargetArray,
+	                           const FArrayProperty& ArrayProperty,
+	                           udon::FRandomEngine&  Engine);
 
 	/**
 	 * Sort an array according to the order of the specified comparison function.
@@ -668,31 +1205,675 @@ public:
 	                                UObject&              Object,
 	                                UFunction&            ComparisonFunction);
 
-public:
-	DECLARE_FUNCTION(execAdjacentFind) {
-		///////////////////////////////////
-		// read argument 0 (TargetArray) //
-		///////////////////////////////////
+	/**
+	 * Sort an array stably in ascending order of the values of the elements,
+	 * without calling a comparison function.
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Order  how strings and names are compared
+	 */
+	static void GenericSortAnyArray(void*                 TargetArray,
+	                                const FArrayProperty& ArrayProperty,
+	                                EUdonNaturalOrder     Order);
 
-		// reset MostRecentProperty
-		Stack.MostRecentProperty = nullptr;
+	/**
+	 * Starts sorting an array stably over several frames according to the
+	 * order of the specified comparison function.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray (see FindArrayOwner). If it is
+	 *    destroyed, the sort is cancelled.
+	 * @param Object  An object for which the binary comparison function is
+	 *                defined.
+	 * @param ComparisonFunction
+	 *    A comparison function used to specify if one element should
+	 *    precede another. This must be a function that has two arguments of the
+	 *    same type as the array elements and returns a bool. You should return
+	 *    true if the first argument should precede the second; otherwise,
+	 *    return false.
+	 * @param TimeBudgetMilliseconds  time spent sorting per frame (0: no limit)
+	 * @param ComparisonBudget  number of comparisons per frame (0: no limit)
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericSortAnyArrayIncremental(
+	    UObject& WorldContextObject, void* TargetArray,
+	    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+	    UObject& Object, UFunction& ComparisonFunction,
+	    float TimeBudgetMilliseconds, int32 ComparisonBudget,
+	    const FLatentActionInfo& LatentInfo);
 
-		// read an array from Stack
-		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	/**
+	 * Starts sorting an array stably over several frames in ascending order of
+	 * the values of the elements.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray (see FindArrayOwner). If it is
+	 *    destroyed, the sort is cancelled.
+	 * @param TimeBudgetMilliseconds  time spent sorting per frame (0: no limit)
+	 * @param ComparisonBudget  number of comparisons per frame (0: no limit)
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericSortAnyArrayIncremental(
+	    UObject& WorldContextObject, void* TargetArray,
+	    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+	    float TimeBudgetMilliseconds, int32 ComparisonBudget,
+	    const FLatentActionInfo& LatentInfo);
 
-		// get pointer to read array
-		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+	/**
+	 * Sort an array by the value of a property of the elements.
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param PropertyPath
+	 *    The names of the properties to sort by, separated by '.'. If empty,
+	 *    the elements themselves are sorted.
+	 * @param bDescending  If true, sort in descending order.
+	 */
+	static void GenericSortByProperty(void*                 TargetArray,
+	                                  const FArrayProperty& ArrayProperty,
+	                                  const FString&        PropertyPath,
+	                                  bool                  bDescending);
 
-		// get property of read array
-		FArrayProperty* TargetArrayProperty =
-		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+	/**
+	 * Sort an array stably according to the order of the specified comparison
+	 * function.
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Object  An object for which the binary comparison function is
+	 *                defined.
+	 * @param ComparisonFunction
+	 *    A comparison function used to specify if one element should
+	 *    precede another. This must be a function that has two arguments of the
+	 *    same type as the array elements and returns a bool. You should return
+	 *    true if the first argument should precede the second; otherwise,
+	 *    return false.
+	 * @param bAdaptive  If true, already sorted runs are detected and reused.
+	 */
+	static void GenericStableSortAnyArray(void*                 TargetArray,
+	                                      const FArrayProperty& ArrayProperty,
+	                                      UObject&              Object,
+	                                      UFunction&            ComparisonFunction,
+	                                      bool                  bAdaptive);
 
-		// if failed to read an array
-		if (!TargetArrayProperty) {
-			// notify that failed
-			Stack.bArrayContextFailed = true;
+	/**
+	 * Computes the sum of the elements of a numeric array.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param[out] OutSum  pointer to a value of the element type to set
+	 * @return
+	 *    false if the type of the elements is not supported (an error is
+	 *    logged).
+	 */
+	static bool GenericSum(const void*           TargetArray,
+	                       const FArrayProperty& ArrayProperty, void* OutSum);
 
-			// finish
+	/**
+	 * Removes elements from the array that satisfy the specified predicate,
+	 * without keeping the order of the remaining elements.
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Object  An object for which the unary predicate function is
+	 *                defined.
+	 * @param Predicate
+	 *    A unary predicate function that defines whether the element
+	 *    satisfies the condition. This must be a function that has one argument
+	 *    of the same type as the array elements and returns a bool. If the
+	 *    element is considered to meet your intended condition, return true;
+	 *    otherwise, return false.
+	 */
+	static void GenericUnstableRemoveIf(void*                 TargetArray,
+	                                    const FArrayProperty& ArrayProperty,
+	                                    UObject& Object, UFunction& Predicate);
+
+	/**
+	 * Randomly select samples from an array, with the probability of each
+	 * element proportional to its weight. Samples are drawn with replacement
+	 * from an alias table, and without replacement by Efraimidis-Spirakis
+	 * sampling with exponential jumps (A-ExpJ).
+	 * @param TargetArray  target array
+	 * @param ArrayProperty  property of TargetArray and Samples
+	 * @param Weights
+	 *    the weights of the elements. If empty, they are read from
+	 *    WeightPropertyPath.
+	 * @param WeightPropertyPath  path of a numeric property of the elements
+	 * @param NumOfSamples
+	 *    number of samples to randomly select. Without replacement, clamped to
+	 *    the number of elements with positive weights.
+	 * @param bWithReplacement  whether an element can be selected several times
+	 * @param Engine  the random number generator to draw from
+	 * @param AliasTable
+	 *    an alias table to reuse when drawing with replacement (can be null)
+	 * @param[out] Samples  array to store the randomly selected samples
+	 * @return
+	 *    false if the weights can't be read, or their number differs from the
+	 *    length of TargetArray (an error is logged).
+	 */
+	static bool GenericWeightedRandomSample(
+	    const void* TargetArray, const FArrayProperty& ArrayProperty,
+	    TArrayView<const double> Weights, const FString& WeightPropertyPath,
+	    int32 NumOfSamples, bool bWithReplacement, udon::FRandomEngine& Engine,
+	    UUdonAliasTable* AliasTable, void* Samples);
+
+	/**
+	 * Finds a function to be used as a predicate or comparison function.
+	 * Lookups are cached per class of Object, so repeated calls with the same
+	 * name don't search the class again.
+	 * @param Object  An object for which the function is defined.
+	 * @param FunctionName  name of the function
+	 * @return  The function. If not found, returns nullptr.
+	 */
+	static UFunction* FindPredicateFunction(const UObject& Object,
+	                                        const FName&   FunctionName);
+
+	// async
+public:
+	/**
+	 * Counts the elements of the array that satisfy the specified predicate on
+	 * a background thread. The elements are copied when the node is executed,
+	 * so arrays of elements holding object references are not supported.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  target array
+	 * @param PredicateName
+	 *    The name of a unary native predicate registered as thread-safe for the
+	 *    type of the elements. Blueprint functions can't be used, because they
+	 *    must run on the game thread.
+	 * @param[out] Count  the number of elements that satisfy the predicate
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext = "WorldContextObject",
+	                  ArrayParm = "TargetArray", AutoCreateRefTerm = "PredicateName",
+	                  KeyWords = "async background thread count if predicate"))
+	static void AsyncCountIf(UObject*                   WorldContextObject,
+	                         const TArray<int32>&       TargetArray,
+	                         const FName&               PredicateName,
+	                         int32&                     Count,
+	                         FLatentActionInfo LatentInfo);
+
+	/**
+	 * Randomly select the specified number of samples from the target array on
+	 * a background thread. The elements are copied when the node is executed,
+	 * so arrays of elements holding object references are not supported.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  target array
+	 * @param NumOfSamples  number of samples to randomly select
+	 * @param RandomStream
+	 *    The random stream to draw from. It is advanced when the node is
+	 *    executed, so the result is reproducible from its seed. If not given,
+	 *    a generator of the game thread is used.
+	 * @param[out] Samples  output array to store the randomly selected samples
+	 * @param[out] Others output array to store the remaining elements
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext = "WorldContextObject",
+	                  AdvancedDisplay          = "RandomStream,Others",
+	                  ArrayParm                = "TargetArray,Samples,Others",
+	                  ArrayTypeDependentParams = "TargetArray,Samples,Others",
+	                  NumOfSamples             = 1,
+	                  KeyWords = "async background thread random sample items"))
+	static void AsyncRandomSample(UObject*             WorldContextObject,
+	                              const TArray<int32>& TargetArray,
+	                              int32                NumOfSamples,
+	                              UUdonRandomStream*   RandomStream,
+	                              TArray<int32>& Samples, TArray<int32>& Others,
+	                              FLatentActionInfo LatentInfo);
+
+	/**
+	 * Removes elements from the array that satisfy the specified predicate on
+	 * a background thread. The elements are copied when the node is executed,
+	 * and the remaining elements replace TargetArray when the work is
+	 * finished. Changes made to TargetArray in the meantime are discarded. If
+	 * the object that owns TargetArray is destroyed first, the node finishes
+	 * without triggering its output. Arrays of elements holding object
+	 * references are not supported.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  target array
+	 * @param PredicateName
+	 *    The name of a unary native predicate registered as thread-safe for the
+	 *    type of the elements. Blueprint functions can't be used, because they
+	 *    must run on the game thread.
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext = "WorldContextObject",
+	                  ArrayParm = "TargetArray", AutoCreateRefTerm = "PredicateName",
+	                  KeyWords = "async background thread remove if predicate"))
+	static void AsyncRemoveIf(UObject*                   WorldContextObject,
+	                          UPARAM(ref) TArray<int32>& TargetArray,
+	                          const FName&               PredicateName,
+	                          FLatentActionInfo          LatentInfo);
+
+	/**
+	 * Sort an array of any type on a background thread. The elements are
+	 * copied when the node is executed, and the sorted elements replace
+	 * TargetArray when the sort is finished. Changes made to TargetArray in the
+	 * meantime are discarded. If the object that owns TargetArray is destroyed
+	 * first, the node finishes without triggering its output. Elements that are
+	 * equivalent keep their order. Arrays of elements holding object
+	 * references are not supported.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  sort target array
+	 * @param ComparisonFunctionName
+	 *    The name of a binary native predicate registered as thread-safe for
+	 *    the type of the elements, which returns true if the first argument
+	 *    should precede the second. Blueprint functions can't be used, because
+	 *    they must run on the game thread. If None, the elements are sorted in
+	 *    ascending order of their values.
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext      = "WorldContextObject",
+	                  ArrayParm         = "TargetArray",
+	                  AutoCreateRefTerm = "ComparisonFunctionName",
+	                  KeyWords = "async background thread sort order arrange "
+	                             "compare comparison"))
+	static void AsyncSortAnyArray(UObject*                   WorldContextObject,
+	                              UPARAM(ref) TArray<int32>& TargetArray,
+	                              const FName&      ComparisonFunctionName,
+	                              FLatentActionInfo LatentInfo);
+
+	/**
+	 * Sort an array by the value of a property of the elements on a
+	 * background thread. The elements are copied when the node is executed,
+	 * and the sorted elements replace TargetArray when the sort is finished.
+	 * Changes made to TargetArray in the meantime are discarded. If the object
+	 * that owns TargetArray is destroyed first, the node finishes without
+	 * triggering its output. Elements with equal keys keep their order. Arrays
+	 * of elements holding object references are not supported.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  sort target array
+	 * @param PropertyPath
+	 *    The names of the properties to sort by, separated by '.' (see
+	 *    SortByProperty). Text properties can't be used, because texts are
+	 *    compared on the game thread.
+	 * @param bDescending  If true, sort in descending order.
+	 * @param LatentInfo  latent action info
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async", CustomThunk,
+	          meta = (Latent, LatentInfo = "LatentInfo",
+	                  WorldContext = "WorldContextObject",
+	                  ArrayParm    = "TargetArray",
+	                  KeyWords = "async background thread sort order arrange "
+	                             "property member field key"))
+	static void AsyncSortByProperty(UObject* WorldContextObject,
+	                                UPARAM(ref) TArray<int32>& TargetArray,
+	                                const FString&             PropertyPath,
+	                                bool                       bDescending,
+	                                FLatentActionInfo          LatentInfo);
+
+	/**
+	 * Cancels the async array nodes started by the object. Cancelled nodes
+	 * don't modify their arrays and don't trigger their outputs.
+	 * @param Object  the object that started the nodes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Array|Async",
+	          meta = (DefaultToSelf = "Object",
+	                  KeyWords      = "async cancel stop abort"))
+	static void CancelAsyncArrayOperations(UObject* Object);
+
+public:
+	/**
+	 * Starts counting the elements of an array that satisfy a predicate on a
+	 * background thread.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param Predicate  a unary native predicate registered as thread-safe
+	 * @param[out] Count  set to the count on completion
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericAsyncCountIf(UObject&                    WorldContextObject,
+	                                const void*                 TargetArray,
+	                                const FArrayProperty&       ArrayProperty,
+	                                const FUdonNativePredicate& Predicate,
+	                                int32&                      Count,
+	                                const FLatentActionInfo&    LatentInfo);
+
+	/**
+	 * Starts selecting random samples from an array on a background thread.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to target array
+	 * @param ArrayProperty  property of TargetArray, Samples and Others
+	 * @param NumOfSamples  number of samples to randomly select
+	 * @param Engine
+	 *    The random number generator to draw from. It is used only to seed the
+	 *    generator of the background work.
+	 * @param[out] Samples  set to the samples on completion
+	 * @param[out] Others  set to the remaining elements on completion
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericAsyncRandomSample(UObject&              WorldContextObject,
+	                                     const void*           TargetArray,
+	                                     const FArrayProperty& ArrayProperty,
+	                                     int32                 NumOfSamples,
+	                                     udon::FRandomEngine&  Engine,
+	                                     void* Samples, void* Others,
+	                                     const FLatentActionInfo& LatentInfo);
+
+	/**
+	 * Starts removing the elements of an array that satisfy a predicate on a
+	 * background thread.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray (see FindArrayOwner). If it is
+	 *    destroyed, the node finishes without modifying TargetArray.
+	 * @param Predicate  a unary native predicate registered as thread-safe
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericAsyncRemoveIf(UObject&                    WorldContextObject,
+	                                 void*                       TargetArray,
+	                                 const FArrayProperty&       ArrayProperty,
+	                                 UObject&                    TargetArrayOwner,
+	                                 const FUdonNativePredicate& Predicate,
+	                                 const FLatentActionInfo&    LatentInfo);
+
+	/**
+	 * Starts sorting an array stably on a background thread.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray (see FindArrayOwner). If it is
+	 *    destroyed, the node finishes without modifying TargetArray.
+	 * @param ComparisonFunction
+	 *    a binary native predicate registered as thread-safe
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericAsyncSortAnyArray(
+	    UObject& WorldContextObject, void* TargetArray,
+	    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+	    const FUdonNativePredicate& ComparisonFunction,
+	    const FLatentActionInfo&    LatentInfo);
+
+	/**
+	 * Starts sorting an array by the value of a property of the elements on a
+	 * background thread.
+	 * @param WorldContextObject  world context
+	 * @param TargetArray  pointer to sort target array
+	 * @param ArrayProperty  property of TargetArray
+	 * @param TargetArrayOwner
+	 *    The object that owns TargetArray (see FindArrayOwner). If it is
+	 *    destroyed, the node finishes without modifying TargetArray.
+	 * @param PropertyPath
+	 *    The names of the properties to sort by, separated by '.'. If empty,
+	 *    the elements themselves are sorted.
+	 * @param bDescending  If true, sort in descending order.
+	 * @param LatentInfo  latent action info
+	 */
+	static void GenericAsyncSortByProperty(UObject&              WorldContextObject,
+	                                       void*                 TargetArray,
+	                                       const FArrayProperty& ArrayProperty,
+	                                       UObject&              TargetArrayOwner,
+	                                       const FString&        PropertyPath,
+	                                       bool                  bDescending,
+	                                       const FLatentActionInfo& LatentInfo);
+
+	/**
+	 * Finds the object that owns an array read from a Blueprint stack: the
+	 * object of which the array is a member variable, or the object running
+	 * the event graph of which the array is a local variable. Must be called
+	 * right after the array is read. If not found, an error is logged.
+	 * @param Stack  the stack the array was read from
+	 * @param ArrayAddr  pointer to the array
+	 * @param ArrayProperty  property of the array
+	 * @param OperationName  name of the node, used in the error message
+	 * @return  The owner. If not found, returns nullptr.
+	 */
+	static UObject* FindArrayOwner(const FFrame& Stack, const void* ArrayAddr,
+	                               const FArrayProperty& ArrayProperty,
+	                               const TCHAR*          OperationName);
+
+	// native predicates
+public:
+	/**
+	 * Registers a C++ predicate under Name. Array nodes given Name as the
+	 * predicate or comparison function name call it directly, instead of
+	 * a function with the same name on Object, when the array elements are of
+	 * type T.
+	 * @tparam T  type of the array elements
+	 * @param Name  name used in place of a function name on the nodes
+	 * @param Callable
+	 *    bool(const T&) for a unary predicate, or bool(const T&, const T&) for
+	 *    a binary predicate or comparison function.
+	 * @param bThreadSafe
+	 *    If true, Callable may be called from worker threads in parallel on
+	 *    large arrays. Set this only if Callable doesn't touch shared state
+	 *    (including UObjects) that isn't safe to read concurrently.
+	 */
+	template <class T, class CallableT>
+	static void RegisterNativePredicate(const FName& Name, CallableT&& Callable,
+	                                    const bool bThreadSafe = false) {
+		using callable_t = std::decay_t<CallableT>;
+
+		FUdonNativePredicate Predicate;
+		Predicate.MatchesElementProperty = &udon::MatchesElementProperty<T>;
+		Predicate.bThreadSafe            = bThreadSafe;
+
+		// if Callable is a binary predicate
+		if constexpr (std::is_invocable_r_v<bool, const callable_t&, const T&,
+		                                    const T&>) {
+			Predicate.NumArguments = 2;
+			Predicate.Binary = [Callable = Forward<CallableT>(Callable)](
+			                       const void* const A, const void* const B) {
+				return Callable(*static_cast<const T*>(A),
+				                *static_cast<const T*>(B));
+			};
+		}
+		// otherwise, Callable must be a unary predicate
+		else {
+			static_assert(
+			    std::is_invocable_r_v<bool, const callable_t&, const T&>,
+			    "Callable must be bool(const T&) or bool(const T&, const T&)");
+
+			Predicate.NumArguments = 1;
+			Predicate.Unary = [Callable = Forward<CallableT>(Callable)](
+			                      const void* const A) {
+				return Callable(*static_cast<const T*>(A));
+			};
+		}
+
+		AddNativePredicate(Name, MoveTemp(Predicate));
+	}
+
+	/**
+	 * Registers a type-erased native predicate under Name. A predicate
+	 * previously registered under Name for the same element type and number of
+	 * arguments is replaced.
+	 * @param Name  name used in place of a function name on the nodes
+	 * @param Predicate  the predicate
+	 */
+	static void AddNativePredicate(const FName&           Name,
+	                               FUdonNativePredicate&& Predicate);
+
+	/**
+	 * Unregisters all native predicates registered under Name.
+	 * @param Name  name of the predicates
+	 */
+	static void UnregisterNativePredicate(const FName& Name);
+
+	/**
+	 * Finds a native predicate registered under Name for the element type.
+	 * @param Name  name of the predicate
+	 * @param ElementProperty  property of the array elements
+	 * @param NumArguments  number of elements passed at once
+	 * @return  The predicate. If not registered, returns nullptr.
+	 */
+	static TSharedPtr<const FUdonNativePredicate>
+	    FindNativePredicate(const FName& Name, const FProperty& ElementProperty,
+	                        int32 NumArguments);
+
+	/**
+	 * Finds a native predicate registered under Name for the element type, that
+	 * can be called on background threads. If not registered or not
+	 * thread-safe, an error is logged.
+	 * @param Name  name of the predicate
+	 * @param ElementProperty  property of the array elements
+	 * @param NumArguments  number of elements passed at once
+	 * @return  The predicate. If not found, returns nullptr.
+	 */
+	static TSharedPtr<const FUdonNativePredicate>
+	    FindThreadSafeNativePredicate(const FName&     Name,
+	                                  const FProperty& ElementProperty,
+	                                  int32            NumArguments);
+
+public:
+	/**
+	 * GenericAdjacentFind with a registered binary native predicate.
+	 */
+	static int32 GenericAdjacentFind(const void*                 TargetArray,
+	                                 const FArrayProperty&       ArrayProperty,
+	                                 const FUdonNativePredicate& BinaryPredicate);
+
+	/**
+	 * GenericAllSatisfy with a registered unary native predicate.
+	 */
+	static bool GenericAllSatisfy(const void*                 TargetArray,
+	                              const FArrayProperty&       ArrayProperty,
+	                              const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericAnySatisfy with a registered unary native predicate.
+	 */
+	static bool GenericAnySatisfy(const void*                 TargetArray,
+	                              const FArrayProperty&       ArrayProperty,
+	                              const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericCountIf with a registered unary native predicate.
+	 */
+	static int32 GenericCountIf(const void*                 TargetArray,
+	                            const FArrayProperty&       ArrayProperty,
+	                            const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericFindIf with a registered unary native predicate.
+	 */
+	static int32 GenericFindIf(const void*                 TargetArray,
+	                           const FArrayProperty&       ArrayProperty,
+	                           const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericGetSortedIndices with a registered native comparison function.
+	 */
+	static TArray<int32>
+	    GenericGetSortedIndices(const void*                 TargetArray,
+	                            const FArrayProperty&       ArrayProperty,
+	                            const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericMax with a registered native comparison function.
+	 */
+	static const void* GenericMax(const void*                 TargetArray,
+	                              const FArrayProperty&       ArrayProperty,
+	                              const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericMaxElementIndex with a registered native comparison function.
+	 */
+	static int32
+	    GenericMaxElementIndex(const void*                 TargetArray,
+	                           const FArrayProperty&       ArrayProperty,
+	                           const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericMin with a registered native comparison function.
+	 */
+	static const void* GenericMin(const void*                 TargetArray,
+	                              const FArrayProperty&       ArrayProperty,
+	                              const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericMinElementIndex with a registered native comparison function.
+	 */
+	static int32
+	    GenericMinElementIndex(const void*                 TargetArray,
+	                           const FArrayProperty&       ArrayProperty,
+	                           const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericNoneSatisfy with a registered unary native predicate.
+	 */
+	static bool GenericNoneSatisfy(const void*                 TargetArray,
+	                               const FArrayProperty&       ArrayProperty,
+	                               const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericRemoveIf with a registered unary native predicate.
+	 */
+	static void GenericRemoveIf(void*                       TargetArray,
+	                            const FArrayProperty&       ArrayProperty,
+	                            const FUdonNativePredicate& Predicate);
+
+	/**
+	 * GenericSortAnyArray with a registered native comparison function.
+	 */
+	static void
+	    GenericSortAnyArray(void*                       TargetArray,
+	                        const FArrayProperty&       ArrayProperty,
+	                        const FUdonNativePredicate& ComparisonFunction);
+
+	/**
+	 * GenericSortAnyArrayIncremental with a registered native comparison
+	 * function.
+	 */
+	static void GenericSortAnyArrayIncremental(
+	    UObject& WorldContextObject, void* TargetArray,
+	    const FArrayProperty& ArrayProperty, UObject& TargetArrayOwner,
+	    const FUdonNativePredicate& ComparisonFunction,
+	    float TimeBudgetMilliseconds, int32 ComparisonBudget,
+	    const FLatentActionInfo& LatentInfo);
+
+	/**
+	 * GenericStableSortAnyArray with a registered native comparison function.
+	 */
+	static void
+	    GenericStableSortAnyArray(void*                       TargetArray,
+	                              const FArrayProperty&       ArrayProperty,
+	                              const FUdonNativePredicate& ComparisonFunction,
+	                              bool                        bAdaptive);
+
+	/**
+	 * GenericUnstableRemoveIf with a registered unary native predicate.
+	 */
+	static void GenericUnstableRemoveIf(void*                       TargetArray,
+	                                    const FArrayProperty&       ArrayProperty,
+	                                    const FUdonNativePredicate& Predicate);
+
+public:
+	DECLARE_FUNCTION(execAdjacentFind) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
 			return;
 		}
 
@@ -712,8 +1893,20 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under BinaryPredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        BinaryPredicateName, *TargetArrayProperty->Inner, 2)) {
+			// Perform the adjacent find
+			*static_cast<int32*>(RESULT_PARAM) = GenericAdjacentFind(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get BinaryPredicate on Object
-		const auto& BinaryPredicate = Object->FindFunction(BinaryPredicateName);
+		const auto& BinaryPredicate =
+		    FindPredicateFunction(*Object, BinaryPredicateName);
 
 		// if binary predicate doesn't exist
 		if (!BinaryPredicate) {
@@ -777,8 +1970,19 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform the all_of
+			*static_cast<bool*>(RESULT_PARAM) = GenericAllSatisfy(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
 
 		// if predicate doesn't exist
 		if (!Predicate) {
@@ -842,8 +2046,19 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform the any_of
+			*static_cast<bool*>(RESULT_PARAM) = GenericAnySatisfy(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
 
 		// if predicate doesn't exist
 		if (!Predicate) {
@@ -864,6 +2079,65 @@ public:
 		P_NATIVE_END;
 	}
 
+	DECLARE_FUNCTION(execAverage) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		///////////////////////////////
+		// read argument 1 (Average) //
+		///////////////////////////////
+		// Since Average isn't really an int, step the stack manually
+
+		// reset MostRecentPropertyAddress
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		// read a value from Stack
+		Stack.StepCompiledIn<FProperty>(nullptr);
+
+		// get pointer to average value ref
+		auto* const OutAverage = Stack.MostRecentPropertyAddress;
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// compute the average into a value of the element type
+		alignas(16) uint8 Result[sizeof(FVector)];
+		if (GenericAverage(TargetArrayAddr, *TargetArrayProperty, Result)) {
+			// copy the result to the Average pin
+			TargetArrayProperty->Inner->CopySingleValueToScriptVM(OutAverage,
+			                                                      Result);
+		}
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
 	DECLARE_FUNCTION(execCount) {
 		///////////////////////////////////
 		// read argument 0 (TargetArray) //
@@ -962,8 +2236,19 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform the count_if
+			*static_cast<int32*>(RESULT_PARAM) = GenericCountIf(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
 
 		// if predicate doesn't exist
 		if (!Predicate) {
@@ -984,10 +2269,10 @@ public:
 		P_NATIVE_END;
 	}
 
-	DECLARE_FUNCTION(execFill) {
-		///////////////////////////////////
-		// read argument 0 (TargetArray) //
-		///////////////////////////////////
+	DECLARE_FUNCTION(execDotProduct) {
+		/////////////////////////
+		// read argument 0 (A) //
+		/////////////////////////
 
 		// reset MostRecentProperty
 		Stack.MostRecentProperty = nullptr;
@@ -996,14 +2281,14 @@ public:
 		Stack.StepCompiledIn<FArrayProperty>(nullptr);
 
 		// get pointer to read array
-		void* const TargetArrayAddr = Stack.MostRecentPropertyAddress;
+		const void* AAddr = Stack.MostRecentPropertyAddress;
 
 		// get property of read array
-		FArrayProperty* TargetArrayProperty =
+		FArrayProperty* AProperty =
 		    CastField<FArrayProperty>(Stack.MostRecentProperty);
 
 		// if failed to read an array
-		if (!TargetArrayProperty) {
+		if (!AProperty) {
 			// notify that failed
 			Stack.bArrayContextFailed = true;
 
@@ -1011,10 +2296,78 @@ public:
 			return;
 		}
 
-		/////////////////////////////
-		// read argument 1 (Value) //
-		/////////////////////////////
-		// Since Value isn't really an int, step the stack manually
+		/////////////////////////
+		// read argument 1 (B) //
+		/////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* BAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* BProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!BProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// compute the dot product (0 if failed)
+		auto Result = 0.0;
+		GenericDotProduct(AAddr, BAddr, *AProperty, Result);
+		*static_cast<double*>(RESULT_PARAM) = Result;
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execFill) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* const TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		/////////////////////////////
+		// read argument 1 (Value) //
+		/////////////////////////////
+		// Since Value isn't really an int, step the stack manually
 
 		// reset MostRecentPropertyAddress
 		Stack.MostRecentPropertyAddress = nullptr;
@@ -1148,8 +2501,19 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform the find_if
+			*static_cast<int32*>(RESULT_PARAM) = GenericFindIf(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
 
 		// if predicate doesn't exist
 		if (!Predicate) {
@@ -1170,6 +2534,93 @@ public:
 		P_NATIVE_END;
 	}
 
+	DECLARE_FUNCTION(execGetSortedIndices) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////
+		// read argument 1 (Object) //
+		//////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, Object);
+
+		//////////////////////////////////////////////
+		// read argument 2 (ComparisonFunctionName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, ComparisonFunctionName);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// get the indices sorted by the values of the elements
+			*static_cast<TArray<int32>*>(RESULT_PARAM) =
+			    GenericGetSortedIndices(TargetArrayAddr, *TargetArrayProperty);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// get the sorted indices
+			*static_cast<TArray<int32>*>(RESULT_PARAM) = GenericGetSortedIndices(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
+		// get ComparisonFunction on Object
+		const auto& ComparisonFunction =
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
+
+		// if ComparisonFunction doesn't exist
+		if (!ComparisonFunction) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("ComparisonFunction '%s' not found on object: %s"),
+			       *ComparisonFunctionName.ToString(), *Object->GetName());
+
+			// finish
+			return;
+		}
+
+		// get the sorted indices
+		*static_cast<TArray<int32>*>(RESULT_PARAM) = GenericGetSortedIndices(
+		    TargetArrayAddr, *TargetArrayProperty, *Object, *ComparisonFunction);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
 	DECLARE_FUNCTION(execMax) {
 		///////////////////////////////////
 		// read argument 0 (TargetArray) //
@@ -1227,9 +2678,45 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// get max by the values of the elements
+			const auto* const MaxElementPtr =
+			    GenericMax(TargetArrayAddr, *TargetArrayProperty,
+			               EUdonNaturalOrder::CaseInsensitive);
+
+			// if max element exists (i.e. array is not empty)
+			if (MaxElementPtr) {
+				// copy the result to the MaxValue pin
+				TargetArrayProperty->Inner->CopySingleValueToScriptVM(
+				    OutMaxValue, MaxElementPtr);
+			}
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// get max
+			const auto* const MaxElementPtr = GenericMax(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// if max element exists (i.e. array is not empty)
+			if (MaxElementPtr) {
+				// copy the result to the MaxValue pin
+				TargetArrayProperty->Inner->CopySingleValueToScriptVM(OutMaxValue,
+				                                                      MaxElementPtr);
+			}
+
+			// finish
+			return;
+		}
+
 		// get ComparisonFunction on Object
 		const auto& ComparisonFunction =
-		    Object->FindFunction(ComparisonFunctionName);
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
 
 		// if ComparisonFunction doesn't exist
 		if (!ComparisonFunction) {
@@ -1302,9 +2789,31 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// get max by the values of the elements
+			*static_cast<int32*>(RESULT_PARAM) =
+			    GenericMaxElementIndex(TargetArrayAddr, *TargetArrayProperty,
+			                           EUdonNaturalOrder::CaseInsensitive);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// get max
+			*static_cast<int32*>(RESULT_PARAM) = GenericMaxElementIndex(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get ComparisonFunction on Object
 		const auto& ComparisonFunction =
-		    Object->FindFunction(ComparisonFunctionName);
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
 
 		// if ComparisonFunction doesn't exist
 		if (!ComparisonFunction) {
@@ -1382,9 +2891,45 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// get min by the values of the elements
+			const auto* const MinElementPtr =
+			    GenericMin(TargetArrayAddr, *TargetArrayProperty,
+			               EUdonNaturalOrder::CaseInsensitive);
+
+			// if min element exists (i.e. array is not empty)
+			if (MinElementPtr) {
+				// copy the result to the MinValue pin
+				TargetArrayProperty->Inner->CopySingleValueToScriptVM(
+				    OutMinValue, MinElementPtr);
+			}
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// get min
+			const auto* const MinElementPtr = GenericMin(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// if min element exists (i.e. array is not empty)
+			if (MinElementPtr) {
+				// copy the result to the MinValue pin
+				TargetArrayProperty->Inner->CopySingleValueToScriptVM(OutMinValue,
+				                                                      MinElementPtr);
+			}
+
+			// finish
+			return;
+		}
+
 		// get ComparisonFunction on Object
 		const auto& ComparisonFunction =
-		    Object->FindFunction(ComparisonFunctionName);
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
 
 		// if ComparisonFunction doesn't exist
 		if (!ComparisonFunction) {
@@ -1457,9 +3002,31 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// get min by the values of the elements
+			*static_cast<int32*>(RESULT_PARAM) =
+			    GenericMinElementIndex(TargetArrayAddr, *TargetArrayProperty,
+			                           EUdonNaturalOrder::CaseInsensitive);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// get min
+			*static_cast<int32*>(RESULT_PARAM) = GenericMinElementIndex(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get ComparisonFunction on Object
 		const auto& ComparisonFunction =
-		    Object->FindFunction(ComparisonFunctionName);
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
 
 		// if ComparisonFunction doesn't exist
 		if (!ComparisonFunction) {
@@ -1480,7 +3047,7 @@ public:
 		P_NATIVE_END;
 	}
 
-	DECLARE_FUNCTION(execNoneSatisfy) {
+	DECLARE_FUNCTION(execMinMax) {
 		///////////////////////////////////
 		// read argument 0 (TargetArray) //
 		///////////////////////////////////
@@ -1507,15 +3074,43 @@ public:
 			return;
 		}
 
-		//////////////////////////////
-		// read argument 1 (Object) //
-		//////////////////////////////
-		P_GET_PROPERTY(FObjectProperty, Object);
+		////////////////////////////////
+		// read argument 1 (MinValue) //
+		////////////////////////////////
+		// Since MinValue isn't really an int, step the stack manually
 
-		//////////////////////////////////////////////
-		// read argument 2 (PredicateName) //
-		//////////////////////////////////////////////
-		P_GET_PROPERTY(FNameProperty, PredicateName);
+		// reset MostRecentPropertyAddress
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		// read a value from Stack
+		Stack.StepCompiledIn<FProperty>(nullptr);
+
+		// get pointer to min value ref
+		auto* const OutMinValue = Stack.MostRecentPropertyAddress;
+
+		////////////////////////////////
+		// read argument 2 (MaxValue) //
+		////////////////////////////////
+		// Since MaxValue isn't really an int, step the stack manually
+
+		// reset MostRecentPropertyAddress
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		// read a value from Stack
+		Stack.StepCompiledIn<FProperty>(nullptr);
+
+		// get pointer to max value ref
+		auto* const OutMaxValue = Stack.MostRecentPropertyAddress;
+
+		////////////////////////////////
+		// read argument 3 (MinIndex) //
+		////////////////////////////////
+		P_GET_PROPERTY_REF(FIntProperty, MinIndex);
+
+		////////////////////////////////
+		// read argument 4 (MaxIndex) //
+		////////////////////////////////
+		P_GET_PROPERTY_REF(FIntProperty, MaxIndex);
 
 		// end of reading arguments
 		P_FINISH;
@@ -1523,29 +3118,31 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
-		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
-
-		// if predicate doesn't exist
-		if (!Predicate) {
-			// output error
-			UE_LOG(LogUdonArrayUtilsLibrary, Error,
-			       TEXT("Predicate '%s' not found on object: %s"),
-			       *PredicateName.ToString(), *Object->GetName());
-
+		// find the indices of min and max
+		if (!GenericMinMax(TargetArrayAddr, *TargetArrayProperty, MinIndex,
+		                   MaxIndex)) {
 			// finish
 			return;
 		}
 
-		// Perform the none_of
-		*static_cast<bool*>(RESULT_PARAM) = GenericNoneSatisfy(
-		    TargetArrayAddr, *TargetArrayProperty, *Object, *Predicate);
+		// if min and max exist (i.e. array is not empty)
+		if (MinIndex != INDEX_NONE) {
+			// get array helper and element property
+			FScriptArrayHelper ArrayHelper(TargetArrayProperty, TargetArrayAddr);
+			const auto&        ElementProperty = TargetArrayProperty->Inner;
+
+			// copy the results to the MinValue and MaxValue pins
+			ElementProperty->CopySingleValueToScriptVM(
+			    OutMinValue, ArrayHelper.GetRawPtr(MinIndex));
+			ElementProperty->CopySingleValueToScriptVM(
+			    OutMaxValue, ArrayHelper.GetRawPtr(MaxIndex));
+		}
 
 		// end of native processing
 		P_NATIVE_END;
 	}
 
-	DECLARE_FUNCTION(execRemoveRange) {
+	DECLARE_FUNCTION(execNoneSatisfy) {
 		///////////////////////////////////
 		// read argument 0 (TargetArray) //
 		///////////////////////////////////
@@ -1557,7 +3154,7 @@ public:
 		Stack.StepCompiledIn<FArrayProperty>(nullptr);
 
 		// get pointer to read array
-		void* const TargetArrayAddr = Stack.MostRecentPropertyAddress;
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
 
 		// get property of read array
 		FArrayProperty* TargetArrayProperty =
@@ -1572,15 +3169,15 @@ public:
 			return;
 		}
 
-		//////////////////////////////////
-		// read argument 1 (StartIndex) //
-		//////////////////////////////////
-		P_GET_PROPERTY(FIntProperty, StartIndex);
+		//////////////////////////////
+		// read argument 1 (Object) //
+		//////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, Object);
 
-		////////////////////////////////
-		// read argument 2 (EndIndex) //
-		////////////////////////////////
-		P_GET_PROPERTY(FIntProperty, EndIndex);
+		//////////////////////////////////////////////
+		// read argument 2 (PredicateName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, PredicateName);
 
 		// end of reading arguments
 		P_FINISH;
@@ -1588,7 +3185,83 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
-		// Perform remove range
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform the none_of
+			*static_cast<bool*>(RESULT_PARAM) = GenericNoneSatisfy(
+			    TargetArrayAddr, *TargetArrayProperty, *NativePredicate);
+
+			// finish
+			return;
+		}
+
+		// get Predicate on Object
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
+
+		// if predicate doesn't exist
+		if (!Predicate) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Predicate '%s' not found on object: %s"),
+			       *PredicateName.ToString(), *Object->GetName());
+
+			// finish
+			return;
+		}
+
+		// Perform the none_of
+		*static_cast<bool*>(RESULT_PARAM) = GenericNoneSatisfy(
+		    TargetArrayAddr, *TargetArrayProperty, *Object, *Predicate);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execRemoveRange) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* const TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////////
+		// read argument 1 (StartIndex) //
+		//////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, StartIndex);
+
+		////////////////////////////////
+		// read argument 2 (EndIndex) //
+		////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, EndIndex);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// Perform remove range
 		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
 		GenericRemoveRange(TargetArrayAddr, *TargetArrayProperty, StartIndex,
 		                   EndIndex);
@@ -1640,8 +3313,20 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform remove_if
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericRemoveIf(TargetArrayAddr, *TargetArrayProperty,
+			                *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get Predicate on Object
-		const auto& Predicate = Object->FindFunction(PredicateName);
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
 
 		// if predicate doesn't exist
 		if (!Predicate) {
@@ -1694,8 +3379,13 @@ public:
 		////////////////////////////////////
 		P_GET_PROPERTY(FIntProperty, NumOfSamples);
 
+		////////////////////////////////////
+		// read argument 2 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
 		///////////////////////////////
-		// read argument 2 (Samples) //
+		// read argument 3 (Samples) //
 		///////////////////////////////
 
 		// reset MostRecentProperty
@@ -1720,9 +3410,9 @@ public:
 			return;
 		}
 
-		///////////////////////////////
-		// read argument 3 (Others) //
-		///////////////////////////////
+		//////////////////////////////
+		// read argument 4 (Others) //
+		//////////////////////////////
 
 		// reset MostRecentProperty
 		Stack.MostRecentProperty = nullptr;
@@ -1752,17 +3442,199 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
-		// get samples
-		const auto& [SamplesSharedPtr, OthersSharedPtr] = GenericRandomSample(
-		    TargetArrayAddr, *TargetArrayProperty, NumOfSamples);
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
+
+		// write samples and others directly to the Samples and Others pins
+		GenericRandomSample(TargetArrayAddr, *TargetArrayProperty, NumOfSamples,
+		                    SamplesAddr, OthersAddr, Engine);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execRandomSampleIndices) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		////////////////////////////////////
+		// read argument 1 (NumOfSamples) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, NumOfSamples);
+
+		////////////////////////////////////
+		// read argument 2 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
+
+		// select the indices
+		*static_cast<TArray<int32>*>(RESULT_PARAM) = GenericRandomSampleIndices(
+		    TargetArrayAddr, *TargetArrayProperty, NumOfSamples, Engine);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execRandomSampleSparse) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		////////////////////////////////////
+		// read argument 1 (NumOfSamples) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, NumOfSamples);
+
+		////////////////////////////////////
+		// read argument 2 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
+		///////////////////////////////
+		// read argument 3 (Samples) //
+		///////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to the array
+		void* SamplesAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of the array
+		FArrayProperty* SamplesProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read the array or the array is not same type as TargetArray
+		if (!SamplesProperty || !SamplesProperty->SameType(TargetArrayProperty)) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
+
+		// write only the samples to the Samples pin
+		GenericRandomSample(TargetArrayAddr, *TargetArrayProperty, NumOfSamples,
+		                    SamplesAddr, nullptr, Engine);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execShuffle) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		////////////////////////////////////
+		// read argument 1 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
 
-		// copy the result to the Samples pin
-		SamplesProperty->CopyCompleteValueToScriptVM(SamplesAddr,
-		                                             SamplesSharedPtr.get());
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
 
-		// copy the result to the Samples pin
-		SamplesProperty->CopyCompleteValueToScriptVM(OthersAddr,
-		                                             OthersSharedPtr.get());
+		// Perform the shuffle
+		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+		GenericShuffle(TargetArrayAddr, *TargetArrayProperty, Engine);
 
 		// end of native processing
 		P_NATIVE_END;
@@ -1811,9 +3683,32 @@ public:
 		// beginning of native processing
 		P_NATIVE_BEGIN;
 
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// sort the elements by their values
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericSortAnyArray(TargetArrayAddr, *TargetArrayProperty,
+			                    EUdonNaturalOrder::CaseInsensitive);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// Perform the sort
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericSortAnyArray(TargetArrayAddr, *TargetArrayProperty,
+			                    *NativePredicate);
+
+			// finish
+			return;
+		}
+
 		// get ComparisonFunction on Object
 		const auto& ComparisonFunction =
-		    Object->FindFunction(ComparisonFunctionName);
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
 
 		// if comparison function doesn't exist
 		if (!ComparisonFunction) {
@@ -1834,4 +3729,1049 @@ public:
 		// end of native processing
 		P_NATIVE_END;
 	}
+
+	DECLARE_FUNCTION(execSortAnyArrayIncremental) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// find the object that owns the read array
+		UObject* TargetArrayOwner =
+		    FindArrayOwner(Stack, TargetArrayAddr, *TargetArrayProperty,
+		                   TEXT("SortAnyArrayIncremental"));
+
+		//////////////////////////////
+		// read argument 2 (Object) //
+		//////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, Object);
+
+		//////////////////////////////////////////////
+		// read argument 3 (ComparisonFunctionName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, ComparisonFunctionName);
+
+		//////////////////////////////////////////////
+		// read argument 4 (TimeBudgetMilliseconds) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FFloatProperty, TimeBudgetMilliseconds);
+
+		////////////////////////////////////////
+		// read argument 5 (ComparisonBudget) //
+		////////////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, ComparisonBudget);
+
+		//////////////////////////////////
+		// read argument 6 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("SortAnyArrayIncremental needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// if the owner of the array isn't found
+		if (!TargetArrayOwner) {
+			// finish
+			return;
+		}
+
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// sort the elements by their values
+			GenericSortAnyArrayIncremental(
+			    *WorldContextObject, TargetArrayAddr, *TargetArrayProperty,
+			    *TargetArrayOwner, TimeBudgetMilliseconds, ComparisonBudget,
+			    LatentInfo);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// start the sort
+			GenericSortAnyArrayIncremental(
+			    *WorldContextObject, TargetArrayAddr, *TargetArrayProperty,
+			    *TargetArrayOwner, *NativePredicate, TimeBudgetMilliseconds,
+			    ComparisonBudget, LatentInfo);
+
+			// finish
+			return;
+		}
+
+		// get ComparisonFunction on Object
+		const auto& ComparisonFunction =
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
+
+		// if comparison function doesn't exist
+		if (!ComparisonFunction) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Comparison function '%s' not found on object: %s"),
+			       *ComparisonFunctionName.ToString(), *Object->GetName());
+
+			// finish
+			return;
+		}
+
+		// start the sort
+		GenericSortAnyArrayIncremental(
+		    *WorldContextObject, TargetArrayAddr, *TargetArrayProperty,
+		    *TargetArrayOwner, *Object, *ComparisonFunction,
+		    TimeBudgetMilliseconds, ComparisonBudget, LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execStableSortAnyArray) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////
+		// read argument 1 (Object) //
+		//////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, Object);
+
+		//////////////////////////////////////////////
+		// read argument 2 (ComparisonFunctionName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, ComparisonFunctionName);
+
+		/////////////////////////////////
+		// read argument 3 (bAdaptive) //
+		/////////////////////////////////
+		P_GET_UBOOL(bAdaptive);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// sort the elements by their values (this sort is stable)
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericSortAnyArray(TargetArrayAddr, *TargetArrayProperty,
+			                    EUdonNaturalOrder::CaseInsensitive);
+
+			// finish
+			return;
+		}
+
+		// if a native predicate is registered under ComparisonFunctionName
+		if (const auto NativePredicate = FindNativePredicate(
+		        ComparisonFunctionName, *TargetArrayProperty->Inner, 2)) {
+			// Perform the sort
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericStableSortAnyArray(TargetArrayAddr, *TargetArrayProperty,
+			                          *NativePredicate, bAdaptive);
+
+			// finish
+			return;
+		}
+
+		// get ComparisonFunction on Object
+		const auto& ComparisonFunction =
+		    FindPredicateFunction(*Object, ComparisonFunctionName);
+
+		// if comparison function doesn't exist
+		if (!ComparisonFunction) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Comparison function '%s' not found on object: %s"),
+			       *ComparisonFunctionName.ToString(), *Object->GetName());
+
+			// finish
+			return;
+		}
+
+		// Perform the sort
+		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+		GenericStableSortAnyArray(TargetArrayAddr, *TargetArrayProperty, *Object,
+		                          *ComparisonFunction, bAdaptive);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSortByProperty) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		////////////////////////////////////
+		// read argument 1 (PropertyPath) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FStrProperty, PropertyPath);
+
+		///////////////////////////////////
+		// read argument 2 (bDescending) //
+		///////////////////////////////////
+		P_GET_UBOOL(bDescending);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// Perform the sort
+		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+		GenericSortByProperty(TargetArrayAddr, *TargetArrayProperty, PropertyPath,
+		                      bDescending);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSortNatural) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		/////////////////////////////
+		// read argument 1 (Order) //
+		/////////////////////////////
+		P_GET_ENUM(EUdonNaturalOrder, Order);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// Perform the sort
+		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+		GenericSortAnyArray(TargetArrayAddr, *TargetArrayProperty, Order);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execSum) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		///////////////////////////
+		// read argument 1 (Sum) //
+		///////////////////////////
+		// Since Sum isn't really an int, step the stack manually
+
+		// reset MostRecentPropertyAddress
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		// read a value from Stack
+		Stack.StepCompiledIn<FProperty>(nullptr);
+
+		// get pointer to sum value ref
+		auto* const OutSum = Stack.MostRecentPropertyAddress;
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// compute the sum into a value of the element type
+		alignas(16) uint8 Result[sizeof(FVector)];
+		if (GenericSum(TargetArrayAddr, *TargetArrayProperty, Result)) {
+			// copy the result to the Sum pin
+			TargetArrayProperty->Inner->CopySingleValueToScriptVM(OutSum, Result);
+		}
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execUnstableRemoveIf) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////
+		// read argument 1 (Object) //
+		//////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, Object);
+
+		//////////////////////////////////////////////
+		// read argument 2 (PredicateName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, PredicateName);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if a native predicate is registered under PredicateName
+		if (const auto NativePredicate = FindNativePredicate(
+		        PredicateName, *TargetArrayProperty->Inner, 1)) {
+			// Perform remove_if
+			MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+			GenericUnstableRemoveIf(TargetArrayAddr, *TargetArrayProperty,
+			                        *NativePredicate);
+
+			// finish
+			return;
+		}
+
+		// get Predicate on Object
+		const auto& Predicate = FindPredicateFunction(*Object, PredicateName);
+
+		// if predicate doesn't exist
+		if (!Predicate) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("Predicate '%s' not found on object: %s"),
+			       *PredicateName.ToString(), *Object->GetName());
+
+			// finish
+			return;
+		}
+
+		// Perform remove_if
+		MARK_PROPERTY_DIRTY(Stack.Object, TargetArrayProperty);
+		GenericUnstableRemoveIf(TargetArrayAddr, *TargetArrayProperty, *Object,
+		                        *Predicate);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execWeightedRandomSample) {
+		///////////////////////////////////
+		// read argument 0 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		///////////////////////////////
+		// read argument 1 (Weights) //
+		///////////////////////////////
+		P_GET_TARRAY_REF(double, Weights);
+
+		//////////////////////////////////////////
+		// read argument 2 (WeightPropertyPath) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FStrProperty, WeightPropertyPath);
+
+		////////////////////////////////////
+		// read argument 3 (NumOfSamples) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, NumOfSamples);
+
+		////////////////////////////////////////
+		// read argument 4 (bWithReplacement) //
+		////////////////////////////////////////
+		P_GET_UBOOL(bWithReplacement);
+
+		////////////////////////////////////
+		// read argument 5 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
+		//////////////////////////////////
+		// read argument 6 (AliasTable) //
+		//////////////////////////////////
+		P_GET_OBJECT(UUdonAliasTable, AliasTable);
+
+		///////////////////////////////
+		// read argument 7 (Samples) //
+		///////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to the array
+		void* SamplesAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of the array
+		FArrayProperty* SamplesProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read the array or the array is not same type as TargetArray
+		if (!SamplesProperty || !SamplesProperty->SameType(TargetArrayProperty)) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
+
+		// write the samples directly to the Samples pin
+		GenericWeightedRandomSample(TargetArrayAddr, *TargetArrayProperty,
+		                            Weights, WeightPropertyPath, NumOfSamples,
+		                            bWithReplacement, Engine, AliasTable,
+		                            SamplesAddr);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execAsyncCountIf) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		/////////////////////////////////////
+		// read argument 2 (PredicateName) //
+		/////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, PredicateName);
+
+		/////////////////////////////
+		// read argument 3 (Count) //
+		/////////////////////////////
+		P_GET_PROPERTY_REF(FIntProperty, Count);
+
+		//////////////////////////////////
+		// read argument 4 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("AsyncCountIf needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// find a thread-safe native predicate registered under PredicateName
+		const auto Predicate = FindThreadSafeNativePredicate(
+		    PredicateName, *TargetArrayProperty->Inner, 1);
+
+		// if not found
+		if (!Predicate) {
+			// finish
+			return;
+		}
+
+		// start count_if
+		GenericAsyncCountIf(*WorldContextObject, TargetArrayAddr,
+		                    *TargetArrayProperty, *Predicate, Count, LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execAsyncRandomSample) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		const void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		////////////////////////////////////
+		// read argument 2 (NumOfSamples) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FIntProperty, NumOfSamples);
+
+		////////////////////////////////////
+		// read argument 3 (RandomStream) //
+		////////////////////////////////////
+		P_GET_OBJECT(UUdonRandomStream, RandomStream);
+
+		///////////////////////////////
+		// read argument 4 (Samples) //
+		///////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to the array
+		void* SamplesAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of the array
+		FArrayProperty* SamplesProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read the array or the array is not same type as TargetArray
+		if (!SamplesProperty || !SamplesProperty->SameType(TargetArrayProperty)) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////
+		// read argument 5 (Others) //
+		//////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to the array
+		void* OthersAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of the array
+		FArrayProperty* OthersProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read the array or the array is not same type as TargetArray
+		if (!OthersProperty || !OthersProperty->SameType(TargetArrayProperty)) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		//////////////////////////////////
+		// read argument 6 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("AsyncRandomSample needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// get the random number generator
+		auto& Engine = RandomStream ? RandomStream->GetEngine()
+		                            : udon::FRandomEngine::GetThreadDefault();
+
+		// start sampling
+		GenericAsyncRandomSample(*WorldContextObject, TargetArrayAddr,
+		                         *TargetArrayProperty, NumOfSamples, Engine,
+		                         SamplesAddr, OthersAddr, LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execAsyncRemoveIf) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// find the object that owns the read array
+		UObject* TargetArrayOwner = FindArrayOwner(
+		    Stack, TargetArrayAddr, *TargetArrayProperty, TEXT("AsyncRemoveIf"));
+
+		/////////////////////////////////////
+		// read argument 2 (PredicateName) //
+		/////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, PredicateName);
+
+		//////////////////////////////////
+		// read argument 3 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("AsyncRemoveIf needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// if the owner of the array isn't found
+		if (!TargetArrayOwner) {
+			// finish
+			return;
+		}
+
+		// find a thread-safe native predicate registered under PredicateName
+		const auto Predicate = FindThreadSafeNativePredicate(
+		    PredicateName, *TargetArrayProperty->Inner, 1);
+
+		// if not found
+		if (!Predicate) {
+			// finish
+			return;
+		}
+
+		// start remove_if
+		GenericAsyncRemoveIf(*WorldContextObject, TargetArrayAddr,
+		                     *TargetArrayProperty, *TargetArrayOwner, *Predicate,
+		                     LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execAsyncSortAnyArray) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// find the object that owns the read array
+		UObject* TargetArrayOwner =
+		    FindArrayOwner(Stack, TargetArrayAddr, *TargetArrayProperty,
+		                   TEXT("AsyncSortAnyArray"));
+
+		//////////////////////////////////////////////
+		// read argument 2 (ComparisonFunctionName) //
+		//////////////////////////////////////////////
+		P_GET_PROPERTY(FNameProperty, ComparisonFunctionName);
+
+		//////////////////////////////////
+		// read argument 3 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("AsyncSortAnyArray needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// if the owner of the array isn't found
+		if (!TargetArrayOwner) {
+			// finish
+			return;
+		}
+
+		// if no comparison function is specified
+		if (ComparisonFunctionName.IsNone()) {
+			// sort the elements by their values
+			GenericAsyncSortByProperty(*WorldContextObject, TargetArrayAddr,
+			                           *TargetArrayProperty, *TargetArrayOwner,
+			                           FString(), false, LatentInfo);
+
+			// finish
+			return;
+		}
+
+		// find a thread-safe native predicate registered under
+		// ComparisonFunctionName
+		const auto ComparisonFunction = FindThreadSafeNativePredicate(
+		    ComparisonFunctionName, *TargetArrayProperty->Inner, 2);
+
+		// if not found
+		if (!ComparisonFunction) {
+			// finish
+			return;
+		}
+
+		// start the sort
+		GenericAsyncSortAnyArray(*WorldContextObject, TargetArrayAddr,
+		                         *TargetArrayProperty, *TargetArrayOwner,
+		                         *ComparisonFunction, LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execAsyncSortByProperty) {
+		//////////////////////////////////////////
+		// read argument 0 (WorldContextObject) //
+		//////////////////////////////////////////
+		P_GET_PROPERTY(FObjectProperty, WorldContextObject);
+
+		///////////////////////////////////
+		// read argument 1 (TargetArray) //
+		///////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* TargetArrayAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* TargetArrayProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!TargetArrayProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		// find the object that owns the read array
+		UObject* TargetArrayOwner =
+		    FindArrayOwner(Stack, TargetArrayAddr, *TargetArrayProperty,
+		                   TEXT("AsyncSortByProperty"));
+
+		////////////////////////////////////
+		// read argument 2 (PropertyPath) //
+		////////////////////////////////////
+		P_GET_PROPERTY(FStrProperty, PropertyPath);
+
+		///////////////////////////////////
+		// read argument 3 (bDescending) //
+		///////////////////////////////////
+		P_GET_UBOOL(bDescending);
+
+		//////////////////////////////////
+		// read argument 4 (LatentInfo) //
+		//////////////////////////////////
+		P_GET_STRUCT(FLatentActionInfo, LatentInfo);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// if no world context is given
+		if (!WorldContextObject) {
+			// output error
+			UE_LOG(LogUdonArrayUtilsLibrary, Error,
+			       TEXT("AsyncSortByProperty needs a world context object."));
+
+			// finish
+			return;
+		}
+
+		// if the owner of the array isn't found
+		if (!TargetArrayOwner) {
+			// finish
+			return;
+		}
+
+		// start the sort
+		GenericAsyncSortByProperty(*WorldContextObject, TargetArrayAddr,
+		                           *TargetArrayProperty, *TargetArrayOwner,
+		                           PropertyPath, bDescending, LatentInfo);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
 };
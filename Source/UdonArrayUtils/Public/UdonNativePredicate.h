@@ -0,0 +1,117 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/UnrealType.h"
+
+#include <type_traits>
+
+/**
+ * A C++ predicate registered under a name. Array nodes call it directly
+ * instead of a UFunction with the same name.
+ */
+struct UDONARRAYUTILS_API FUdonNativePredicate {
+	// returns whether the registered element type matches ElementProperty
+	bool (*MatchesElementProperty)(const FProperty& ElementProperty) = nullptr;
+
+	// number of elements passed at once (1: unary, 2: binary)
+	int32 NumArguments = 0;
+
+	// whether the predicate may be called from several threads at once
+	bool bThreadSafe = false;
+
+	// unary predicate (valid if NumArguments is 1)
+	TFunction<bool(const void*)> Unary;
+
+	// binary predicate (valid if NumArguments is 2)
+	TFunction<bool(const void*, const void*)> Binary;
+};
+
+namespace udon {
+/**
+ * Detects USTRUCTs, which have StaticStruct().
+ */
+template <class T, class = void>
+struct THasStaticStruct: std::false_type {};
+template <class T>
+struct THasStaticStruct<T, std::void_t<decltype(T::StaticStruct())>>
+    : std::true_type {};
+
+/**
+ * Checks whether the values of ElementProperty are of type T.
+ */
+template <class T>
+bool MatchesElementProperty(const FProperty& ElementProperty) {
+	// the size must match in any case
+	const auto ElementSize =
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	    ElementProperty.ElementSize
+#else
+	    ElementProperty.GetElementSize()
+#endif
+	    ;
+	if (ElementSize != sizeof(T)) {
+		return false;
+	}
+
+	if constexpr (std::is_same_v<T, bool>) {
+		return ElementProperty.IsA<FBoolProperty>();
+	} else if constexpr (std::is_same_v<T, int8>) {
+		return ElementProperty.IsA<FInt8Property>();
+	} else if constexpr (std::is_same_v<T, int16>) {
+		return ElementProperty.IsA<FInt16Property>();
+	} else if constexpr (std::is_same_v<T, int32>) {
+		return ElementProperty.IsA<FIntProperty>();
+	} else if constexpr (std::is_same_v<T, int64>) {
+		return ElementProperty.IsA<FInt64Property>();
+	} else if constexpr (std::is_same_v<T, uint8>) {
+		return ElementProperty.IsA<FByteProperty>();
+	} else if constexpr (std::is_same_v<T, uint16>) {
+		return ElementProperty.IsA<FUInt16Property>();
+	} else if constexpr (std::is_same_v<T, uint32>) {
+		return ElementProperty.IsA<FUInt32Property>();
+	} else if constexpr (std::is_same_v<T, uint64>) {
+		return ElementProperty.IsA<FUInt64Property>();
+	} else if constexpr (std::is_same_v<T, float>) {
+		return ElementProperty.IsA<FFloatProperty>();
+	} else if constexpr (std::is_same_v<T, double>) {
+		return ElementProperty.IsA<FDoubleProperty>();
+	} else if constexpr (std::is_same_v<T, FName>) {
+		return ElementProperty.IsA<FNameProperty>();
+	} else if constexpr (std::is_same_v<T, FString>) {
+		return ElementProperty.IsA<FStrProperty>();
+	} else if constexpr (std::is_same_v<T, FText>) {
+		return ElementProperty.IsA<FTextProperty>();
+	} else if constexpr (std::is_enum_v<T>) {
+		// enum class or TEnumAsByte
+		if (const auto* const EnumProperty =
+		        CastField<FEnumProperty>(&ElementProperty)) {
+			return EnumProperty->GetEnum() == StaticEnum<T>();
+		}
+		if (const auto* const ByteProperty =
+		        CastField<FByteProperty>(&ElementProperty)) {
+			return ByteProperty->Enum == StaticEnum<T>();
+		}
+		return false;
+	} else if constexpr (std::is_pointer_v<T>) {
+		// UObject pointer (the elements must be T or derived from T)
+		const auto* const ObjectProperty =
+		    CastField<FObjectProperty>(&ElementProperty);
+		return ObjectProperty && ObjectProperty->PropertyClass &&
+		       ObjectProperty->PropertyClass->IsChildOf(
+		           std::remove_pointer_t<T>::StaticClass());
+	} else if constexpr (THasStaticStruct<T>::value) {
+		// USTRUCT
+		const auto* const StructProperty =
+		    CastField<FStructProperty>(&ElementProperty);
+		return StructProperty && StructProperty->Struct == T::StaticStruct();
+	} else {
+		// core structs such as FVector
+		const auto* const StructProperty =
+		    CastField<FStructProperty>(&ElementProperty);
+		return StructProperty && StructProperty->Struct == TBaseStructure<T>::Get();
+	}
+}
+} // namespace udon
@@ -0,0 +1,34 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UdonNaturalOrder.generated.h"
+
+/**
+ * How elements are ordered by their values when no comparison function is
+ * given. Numbers, bools and enums are always ordered by value, and texts by
+ * the current culture. The options differ only for strings and names.
+ */
+UENUM(BlueprintType)
+enum class EUdonNaturalOrder : uint8 {
+	/**
+	 * Strings and names are ordered alphabetically, ignoring case
+	 * (like "Less, Case Insensitive (String)").
+	 */
+	CaseInsensitive,
+
+	/**
+	 * Strings and names are ordered by their characters, respecting case
+	 * (like "Less Exactly (String)").
+	 */
+	CaseSensitive,
+
+	/**
+	 * Strings are ordered alphabetically, ignoring case. Names are ordered by
+	 * their indices in the name table, which is the fastest, but the order is
+	 * not alphabetical and may differ between runs.
+	 */
+	NameIndex,
+};
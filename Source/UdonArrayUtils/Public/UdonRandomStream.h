@@ -0,0 +1,159 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "UdonRandomStream.generated.h"
+
+namespace udon {
+/**
+ * A fast pseudo random number generator (xoshiro256**). The state is 32
+ * bytes, so it is cheap to create, copy and seed. Not thread-safe: use one
+ * engine per thread.
+ */
+class UDONARRAYUTILS_API FRandomEngine {
+public:
+	// constructor
+	explicit FRandomEngine(const uint64 Seed = 0) {
+		SetSeed(Seed);
+	}
+
+public:
+	/**
+	 * Resets the state from Seed. Engines with the same seed generate the same
+	 * sequence on every platform.
+	 */
+	void SetSeed(uint64 Seed);
+
+	// returns the next 64 random bits
+	uint64 Next() {
+		const auto Result = Rotl(State[1] * 5, 7) * 9;
+		const auto T      = State[1] << 17;
+
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= T;
+		State[3] = Rotl(State[3], 45);
+
+		return Result;
+	}
+
+	/**
+	 * Returns a uniformly distributed integer in [0, Bound) (0 if Bound is 0).
+	 * Uses Lemire's multiply-shift method, which needs no division except on
+	 * the rare rejection path.
+	 */
+	uint32 NextBelow(const uint32 Bound) {
+		auto Product = (Next() >> 32) * Bound;
+		auto Low     = static_cast<uint32>(Product);
+
+		// reject the values that would make the result biased
+		if (Low < Bound) {
+			const auto Threshold = (0u - Bound) % Bound;
+			while (Low < Threshold) {
+				Product = (Next() >> 32) * Bound;
+				Low     = static_cast<uint32>(Product);
+			}
+		}
+
+		return static_cast<uint32>(Product >> 32);
+	}
+
+	// returns a uniformly distributed number in [0, 1)
+	double NextDouble() {
+		return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+public:
+	/**
+	 * Returns the engine of the calling thread, seeded randomly the first time
+	 * it is used on the thread. Used when no random stream is given.
+	 */
+	static FRandomEngine& GetThreadDefault();
+
+private:
+	static uint64 Rotl(const uint64 X, const int32 K) {
+		return (X << K) | (X >> (64 - K));
+	}
+
+private:
+	uint64 State[4];
+};
+} // namespace udon
+
+/**
+ * A stream of pseudo random numbers that keeps its state across calls. Pass
+ * it to the random nodes of the array utilities to get results that are
+ * reproducible from a seed, for example for replays and lockstep simulations.
+ */
+UCLASS(BlueprintType)
+class UDONARRAYUTILS_API UUdonRandomStream: public UObject {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a random stream.
+	 * @param Seed  initial seed. The same seed gives the same sequence.
+	 * @return  the created random stream
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random",
+	          meta = (KeyWords = "random stream seed rng create"))
+	static UUdonRandomStream* CreateRandomStream(int64 Seed);
+
+	/**
+	 * Restarts the sequence from a new seed.
+	 * @param NewSeed  the seed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	void SetSeed(int64 NewSeed);
+
+	/**
+	 * Restarts the sequence from a seed chosen randomly.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	void SeedRandomly();
+
+	/**
+	 * Returns the seed the sequence was started from.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities|Random")
+	int64 GetSeed() const {
+		return Seed;
+	}
+
+	/**
+	 * Restarts the sequence from the current seed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	void Reset();
+
+	/**
+	 * Returns a uniformly distributed integer in [0, Max).
+	 * @param Max  the upper bound (exclusive). If not positive, returns 0.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	int32 RandomInteger(int32 Max);
+
+	/**
+	 * Returns a uniformly distributed number in [0, 1).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	double RandomFraction();
+
+public:
+	// get the engine generating the sequence
+	udon::FRandomEngine& GetEngine() {
+		return Engine;
+	}
+
+private:
+	// the seed the sequence was started from
+	int64 Seed = 0;
+
+	// the engine generating the sequence
+	udon::FRandomEngine Engine;
+};
@@ -0,0 +1,214 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "UObject/Object.h"
+#include "UObject/UnrealType.h"
+#include "UdonRandomStream.h"
+
+#include "UdonReservoirSampler.generated.h"
+
+/**
+ * Keeps a fixed number of random samples of a stream of elements whose total
+ * number is not known in advance, such as the events of a match, without
+ * storing all of them. The samples are kept in an array owned by the caller
+ * (the reservoir), which is allocated once with the capacity of the sampler,
+ * and elements are copied into its slots as they are selected.
+ * Unweighted samplers keep a uniform sample (Li's Algorithm L), and weighted
+ * samplers keep a sample like drawing the elements one by one without
+ * replacement with probabilities proportional to their weights
+ * (Efraimidis-Spirakis sampling with exponential jumps, A-ExpJ). In both, most
+ * elements are skipped without drawing a random number, so adding an element
+ * costs O(1) amortized.
+ */
+UCLASS(BlueprintType)
+class UDONARRAYUTILS_API UUdonReservoirSampler: public UObject {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a reservoir sampler.
+	 * @param Capacity  the number of samples to keep
+	 * @param bWeighted  whether the elements are selected by their weights
+	 * @param RandomStream
+	 *    The random stream to draw from. If not given, a generator of the
+	 *    calling thread is used.
+	 * @return  the created reservoir sampler
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random",
+	          meta = (AdvancedDisplay = "RandomStream",
+	                  KeyWords = "random sample reservoir stream create"))
+	static UUdonReservoirSampler* CreateReservoirSampler(
+	    int32 Capacity, bool bWeighted, UUdonRandomStream* RandomStream);
+
+	/**
+	 * Offers an element to the sampler. If it is selected, it is copied into
+	 * the reservoir, replacing a previous sample when the reservoir is full.
+	 * Pass the same reservoir to every call until the sampler is reset.
+	 * @param Reservoir
+	 *    the array keeping the samples. Emptied when the first element is
+	 *    added after creating or resetting the sampler.
+	 * @param Element  the element to offer
+	 * @param Weight
+	 *    The weight of the element, used only by weighted samplers. Elements
+	 *    with zero or negative weight are never selected.
+	 * @return  whether the element was copied into the reservoir.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random", CustomThunk,
+	          meta = (ArrayParm                = "Reservoir",
+	                  ArrayTypeDependentParams = "Element",
+	                  AutoCreateRefTerm = "Element", Weight = 1,
+	                  KeyWords = "random sample reservoir stream add"))
+	bool Add(UPARAM(ref) TArray<int32>& Reservoir, const int32& Element,
+	         double Weight);
+
+	/**
+	 * Forgets the elements added so far. The next added element empties the
+	 * reservoir.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities|Random")
+	void Reset();
+
+	/**
+	 * Returns the number of samples to keep.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities|Random")
+	int32 GetCapacity() const {
+		return Capacity;
+	}
+
+	/**
+	 * Returns the number of elements added since the sampler was created or
+	 * reset.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities|Random")
+	int64 GetNumAdded() const {
+		return NumAdded;
+	}
+
+public:
+	/**
+	 * Offers an element to the sampler.
+	 * @param Reservoir  pointer to the array keeping the samples
+	 * @param ReservoirProperty  property of Reservoir
+	 * @param Element  pointer to the element, of the type of the array elements
+	 * @param Weight  the weight of the element (for weighted samplers)
+	 * @return  whether the element was copied into the reservoir.
+	 */
+	bool GenericAdd(void* Reservoir, const FArrayProperty& ReservoirProperty,
+	                const void* Element, double Weight);
+
+private:
+	// get the random number generator
+	udon::FRandomEngine& GetEngine() const;
+
+	// draw the number of elements to skip before the next uniform replacement
+	void DrawUniformSkip(udon::FRandomEngine& Engine);
+
+	// draw the weight to skip before the next weighted replacement
+	void DrawWeightedSkip(udon::FRandomEngine& Engine);
+
+public:
+	DECLARE_FUNCTION(execAdd) {
+		/////////////////////////////////
+		// read argument 0 (Reservoir) //
+		/////////////////////////////////
+
+		// reset MostRecentProperty
+		Stack.MostRecentProperty = nullptr;
+
+		// read an array from Stack
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+
+		// get pointer to read array
+		void* const ReservoirAddr = Stack.MostRecentPropertyAddress;
+
+		// get property of read array
+		FArrayProperty* ReservoirProperty =
+		    CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		// if failed to read an array
+		if (!ReservoirProperty) {
+			// notify that failed
+			Stack.bArrayContextFailed = true;
+
+			// finish
+			return;
+		}
+
+		///////////////////////////////
+		// read argument 1 (Element) //
+		///////////////////////////////
+		// Since Element isn't really an int, step the stack manually
+
+		// reset MostRecentPropertyAddress
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		// read a value from Stack
+		Stack.StepCompiledIn<FProperty>(nullptr);
+
+		// get pointer to read value
+		const auto* const Element = Stack.MostRecentPropertyAddress;
+
+		//////////////////////////////
+		// read argument 2 (Weight) //
+		//////////////////////////////
+		P_GET_PROPERTY(FDoubleProperty, Weight);
+
+		// end of reading arguments
+		P_FINISH;
+
+		// beginning of native processing
+		P_NATIVE_BEGIN;
+
+		// offer the element
+		MARK_PROPERTY_DIRTY(Stack.Object, ReservoirProperty);
+		*static_cast<bool*>(RESULT_PARAM) =
+		    P_THIS->GenericAdd(ReservoirAddr, *ReservoirProperty, Element, Weight);
+
+		// end of native processing
+		P_NATIVE_END;
+	}
+
+private:
+	/**
+	 * A slot of the weighted reservoir, with the logarithm of the key of its
+	 * sample (log(U) / Weight for a uniform U). The reservoir keeps the
+	 * samples of the largest keys, so its heap has the smallest on top.
+	 */
+	struct FWeightedSlot {
+		double LogKey;
+		int32  Slot;
+
+		[[nodiscard]] bool operator<(const FWeightedSlot& Other) const noexcept {
+			return LogKey < Other.LogKey;
+		}
+	};
+
+	// the number of samples to keep
+	int32 Capacity = 0;
+
+	// whether the elements are selected by their weights
+	bool bWeighted = false;
+
+	// the random stream to draw from (null for the generator of the thread)
+	UPROPERTY()
+	TObjectPtr<UUdonRandomStream> RandomStream;
+
+	// the number of elements added since created or reset
+	int64 NumAdded = 0;
+
+	// uniform: the logarithm of W of Algorithm L
+	double LogW = 0.0;
+
+	// uniform: the number of elements to skip before the next replacement
+	int64 SkipCount = 0;
+
+	// weighted: the keys of the samples (a heap)
+	TArray<FWeightedSlot> Keys;
+
+	// weighted: the weight to skip before the next replacement
+	double SkipWeight = 0.0;
+};
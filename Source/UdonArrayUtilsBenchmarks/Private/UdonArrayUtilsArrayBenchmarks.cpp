@@ -0,0 +1,165 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+/**
+ * Measures the operations that take no predicate on arrays of Num elements of
+ * type T: counting, filling, removing, shuffling and sampling, and the
+ * numeric kernels for int32.
+ */
+template <class T>
+void MeasureArrayOperations(FAutomationTestBase& Test, FBenchmarkReport& Report,
+                            const int32 Num) {
+	using FElement = TBenchmarkElement<T>;
+
+	// the source and work arrays, and the samples and the others
+	const auto BytesPerElement =
+	    (sizeof(T) + FElement::HeapBytes) * 4 + sizeof(double);
+	if (!ShouldMeasure(Num, BytesPerElement, false)) {
+		Test.AddInfo(TEXT("Skipped: the arrays exceed the memory limit."));
+		return;
+	}
+
+	const TStrongObjectPtr<UUdonArrayUtilsBenchmarkFixture> Fixture(
+	    NewObject<UUdonArrayUtilsBenchmarkFixture>());
+	TBenchmarkArrays<T> Arrays(*Fixture, Num);
+	auto* const         Work          = &Arrays.Work;
+	const auto&         ArrayProperty = Arrays.ArrayProperty;
+
+	const auto NoSetup = [] {};
+	const auto Reset   = [&Arrays] { Arrays.Reset(); };
+
+	// measure Body with Setup, and add the result
+	const auto Add = [&](const TCHAR* const Operation, TFunctionRef<void()> Setup,
+	                     TFunctionRef<void()> Body) {
+		Report.Add(Measure(Operation, FElement::TypeName, TEXT("Native"), Num,
+		                   Setup, Body));
+	};
+
+	const auto    NumSamples = FMath::Max(Num / 10, 1);
+	FRandomEngine Engine(1);
+	TArray<T>     Samples;
+	TArray<T>     Others;
+
+	Add(TEXT("Count"), NoSetup, [&] {
+		UUdonArrayUtilsLibrary::GenericCount(Work, ArrayProperty,
+		                                     &Arrays.Source[0]);
+	});
+
+	const auto Value = FElement::Make(0);
+	Add(TEXT("Fill"), NoSetup, [&] {
+		UUdonArrayUtilsLibrary::GenericFill(Work, ArrayProperty, &Value);
+	});
+
+	Add(TEXT("RemoveRange"), Reset, [&] {
+		UUdonArrayUtilsLibrary::GenericRemoveRange(Work, ArrayProperty, 0,
+		                                           Num / 2);
+	});
+	Test.TestEqual(TEXT("RemoveRange"), Arrays.Work.Num(), Num - Num / 2);
+
+	Reset();
+	Add(TEXT("Shuffle"), NoSetup, [&] {
+		UUdonArrayUtilsLibrary::GenericShuffle(Work, ArrayProperty, Engine);
+	});
+
+	Add(TEXT("RandomSample"), NoSetup, [&] {
+		UUdonArrayUtilsLibrary::GenericRandomSample(
+		    Work, ArrayProperty, NumSamples, &Samples, &Others, Engine);
+	});
+	Test.TestEqual(TEXT("RandomSample"), Samples.Num() + Others.Num(), Num);
+
+	TArray<int32> SampleIndices;
+	Add(TEXT("RandomSampleIndices"), NoSetup, [&] {
+		SampleIndices = UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		    Work, ArrayProperty, NumSamples, Engine);
+	});
+	Test.TestEqual(TEXT("RandomSampleIndices"), SampleIndices.Num(), NumSamples);
+
+	// weights from 1 to Num, so that every element can be drawn
+	TArray<double> Weights;
+	Weights.Reserve(Num);
+	for (auto i = 0; i < Num; ++i) {
+		Weights.Add(i + 1);
+	}
+
+	for (const auto bWithReplacement : {false, true}) {
+		const auto* const Operation =
+		    bWithReplacement ? TEXT("WeightedRandomSampleWithReplacement")
+		                     : TEXT("WeightedRandomSample");
+		auto bSucceeded = false;
+		Add(Operation, NoSetup, [&] {
+			bSucceeded = UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+			    Work, ArrayProperty, Weights, FString(), NumSamples,
+			    bWithReplacement, Engine, nullptr, &Samples);
+		});
+		Test.TestTrue(Operation, bSucceeded && Samples.Num() == NumSamples);
+	}
+
+	// the numeric kernels
+	if constexpr (std::is_same_v<T, int32>) {
+		int32 Sum     = 0;
+		int32 Average = 0;
+		Add(TEXT("Sum"), NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericSum(Work, ArrayProperty, &Sum);
+		});
+		Add(TEXT("Average"), NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericAverage(Work, ArrayProperty,
+			                                       &Average);
+		});
+
+		auto MinIndex = INDEX_NONE;
+		auto MaxIndex = INDEX_NONE;
+		Add(TEXT("MinMax"), NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericMinMax(Work, ArrayProperty, MinIndex,
+			                                      MaxIndex);
+		});
+		Test.TestEqual(TEXT("MinMax"), Arrays.Work[MinIndex], -1);
+
+		auto DotProduct = 0.0;
+		Add(TEXT("DotProduct"), NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericDotProduct(Work, &Arrays.Source,
+			                                          ArrayProperty, DotProduct);
+		});
+	}
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUdonArrayUtilsArrayBenchmark,
+                                  "UdonArrayUtils.Benchmarks.Array",
+                                  UDON_ARRAY_UTILS_BENCHMARK_FLAGS)
+
+void FUdonArrayUtilsArrayBenchmark::GetTests(
+    TArray<FString>& OutBeautifiedNames,
+    TArray<FString>& OutTestCommands) const {
+	udon::GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUdonArrayUtilsArrayBenchmark::RunTest(const FString& Parameters) {
+	using namespace udon;
+
+	FString ElementType;
+	int32   Num = 0;
+	if (!ParseBenchmarkTest(Parameters, ElementType, Num)) {
+		AddError(FString::Printf(TEXT("Invalid parameters: %s"), *Parameters));
+		return false;
+	}
+
+	auto& Report = FBenchmarkReport::Get(TEXT("Array"));
+	DispatchBenchmarkElementType(ElementType, [&](const auto Element) {
+		MeasureArrayOperations<std::decay_t<decltype(Element)>>(*this, Report,
+		                                                        Num);
+	});
+
+	return Report.Write();
+}
+
+#endif
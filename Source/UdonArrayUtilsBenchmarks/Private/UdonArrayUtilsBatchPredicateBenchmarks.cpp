@@ -0,0 +1,157 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+/**
+ * Compares batch predicates, called once per chunk of elements, with the
+ * same predicates called once per element, on arrays of Num elements of type
+ * T.
+ */
+template <class T>
+void MeasureBatchPredicates(FAutomationTestBase& Test,
+                            FBenchmarkReport& Report, const int32 Num) {
+	using FElement = TBenchmarkElement<T>;
+
+	// the source and work arrays
+	const auto BytesPerElement = (sizeof(T) + FElement::HeapBytes) * 2;
+	if (!ShouldMeasure(Num, BytesPerElement, false)) {
+		Test.AddInfo(TEXT("Skipped: the arrays exceed the memory limit."));
+		return;
+	}
+
+	const TStrongObjectPtr<UUdonArrayUtilsBenchmarkFixture> Fixture(
+	    NewObject<UUdonArrayUtilsBenchmarkFixture>());
+	const TBenchmarkArrays<T> Arrays(*Fixture, Num);
+	const auto* const         Work          = &Arrays.Work;
+	const auto&               ArrayProperty = Arrays.ArrayProperty;
+
+	const auto NoSetup = [] {};
+
+	// measure Body, and add the result
+	const auto Add = [&](const TCHAR* const Operation,
+	                     const TCHAR* const Variant, TFunctionRef<void()> Body) {
+		Report.Add(
+		    Measure(Operation, FElement::TypeName, Variant, Num, NoSetup, Body));
+	};
+
+	// native predicates, as the lower bound. the other variants must count
+	// the same elements.
+	auto ExpectedCount = 0;
+	{
+		const auto* const Variant = TEXT("Native");
+		const auto        IsEven  = Arrays.FindNative(TEXT("IsEven"), 1);
+		const auto        IsNonNegative =
+		    Arrays.FindNative(TEXT("IsNonNegative"), 1);
+		const auto IsNegative = Arrays.FindNative(TEXT("IsNegative"), 1);
+
+		Add(TEXT("CountIf"), Variant, [&] {
+			ExpectedCount = UUdonArrayUtilsLibrary::GenericCountIf(
+			    Work, ArrayProperty, *IsEven);
+		});
+		Add(TEXT("AllSatisfy"), Variant, [&] {
+			UUdonArrayUtilsLibrary::GenericAllSatisfy(Work, ArrayProperty,
+			                                          *IsNonNegative);
+		});
+		Add(TEXT("FindIf"), Variant, [&] {
+			UUdonArrayUtilsLibrary::GenericFindIf(Work, ArrayProperty,
+			                                      *IsNegative);
+		});
+	}
+
+	// predicates called per element or per chunk, through their thunks or
+	// through ProcessEvent
+	struct FVariant {
+		const TCHAR* Name;
+		bool         bProcessEvent;
+		bool         bBatch;
+	};
+	const FVariant Variants[] = {
+	    {TEXT("Thunk"), false, false},
+	    {TEXT("ProcessEvent"), true, false},
+	    {TEXT("BatchThunk"), false, true},
+	    {TEXT("BatchProcessEvent"), true, true},
+	};
+
+	for (const auto& Variant : Variants) {
+		// a batch predicate enters ProcessEvent once per chunk, so only the
+		// per-element ProcessEvent variant is limited
+		if (!ShouldMeasure(Num, BytesPerElement,
+		                   Variant.bProcessEvent && !Variant.bBatch)) {
+			Test.AddInfo(TEXT("Skipped ProcessEvent: the array exceeds "
+			                  "MaxProcessEventNum."));
+			continue;
+		}
+
+		auto& IsEven = Arrays.FindFunction(
+		    TEXT("IsEven"), Variant.bProcessEvent, Variant.bBatch);
+		auto& IsNegative = Arrays.FindFunction(
+		    TEXT("IsNegative"), Variant.bProcessEvent, Variant.bBatch);
+		auto& IsNonNegative = Arrays.FindFunction(
+		    TEXT("IsNonNegative"), Variant.bProcessEvent, Variant.bBatch);
+
+		auto Count      = 0;
+		auto bAll       = true;
+		auto FoundIndex = 0;
+		Add(TEXT("CountIf"), Variant.Name, [&] {
+			Count = UUdonArrayUtilsLibrary::GenericCountIf(Work, ArrayProperty,
+			                                               *Fixture, IsEven);
+		});
+		Add(TEXT("AllSatisfy"), Variant.Name, [&] {
+			bAll = UUdonArrayUtilsLibrary::GenericAllSatisfy(
+			    Work, ArrayProperty, *Fixture, IsNonNegative);
+		});
+		Add(TEXT("FindIf"), Variant.Name, [&] {
+			FoundIndex = UUdonArrayUtilsLibrary::GenericFindIf(
+			    Work, ArrayProperty, *Fixture, IsNegative);
+		});
+
+		Test.TestEqual(FString::Printf(TEXT("%s CountIf"), Variant.Name), Count,
+		               ExpectedCount);
+		Test.TestFalse(FString::Printf(TEXT("%s AllSatisfy"), Variant.Name),
+		               bAll);
+		Test.TestEqual(FString::Printf(TEXT("%s FindIf"), Variant.Name),
+		               FoundIndex, Num - 1);
+	}
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUdonArrayUtilsBatchPredicateBenchmark,
+                                  "UdonArrayUtils.Benchmarks.BatchPredicates",
+                                  UDON_ARRAY_UTILS_BENCHMARK_FLAGS)
+
+void FUdonArrayUtilsBatchPredicateBenchmark::GetTests(
+    TArray<FString>& OutBeautifiedNames,
+    TArray<FString>& OutTestCommands) const {
+	udon::GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUdonArrayUtilsBatchPredicateBenchmark::RunTest(
+    const FString& Parameters) {
+	using namespace udon;
+
+	FString ElementType;
+	int32   Num = 0;
+	if (!ParseBenchmarkTest(Parameters, ElementType, Num)) {
+		AddError(FString::Printf(TEXT("Invalid parameters: %s"), *Parameters));
+		return false;
+	}
+
+	auto& Report = FBenchmarkReport::Get(TEXT("BatchPredicates"));
+	DispatchBenchmarkElementType(ElementType, [&](const auto Element) {
+		MeasureBatchPredicates<std::decay_t<decltype(Element)>>(*this, Report,
+		                                                        Num);
+	});
+
+	return Report.Write();
+}
+
+#endif
@@ -0,0 +1,302 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonArrayUtilsBenchmarkFixture.h"
+
+#include "UdonArrayUtilsLibrary.h"
+
+namespace udon {
+namespace {
+// names of the native predicates
+const FName NativeIsEvenName(TEXT("NativeIsEven"));
+const FName NativeIsNegativeName(TEXT("NativeIsNegative"));
+const FName NativeIsNonNegativeName(TEXT("NativeIsNonNegative"));
+const FName NativeLessName(TEXT("NativeLess"));
+
+// the predicates on the keys of elements of type T
+template <class T>
+bool IsEven(const T& Value) {
+	return TBenchmarkElement<T>::IsEven(Value);
+}
+
+template <class T>
+bool IsNegative(const T& Value) {
+	return TBenchmarkElement<T>::GetKey(Value) < 0;
+}
+
+template <class T>
+bool Less(const T& A, const T& B) {
+	return TBenchmarkElement<T>::Less(A, B);
+}
+
+// strings are looked at without parsing them, like a typical string predicate
+template <>
+bool IsNegative(const FString& Value) {
+	return Value.Len() > 0 && Value[0] == TEXT('-');
+}
+
+template <class T>
+bool IsNonNegative(const T& Value) {
+	return !IsNegative(Value);
+}
+
+// evaluate a predicate for each element of a chunk
+template <class T, class PredicateT>
+TArray<bool> EvaluateBatch(const TArray<T>& Values, PredicateT Predicate) {
+	TArray<bool> Results;
+	Results.SetNumUninitialized(Values.Num());
+	for (auto i = 0; i < Values.Num(); ++i) {
+		Results[i] = Predicate(Values[i]);
+	}
+	return Results;
+}
+
+// register the native predicates for elements of type T
+template <class T>
+void RegisterNativePredicatesOf() {
+	UUdonArrayUtilsLibrary::RegisterNativePredicate<T>(
+	    NativeIsEvenName, [](const T& Value) { return IsEven(Value); }, true);
+	UUdonArrayUtilsLibrary::RegisterNativePredicate<T>(
+	    NativeIsNegativeName, [](const T& Value) { return IsNegative(Value); },
+	    true);
+	UUdonArrayUtilsLibrary::RegisterNativePredicate<T>(
+	    NativeIsNonNegativeName,
+	    [](const T& Value) { return !IsNegative(Value); }, true);
+	UUdonArrayUtilsLibrary::RegisterNativePredicate<T>(
+	    NativeLessName,
+	    [](const T& A, const T& B) { return Less(A, B); }, true);
+}
+} // namespace
+} // namespace udon
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenInt(const int32& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeInt(const int32& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeInt(
+    const int32& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessInt(const int32& A,
+                                              const int32& B) const {
+	return udon::Less(A, B);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenIntProcessEvent(
+    const int32& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeIntProcessEvent(
+    const int32& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeIntProcessEvent(
+    const int32& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessIntProcessEvent(
+    const int32& A, const int32& B) const {
+	return udon::Less(A, B);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenString(
+    const FString& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeString(
+    const FString& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeString(
+    const FString& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessString(const FString& A,
+                                                 const FString& B) const {
+	return udon::Less(A, B);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenStringProcessEvent(
+    const FString& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeStringProcessEvent(
+    const FString& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStringProcessEvent(
+    const FString& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessStringProcessEvent(
+    const FString& A, const FString& B) const {
+	return udon::Less(A, B);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenStruct(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeStruct(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStruct(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessStruct(
+    const FUdonArrayUtilsBenchmarkElement& A,
+    const FUdonArrayUtilsBenchmarkElement& B) const {
+	return udon::Less(A, B);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsEvenStructProcessEvent(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return udon::IsEven(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNegativeStructProcessEvent(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStructProcessEvent(
+    const FUdonArrayUtilsBenchmarkElement& Value) const {
+	return !udon::IsNegative(Value);
+}
+
+bool UUdonArrayUtilsBenchmarkFixture::LessStructProcessEvent(
+    const FUdonArrayUtilsBenchmarkElement& A,
+    const FUdonArrayUtilsBenchmarkElement& B) const {
+	return udon::Less(A, B);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenIntBatch(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsEven<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeIntBatch(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNegative<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNonNegativeIntBatch(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNonNegative<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenIntBatchProcessEvent(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsEven<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeIntBatchProcessEvent(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNegative<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNonNegativeIntBatchProcessEvent(
+    const TArray<int32>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNonNegative<int32>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenStringBatch(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsEven<FString>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeStringBatch(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNegative<FString>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStringBatch(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNonNegative<FString>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenStringBatchProcessEvent(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsEven<FString>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeStringBatchProcessEvent(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNegative<FString>);
+}
+
+TArray<bool>
+UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStringBatchProcessEvent(
+    const TArray<FString>& Values) const {
+	return udon::EvaluateBatch(Values, &udon::IsNonNegative<FString>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenStructBatch(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsEven<FUdonArrayUtilsBenchmarkElement>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeStructBatch(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsNegative<FUdonArrayUtilsBenchmarkElement>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStructBatch(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsNonNegative<FUdonArrayUtilsBenchmarkElement>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsEvenStructBatchProcessEvent(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsEven<FUdonArrayUtilsBenchmarkElement>);
+}
+
+TArray<bool> UUdonArrayUtilsBenchmarkFixture::IsNegativeStructBatchProcessEvent(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsNegative<FUdonArrayUtilsBenchmarkElement>);
+}
+
+TArray<bool>
+UUdonArrayUtilsBenchmarkFixture::IsNonNegativeStructBatchProcessEvent(
+    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const {
+	return udon::EvaluateBatch(
+	    Values, &udon::IsNonNegative<FUdonArrayUtilsBenchmarkElement>);
+}
+
+void UUdonArrayUtilsBenchmarkFixture::RegisterNativePredicates() {
+	udon::RegisterNativePredicatesOf<int32>();
+	udon::RegisterNativePredicatesOf<FString>();
+	udon::RegisterNativePredicatesOf<FUdonArrayUtilsBenchmarkElement>();
+}
+
+void UUdonArrayUtilsBenchmarkFixture::UnregisterNativePredicates() {
+	UUdonArrayUtilsLibrary::UnregisterNativePredicate(udon::NativeIsEvenName);
+	UUdonArrayUtilsLibrary::UnregisterNativePredicate(
+	    udon::NativeIsNegativeName);
+	UUdonArrayUtilsLibrary::UnregisterNativePredicate(
+	    udon::NativeIsNonNegativeName);
+	UUdonArrayUtilsLibrary::UnregisterNativePredicate(udon::NativeLessName);
+}
@@ -0,0 +1,345 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/UnrealType.h"
+
+#include "UdonArrayUtilsBenchmarkFixture.generated.h"
+
+/**
+ * A 256-byte element, for measuring operations that move large elements.
+ */
+USTRUCT()
+struct FUdonArrayUtilsBenchmarkElement {
+	GENERATED_BODY()
+
+	// constructor
+	FUdonArrayUtilsBenchmarkElement() {
+		FMemory::Memzero(Payload);
+	}
+
+	// the key the predicates look at
+	UPROPERTY()
+	int32 Key = 0;
+
+	// data moved with the key
+	UPROPERTY()
+	int32 Payload[63];
+};
+
+static_assert(sizeof(FUdonArrayUtilsBenchmarkElement) == 256,
+              "benchmark elements must be 256 bytes");
+
+/**
+ * The object the benchmarks call predicates on, and whose array properties
+ * describe the arrays being measured.
+ * Every predicate looks at an integer key of the element: the value of an
+ * int32, the decimal digits of an FString, or Key of a struct. Each comes in
+ * two variants:
+ * - Native UFUNCTIONs (e.g. IsEvenInt), which the library calls through their
+ *   thunks.
+ * - BlueprintCosmetic copies (e.g. IsEvenIntProcessEvent), which the library
+ *   calls through ProcessEvent, the path Blueprint functions take. They
+ *   measure the per-call cost of ProcessEvent (building the parameter frame
+ *   and dispatching the call), but the body is still native code: no
+ *   Blueprint bytecode runs, so a real Blueprint predicate is slower still.
+ * The unary predicates also come as batch predicates (e.g. IsEvenIntBatch
+ * and IsEvenIntBatchProcessEvent), which take a chunk of elements and return
+ * a bool for each.
+ */
+UCLASS()
+class UUdonArrayUtilsBenchmarkFixture: public UObject {
+	GENERATED_BODY()
+
+public:
+	// int32 elements
+	UPROPERTY()
+	TArray<int32> Ints;
+
+	// FString elements
+	UPROPERTY()
+	TArray<FString> Strings;
+
+	// 256-byte struct elements
+	UPROPERTY()
+	TArray<FUdonArrayUtilsBenchmarkElement> Structs;
+
+public:
+	// whether the key is even
+	UFUNCTION()
+	bool IsEvenInt(const int32& Value) const;
+
+	// whether the key is negative
+	UFUNCTION()
+	bool IsNegativeInt(const int32& Value) const;
+
+	// whether the key is not negative
+	UFUNCTION()
+	bool IsNonNegativeInt(const int32& Value) const;
+
+	// whether the key of A is less than that of B
+	UFUNCTION()
+	bool LessInt(const int32& A, const int32& B) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsEvenIntProcessEvent(const int32& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNegativeIntProcessEvent(const int32& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNonNegativeIntProcessEvent(const int32& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool LessIntProcessEvent(const int32& A, const int32& B) const;
+
+	// whether the keys of a chunk of elements are even
+	UFUNCTION()
+	TArray<bool> IsEvenIntBatch(const TArray<int32>& Values) const;
+
+	// whether the keys of a chunk of elements are negative
+	UFUNCTION()
+	TArray<bool> IsNegativeIntBatch(const TArray<int32>& Values) const;
+
+	// whether the keys of a chunk of elements are not negative
+	UFUNCTION()
+	TArray<bool> IsNonNegativeIntBatch(const TArray<int32>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool> IsEvenIntBatchProcessEvent(const TArray<int32>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool>
+	    IsNegativeIntBatchProcessEvent(const TArray<int32>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool>
+	    IsNonNegativeIntBatchProcessEvent(const TArray<int32>& Values) const;
+
+public:
+	UFUNCTION()
+	bool IsEvenString(const FString& Value) const;
+
+	UFUNCTION()
+	bool IsNegativeString(const FString& Value) const;
+
+	UFUNCTION()
+	bool IsNonNegativeString(const FString& Value) const;
+
+	UFUNCTION()
+	bool LessString(const FString& A, const FString& B) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsEvenStringProcessEvent(const FString& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNegativeStringProcessEvent(const FString& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNonNegativeStringProcessEvent(const FString& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool LessStringProcessEvent(const FString& A, const FString& B) const;
+
+	UFUNCTION()
+	TArray<bool> IsEvenStringBatch(const TArray<FString>& Values) const;
+
+	UFUNCTION()
+	TArray<bool> IsNegativeStringBatch(const TArray<FString>& Values) const;
+
+	UFUNCTION()
+	TArray<bool> IsNonNegativeStringBatch(const TArray<FString>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool>
+	    IsEvenStringBatchProcessEvent(const TArray<FString>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool>
+	    IsNegativeStringBatchProcessEvent(const TArray<FString>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool> IsNonNegativeStringBatchProcessEvent(
+	    const TArray<FString>& Values) const;
+
+public:
+	UFUNCTION()
+	bool IsEvenStruct(const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION()
+	bool IsNegativeStruct(const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION()
+	bool
+	    IsNonNegativeStruct(const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION()
+	bool LessStruct(const FUdonArrayUtilsBenchmarkElement& A,
+	                const FUdonArrayUtilsBenchmarkElement& B) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsEvenStructProcessEvent(
+	    const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNegativeStructProcessEvent(
+	    const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool IsNonNegativeStructProcessEvent(
+	    const FUdonArrayUtilsBenchmarkElement& Value) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	bool LessStructProcessEvent(const FUdonArrayUtilsBenchmarkElement& A,
+	                            const FUdonArrayUtilsBenchmarkElement& B) const;
+
+	UFUNCTION()
+	TArray<bool> IsEvenStructBatch(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+	UFUNCTION()
+	TArray<bool> IsNegativeStructBatch(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+	UFUNCTION()
+	TArray<bool> IsNonNegativeStructBatch(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool> IsEvenStructBatchProcessEvent(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool> IsNegativeStructBatchProcessEvent(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+	UFUNCTION(BlueprintCosmetic)
+	TArray<bool> IsNonNegativeStructBatchProcessEvent(
+	    const TArray<FUdonArrayUtilsBenchmarkElement>& Values) const;
+
+public:
+	/**
+	 * Registers the predicates as native predicates, named like the native
+	 * UFUNCTIONs with the prefix "Native" (e.g. NativeIsEven), for all three
+	 * element types.
+	 */
+	static void RegisterNativePredicates();
+
+	// unregisters the predicates registered by RegisterNativePredicates
+	static void UnregisterNativePredicates();
+};
+
+namespace udon {
+/**
+ * Element types measured by the benchmarks. Each specialization creates
+ * elements from keys and tells where their array property and predicates
+ * are.
+ */
+template <class T>
+struct TBenchmarkElement;
+
+template <>
+struct TBenchmarkElement<int32> {
+	// name of the type in the results
+	static constexpr const TCHAR* TypeName = TEXT("int32");
+
+	// suffix of the names of the predicate UFUNCTIONs
+	static constexpr const TCHAR* FunctionSuffix = TEXT("Int");
+
+	// property path of the key for SortByProperty
+	static constexpr const TCHAR* KeyPath = TEXT("");
+
+	// whether the elements can be ordered without a comparison function
+	static constexpr bool bHasNaturalOrder = true;
+
+	// bytes allocated on the heap by an element, to estimate memory use
+	static constexpr SIZE_T HeapBytes = 0;
+
+	static int32 Make(const int32 Key) {
+		return Key;
+	}
+
+	static int32 GetKey(const int32& Value) {
+		return Value;
+	}
+
+	// the IsEven predicates, also used by reference implementations
+	static bool IsEven(const int32& Value) {
+		return Value % 2 == 0;
+	}
+
+	// the order of the Less predicates, also used to check sorted results
+	static bool Less(const int32& A, const int32& B) {
+		return A < B;
+	}
+
+	static FName GetArrayName() {
+		return GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsBenchmarkFixture, Ints);
+	}
+};
+
+template <>
+struct TBenchmarkElement<FString> {
+	static constexpr const TCHAR* TypeName       = TEXT("FString");
+	static constexpr const TCHAR* FunctionSuffix = TEXT("String");
+	static constexpr const TCHAR* KeyPath        = TEXT("");
+	static constexpr bool         bHasNaturalOrder = true;
+	static constexpr SIZE_T       HeapBytes        = 32;
+
+	static FString Make(const int32 Key) {
+		return FString::FromInt(Key);
+	}
+
+	static int32 GetKey(const FString& Value) {
+		return FCString::Atoi(*Value);
+	}
+
+	// strings are looked at without parsing them, like a typical string
+	// predicate
+	static bool IsEven(const FString& Value) {
+		return Value.Len() > 0 && (Value[Value.Len() - 1] - TEXT('0')) % 2 == 0;
+	}
+
+	static bool Less(const FString& A, const FString& B) {
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	}
+
+	static FName GetArrayName() {
+		return GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsBenchmarkFixture, Strings);
+	}
+};
+
+template <>
+struct TBenchmarkElement<FUdonArrayUtilsBenchmarkElement> {
+	static constexpr const TCHAR* TypeName       = TEXT("Struct256");
+	static constexpr const TCHAR* FunctionSuffix = TEXT("Struct");
+	static constexpr const TCHAR* KeyPath        = TEXT("Key");
+	static constexpr bool         bHasNaturalOrder = false;
+	static constexpr SIZE_T       HeapBytes        = 0;
+
+	static FUdonArrayUtilsBenchmarkElement Make(const int32 Key) {
+		FUdonArrayUtilsBenchmarkElement Element;
+		Element.Key = Key;
+		return Element;
+	}
+
+	static int32 GetKey(const FUdonArrayUtilsBenchmarkElement& Value) {
+		return Value.Key;
+	}
+
+	static bool IsEven(const FUdonArrayUtilsBenchmarkElement& Value) {
+		return Value.Key % 2 == 0;
+	}
+
+	static bool Less(const FUdonArrayUtilsBenchmarkElement& A,
+	                 const FUdonArrayUtilsBenchmarkElement& B) {
+		return A.Key < B.Key;
+	}
+
+	static FName GetArrayName() {
+		return GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsBenchmarkFixture, Structs);
+	}
+};
+} // namespace udon
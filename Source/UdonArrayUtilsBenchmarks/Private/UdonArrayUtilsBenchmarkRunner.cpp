@@ -0,0 +1,215 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUdonArrayUtilsBenchmarks, Log, All);
+
+namespace udon {
+namespace {
+// the most iterations of one case, so that tiny arrays finish in time
+constexpr int32 MaxIterations = 100'000;
+
+// get the directory the results are written to
+FString GetResultDirectory() {
+	return FPaths::Combine(FPaths::ProjectSavedDir(),
+	                       TEXT("UdonArrayUtilsBenchmarks"));
+}
+} // namespace
+
+const FBenchmarkSettings& FBenchmarkSettings::Get() {
+	static const auto Settings = [] {
+		FBenchmarkSettings Result;
+		const auto* const CommandLine = FCommandLine::Get();
+		FParse::Value(CommandLine, TEXT("UdonArrayUtilsBenchmarkMaxNum="),
+		              Result.MaxNum);
+		FParse::Value(CommandLine,
+		              TEXT("UdonArrayUtilsBenchmarkMaxProcessEventNum="),
+		              Result.MaxProcessEventNum);
+		FParse::Value(CommandLine, TEXT("UdonArrayUtilsBenchmarkMaxMB="),
+		              Result.MaxMegabytes);
+		FParse::Value(CommandLine, TEXT("UdonArrayUtilsBenchmarkMinSeconds="),
+		              Result.MinSeconds);
+		FParse::Value(CommandLine,
+		              TEXT("UdonArrayUtilsBenchmarkMaxQuadraticGB="),
+		              Result.MaxQuadraticGigabytes);
+		return Result;
+	}();
+	return Settings;
+}
+
+FBenchmarkReport& FBenchmarkReport::Get(const FString& TestName) {
+	static TMap<FString, FBenchmarkReport> Reports;
+
+	auto& Report = Reports.FindOrAdd(TestName);
+	Report.TestName = TestName;
+	return Report;
+}
+
+void FBenchmarkReport::Add(FBenchmarkResult&& Result) {
+	UE_LOG(LogUdonArrayUtilsBenchmarks, Display,
+	       TEXT("%s %s %s %d: %.3f us (min %.3f us, %d iterations)"),
+	       *Result.Operation, *Result.ElementType, *Result.Variant, Result.Num,
+	       Result.MeanSeconds * 1e6, Result.MinSeconds * 1e6, Result.Iterations);
+
+	Results.Add(MoveTemp(Result));
+}
+
+bool FBenchmarkReport::Write() const {
+	const auto Directory = GetResultDirectory();
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Directory);
+
+	// write the results as CSV
+	FString Csv = TEXT("Operation,ElementType,Variant,Num,Iterations,"
+	                   "MeanSeconds,MinSeconds\n");
+	for (const auto& Result : Results) {
+		Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%.9g,%.9g\n"),
+		                       *Result.Operation, *Result.ElementType,
+		                       *Result.Variant, Result.Num, Result.Iterations,
+		                       Result.MeanSeconds, Result.MinSeconds);
+	}
+
+	// write the results as JSON, with the build they were measured on
+	FString Json;
+	const auto Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Test"), TestName);
+	Writer->WriteValue(TEXT("EngineVersion"),
+	                   FEngineVersion::Current().ToString());
+	Writer->WriteValue(TEXT("Platform"),
+	                   FString(FPlatformProperties::IniPlatformName()));
+	Writer->WriteValue(TEXT("BuildConfiguration"),
+	                   FString(LexToString(FApp::GetBuildConfiguration())));
+	Writer->WriteArrayStart(TEXT("Results"));
+	for (const auto& Result : Results) {
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Operation"), Result.Operation);
+		Writer->WriteValue(TEXT("ElementType"), Result.ElementType);
+		Writer->WriteValue(TEXT("Variant"), Result.Variant);
+		Writer->WriteValue(TEXT("Num"), Result.Num);
+		Writer->WriteValue(TEXT("Iterations"), Result.Iterations);
+		Writer->WriteValue(TEXT("MeanSeconds"), Result.MeanSeconds);
+		Writer->WriteValue(TEXT("MinSeconds"), Result.MinSeconds);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	const auto CsvPath  = FPaths::Combine(Directory, TestName + TEXT(".csv"));
+	const auto JsonPath = FPaths::Combine(Directory, TestName + TEXT(".json"));
+	return FFileHelper::SaveStringToFile(Csv, *CsvPath) &&
+	       FFileHelper::SaveStringToFile(Json, *JsonPath);
+}
+
+TArray<int32> GetBenchmarkSizes(const bool bFineSteps) {
+	TArray<int32> Sizes;
+	for (auto Num = 10; Num <= 10'000'000; Num *= 10) {
+		for (const auto Step : {1, 2, 5}) {
+			// if only powers of 10 are measured
+			if (Step != 1 && !bFineSteps) {
+				continue;
+			}
+
+			if (Num * Step <= FMath::Min(FBenchmarkSettings::Get().MaxNum,
+			                             10'000'000)) {
+				Sizes.Add(Num * Step);
+			}
+		}
+	}
+	return Sizes;
+}
+
+void GetBenchmarkTests(TArray<FString>& OutBeautifiedNames,
+                       TArray<FString>& OutTestCommands,
+                       const bool       bFineSteps) {
+	const TCHAR* const ElementTypes[] = {
+	    TBenchmarkElement<int32>::TypeName,
+	    TBenchmarkElement<FString>::TypeName,
+	    TBenchmarkElement<FUdonArrayUtilsBenchmarkElement>::TypeName};
+
+	for (const auto* const ElementType : ElementTypes) {
+		for (const auto Num : GetBenchmarkSizes(bFineSteps)) {
+			OutBeautifiedNames.Add(
+			    FString::Printf(TEXT("%s x %d"), ElementType, Num));
+			OutTestCommands.Add(FString::Printf(TEXT("%s %d"), ElementType, Num));
+		}
+	}
+}
+
+bool ParseBenchmarkTest(const FString& Parameters, FString& OutElementType,
+                        int32& OutNum) {
+	FString NumString;
+	if (!Parameters.Split(TEXT(" "), &OutElementType, &NumString)) {
+		return false;
+	}
+
+	OutNum = FCString::Atoi(*NumString);
+	return OutNum > 0;
+}
+
+bool ShouldMeasure(const int32 Num, const SIZE_T BytesPerElement,
+                   const bool bCallsProcessEvent) {
+	const auto& Settings = FBenchmarkSettings::Get();
+
+	// if the predicates are called through ProcessEvent too many times
+	if (bCallsProcessEvent && Num > Settings.MaxProcessEventNum) {
+		return false;
+	}
+
+	// if the arrays take too much memory
+	return static_cast<uint64>(Num) * BytesPerElement <=
+	       static_cast<uint64>(Settings.MaxMegabytes) * 1024 * 1024;
+}
+
+bool ShouldMeasureQuadratic(const int32 Num, const SIZE_T ElementSize) {
+	const auto MovedBytes = static_cast<uint64>(Num) * Num / 4 * ElementSize;
+	return MovedBytes <=
+	       static_cast<uint64>(
+	           FBenchmarkSettings::Get().MaxQuadraticGigabytes) *
+	           1024 * 1024 * 1024;
+}
+
+FBenchmarkResult Measure(const FString& Operation, const FString& ElementType,
+                         const FString& Variant, const int32 Num,
+                         const TFunctionRef<void()> Setup,
+                         const TFunctionRef<void()> Body) {
+	const auto MinSeconds = FBenchmarkSettings::Get().MinSeconds;
+
+	FBenchmarkResult Result;
+	Result.Operation   = Operation;
+	Result.ElementType = ElementType;
+	Result.Variant     = Variant;
+	Result.Num         = Num;
+	Result.MinSeconds  = TNumericLimits<double>::Max();
+
+	// warm up caches and the plans of the predicates
+	Setup();
+	Body();
+
+	auto TotalSeconds = 0.0;
+	while (Result.Iterations == 0 ||
+	       (TotalSeconds < MinSeconds && Result.Iterations < MaxIterations)) {
+		Setup();
+
+		const auto StartTime = FPlatformTime::Seconds();
+		Body();
+		const auto Seconds = FPlatformTime::Seconds() - StartTime;
+
+		TotalSeconds += Seconds;
+		Result.MinSeconds = FMath::Min(Result.MinSeconds, Seconds);
+		++Result.Iterations;
+	}
+
+	Result.MeanSeconds = TotalSeconds / Result.Iterations;
+	return Result;
+}
+} // namespace udon
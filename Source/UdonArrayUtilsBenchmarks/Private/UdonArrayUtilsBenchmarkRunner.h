@@ -0,0 +1,231 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+#include "UdonArrayUtilsBenchmarkFixture.h"
+#include "UdonArrayUtilsLibrary.h"
+
+/**
+ * Flags of the benchmark tests. They are performance tests, and run in the
+ * editor, in game and server builds, and in commandlets, so that they can be
+ * run headless on build agents.
+ */
+#define UDON_ARRAY_UTILS_BENCHMARK_FLAGS                                        \
+	(EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | \
+	 EAutomationTestFlags::ServerContext |                                      \
+	 EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+namespace udon {
+/**
+ * Settings of the benchmarks, read once from the command line.
+ */
+struct FBenchmarkSettings {
+	// the largest array measured (-UdonArrayUtilsBenchmarkMaxNum=)
+	int32 MaxNum = 10'000'000;
+
+	// the largest array measured with predicates called through ProcessEvent
+	// (-UdonArrayUtilsBenchmarkMaxProcessEventNum=)
+	int32 MaxProcessEventNum = 100'000;
+
+	// the memory the arrays of one case may take, in megabytes
+	// (-UdonArrayUtilsBenchmarkMaxMB=)
+	int32 MaxMegabytes = 2048;
+
+	// the time each case is repeated for, in seconds
+	// (-UdonArrayUtilsBenchmarkMinSeconds=)
+	double MinSeconds = 0.2;
+
+	// the memory quadratic reference implementations may move per iteration,
+	// in gigabytes (-UdonArrayUtilsBenchmarkMaxQuadraticGB=)
+	int32 MaxQuadraticGigabytes = 64;
+
+	// get the settings
+	static const FBenchmarkSettings& Get();
+};
+
+/**
+ * A measured case.
+ */
+struct FBenchmarkResult {
+	// the operation, such as "CountIf"
+	FString Operation;
+
+	// the type of the elements
+	FString ElementType;
+
+	// how the operation was called, such as "Thunk", "ProcessEvent" or "Native"
+	FString Variant;
+
+	// the number of elements
+	int32 Num = 0;
+
+	// the number of timed iterations
+	int32 Iterations = 0;
+
+	// the mean and the minimum time of an iteration
+	double MeanSeconds = 0.0;
+	double MinSeconds  = 0.0;
+};
+
+/**
+ * The results of a benchmark test. The results of all parameters of a
+ * complex test are collected, and written to
+ * Saved/UdonArrayUtilsBenchmarks/<Test>.csv and <Test>.json after each
+ * parameter, so that a partial run still leaves its results.
+ */
+class FBenchmarkReport {
+public:
+	// get the report of the test named TestName
+	static FBenchmarkReport& Get(const FString& TestName);
+
+public:
+	// add a result, and log it
+	void Add(FBenchmarkResult&& Result);
+
+	// write the results. returns false if a file couldn't be written.
+	bool Write() const;
+
+private:
+	// the name of the test, used as the file name
+	FString TestName;
+
+	// the results so far
+	TArray<FBenchmarkResult> Results;
+};
+
+/**
+ * The array sizes measured, from 10 to 10M, up to the maximum of the
+ * settings.
+ * @param bFineSteps  If true, the sizes go up in steps of 1, 2 and 5 (10, 20,
+ *                    50, 100, ...) to draw scaling curves; otherwise, in
+ *                    powers of 10.
+ */
+TArray<int32> GetBenchmarkSizes(bool bFineSteps = false);
+
+/**
+ * Adds the parameters of a complex benchmark test: one per element type and
+ * size, such as "int32 1000".
+ * @param bFineSteps  see GetBenchmarkSizes
+ */
+void GetBenchmarkTests(TArray<FString>& OutBeautifiedNames,
+                       TArray<FString>& OutTestCommands,
+                       bool             bFineSteps = false);
+
+/**
+ * Parses a parameter made by GetBenchmarkTests.
+ * @return  false if Parameters is malformed.
+ */
+bool ParseBenchmarkTest(const FString& Parameters, FString& OutElementType,
+                        int32& OutNum);
+
+/**
+ * Whether a case fits in the limits of the settings.
+ * @param Num  the number of elements
+ * @param BytesPerElement  the memory an element takes in all arrays of a case
+ * @param bCallsProcessEvent  whether the case calls predicates through
+ *                            ProcessEvent
+ */
+bool ShouldMeasure(int32 Num, SIZE_T BytesPerElement, bool bCallsProcessEvent);
+
+/**
+ * Whether a reference implementation that moves about Num * Num / 4 elements
+ * per iteration fits in the limit of the settings.
+ * @param Num  the number of elements
+ * @param ElementSize  the size of an element
+ */
+bool ShouldMeasureQuadratic(int32 Num, SIZE_T ElementSize);
+
+/**
+ * Times Body, repeating it until the time of the settings has passed. Setup
+ * is called before each iteration and isn't timed, so that operations that
+ * modify the array can start from the same elements.
+ */
+FBenchmarkResult Measure(const FString& Operation, const FString& ElementType,
+                         const FString& Variant, int32 Num,
+                         TFunctionRef<void()> Setup, TFunctionRef<void()> Body);
+
+/**
+ * The arrays of a benchmark case with elements of type T.
+ * Source holds elements with random non-negative keys, except the last,
+ * whose key is -1, so that searches for a negative key scan the whole array.
+ * Work is the array the operations run on, reset from Source as needed.
+ */
+template <class T>
+struct TBenchmarkArrays {
+	// constructor
+	TBenchmarkArrays(UUdonArrayUtilsBenchmarkFixture& InFixture,
+	                 const int32 Num, const int32 Seed = 1)
+	    : Fixture(InFixture),
+	      ArrayProperty(*FindFProperty<FArrayProperty>(
+	          UUdonArrayUtilsBenchmarkFixture::StaticClass(),
+	          TBenchmarkElement<T>::GetArrayName())) {
+		FRandomStream Stream(Seed);
+		Source.Reserve(Num);
+		for (auto i = 0; i < Num; ++i) {
+			Source.Add(TBenchmarkElement<T>::Make(
+			    i + 1 < Num ? Stream.RandHelper(1 << 30) : -1));
+		}
+		Work = Source;
+	}
+
+	// copy Source to Work
+	void Reset() {
+		Work = Source;
+	}
+
+	// find a predicate UFUNCTION of the fixture, such as IsEven + Int
+	// (+ Batch) (+ ProcessEvent)
+	UFunction& FindFunction(const TCHAR* const Predicate,
+	                        const bool         bProcessEvent,
+	                        const bool         bBatch = false) const {
+		auto* const Function = Fixture.FindFunction(
+		    FName(FString(Predicate) + TBenchmarkElement<T>::FunctionSuffix +
+		          (bBatch ? TEXT("Batch") : TEXT("")) +
+		          (bProcessEvent ? TEXT("ProcessEvent") : TEXT(""))));
+		check(Function);
+		return *Function;
+	}
+
+	// find a native predicate registered by the fixture, such as NativeIsEven
+	TSharedRef<const FUdonNativePredicate>
+	    FindNative(const TCHAR* const Predicate, const int32 NumArguments) const {
+		const auto NativePredicate = UUdonArrayUtilsLibrary::FindNativePredicate(
+		    FName(FString(TEXT("Native")) + Predicate), *ArrayProperty.Inner,
+		    NumArguments);
+		check(NativePredicate);
+		return NativePredicate.ToSharedRef();
+	}
+
+	UUdonArrayUtilsBenchmarkFixture& Fixture;
+	const FArrayProperty&            ArrayProperty;
+	TArray<T>                        Source;
+	TArray<T>                        Work;
+};
+
+/**
+ * Calls Function with the type of the elements named ElementType: a default
+ * constructed value of int32, FString or FUdonArrayUtilsBenchmarkElement.
+ * @return  false if ElementType is unknown.
+ */
+template <class FunctionT>
+bool DispatchBenchmarkElementType(const FString& ElementType,
+                                  FunctionT&&    Function) {
+	if (ElementType == TBenchmarkElement<int32>::TypeName) {
+		Function(int32());
+		return true;
+	}
+	if (ElementType == TBenchmarkElement<FString>::TypeName) {
+		Function(FString());
+		return true;
+	}
+	if (ElementType ==
+	    TBenchmarkElement<FUdonArrayUtilsBenchmarkElement>::TypeName) {
+		Function(FUdonArrayUtilsBenchmarkElement());
+		return true;
+	}
+	return false;
+}
+} // namespace udon
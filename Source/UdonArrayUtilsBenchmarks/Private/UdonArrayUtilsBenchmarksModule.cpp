@@ -0,0 +1,22 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+#include "UdonArrayUtilsBenchmarkFixture.h"
+
+/**
+ * The module of the benchmarks. It registers the native predicates the
+ * benchmarks call while it is loaded.
+ */
+class FUdonArrayUtilsBenchmarksModule: public IModuleInterface {
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override {
+		UUdonArrayUtilsBenchmarkFixture::RegisterNativePredicates();
+	}
+
+	virtual void ShutdownModule() override {
+		UUdonArrayUtilsBenchmarkFixture::UnregisterNativePredicates();
+	}
+};
+
+IMPLEMENT_MODULE(FUdonArrayUtilsBenchmarksModule, UdonArrayUtilsBenchmarks)
@@ -0,0 +1,221 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+/**
+ * Measures the predicate-driven queries and removals on arrays of Num
+ * elements of type T, calling the predicates through their thunks, through
+ * ProcessEvent and as native predicates.
+ */
+template <class T>
+void MeasurePredicates(FAutomationTestBase& Test, FBenchmarkReport& Report,
+                       const int32 Num) {
+	using FElement = TBenchmarkElement<T>;
+
+	// the source and work arrays
+	const auto BytesPerElement = (sizeof(T) + FElement::HeapBytes) * 2;
+	if (!ShouldMeasure(Num, BytesPerElement, false)) {
+		Test.AddInfo(TEXT("Skipped: the arrays exceed the memory limit."));
+		return;
+	}
+
+	const TStrongObjectPtr<UUdonArrayUtilsBenchmarkFixture> Fixture(
+	    NewObject<UUdonArrayUtilsBenchmarkFixture>());
+	TBenchmarkArrays<T> Arrays(*Fixture, Num);
+	auto* const         Work          = &Arrays.Work;
+	const auto&         ArrayProperty = Arrays.ArrayProperty;
+
+	const auto NoSetup = [] {};
+	const auto Reset   = [&Arrays] { Arrays.Reset(); };
+
+	// measure Body with Setup, and add the result
+	const auto Add = [&](const TCHAR* const Operation,
+	                     const TCHAR* const Variant, TFunctionRef<void()> Setup,
+	                     TFunctionRef<void()> Body) {
+		Report.Add(
+		    Measure(Operation, FElement::TypeName, Variant, Num, Setup, Body));
+	};
+
+	// results of the last iterations, checked once per variant
+	auto Count      = 0;
+	auto FoundIndex = 0;
+	auto bAll       = true;
+	auto bAny       = false;
+	auto bNone      = true;
+	auto MinIndex   = 0;
+
+	// check the results of the queries
+	const auto CheckResults = [&](const TCHAR* const Variant) {
+		Test.TestEqual(FString::Printf(TEXT("%s FindIf"), Variant), FoundIndex,
+		               Num - 1);
+		Test.TestFalse(FString::Printf(TEXT("%s AllSatisfy"), Variant), bAll);
+		Test.TestTrue(FString::Printf(TEXT("%s AnySatisfy"), Variant), bAny);
+		Test.TestFalse(FString::Printf(TEXT("%s NoneSatisfy"), Variant), bNone);
+		Test.TestEqual(FString::Printf(TEXT("%s MinElementIndex"), Variant),
+		               MinIndex, Num - 1);
+	};
+
+	// predicates called through their thunks or through ProcessEvent
+	for (const auto bProcessEvent : {false, true}) {
+		if (!ShouldMeasure(Num, BytesPerElement, bProcessEvent)) {
+			Test.AddInfo(TEXT("Skipped ProcessEvent: the array exceeds "
+			                  "MaxProcessEventNum."));
+			continue;
+		}
+
+		const auto* const Variant =
+		    bProcessEvent ? TEXT("ProcessEvent") : TEXT("Thunk");
+		auto& IsEven = Arrays.FindFunction(TEXT("IsEven"), bProcessEvent);
+		auto& IsNegative =
+		    Arrays.FindFunction(TEXT("IsNegative"), bProcessEvent);
+		auto& IsNonNegative =
+		    Arrays.FindFunction(TEXT("IsNonNegative"), bProcessEvent);
+		auto& Less = Arrays.FindFunction(TEXT("Less"), bProcessEvent);
+
+		Add(TEXT("CountIf"), Variant, NoSetup, [&] {
+			Count = UUdonArrayUtilsLibrary::GenericCountIf(Work, ArrayProperty,
+			                                               *Fixture, IsEven);
+		});
+		Add(TEXT("FindIf"), Variant, NoSetup, [&] {
+			FoundIndex = UUdonArrayUtilsLibrary::GenericFindIf(
+			    Work, ArrayProperty, *Fixture, IsNegative);
+		});
+		Add(TEXT("AllSatisfy"), Variant, NoSetup, [&] {
+			bAll = UUdonArrayUtilsLibrary::GenericAllSatisfy(
+			    Work, ArrayProperty, *Fixture, IsNonNegative);
+		});
+		Add(TEXT("AnySatisfy"), Variant, NoSetup, [&] {
+			bAny = UUdonArrayUtilsLibrary::GenericAnySatisfy(
+			    Work, ArrayProperty, *Fixture, IsNegative);
+		});
+		Add(TEXT("NoneSatisfy"), Variant, NoSetup, [&] {
+			bNone = UUdonArrayUtilsLibrary::GenericNoneSatisfy(
+			    Work, ArrayProperty, *Fixture, IsNegative);
+		});
+		Add(TEXT("MaxElementIndex"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericMaxElementIndex(Work, ArrayProperty,
+			                                               *Fixture, Less);
+		});
+		Add(TEXT("MinElementIndex"), Variant, NoSetup, [&] {
+			MinIndex = UUdonArrayUtilsLibrary::GenericMinElementIndex(
+			    Work, ArrayProperty, *Fixture, Less);
+		});
+		CheckResults(Variant);
+
+		Add(TEXT("RemoveIf"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericRemoveIf(Work, ArrayProperty,
+			                                        *Fixture, IsEven);
+		});
+		Add(TEXT("UnstableRemoveIf"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericUnstableRemoveIf(Work, ArrayProperty,
+			                                                *Fixture, IsEven);
+		});
+		Test.TestEqual(FString::Printf(TEXT("%s RemoveIf"), Variant),
+		               Arrays.Work.Num(), Num - Count);
+	}
+
+	// native predicates
+	{
+		// look the predicates up once, outside the timed bodies
+		const auto* const Variant    = TEXT("Native");
+		const auto        IsEven     = Arrays.FindNative(TEXT("IsEven"), 1);
+		const auto        IsNegative = Arrays.FindNative(TEXT("IsNegative"), 1);
+		const auto        IsNonNegative =
+		    Arrays.FindNative(TEXT("IsNonNegative"), 1);
+		const auto Less = Arrays.FindNative(TEXT("Less"), 2);
+
+		Add(TEXT("CountIf"), Variant, NoSetup, [&] {
+			Count = UUdonArrayUtilsLibrary::GenericCountIf(
+			    Work, ArrayProperty, *IsEven);
+		});
+		Add(TEXT("FindIf"), Variant, NoSetup, [&] {
+			FoundIndex = UUdonArrayUtilsLibrary::GenericFindIf(
+			    Work, ArrayProperty, *IsNegative);
+		});
+		Add(TEXT("AllSatisfy"), Variant, NoSetup, [&] {
+			bAll = UUdonArrayUtilsLibrary::GenericAllSatisfy(
+			    Work, ArrayProperty, *IsNonNegative);
+		});
+		Add(TEXT("AnySatisfy"), Variant, NoSetup, [&] {
+			bAny = UUdonArrayUtilsLibrary::GenericAnySatisfy(
+			    Work, ArrayProperty, *IsNegative);
+		});
+		Add(TEXT("NoneSatisfy"), Variant, NoSetup, [&] {
+			bNone = UUdonArrayUtilsLibrary::GenericNoneSatisfy(
+			    Work, ArrayProperty, *IsNegative);
+		});
+		Add(TEXT("MaxElementIndex"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+			    Work, ArrayProperty, *Less);
+		});
+		Add(TEXT("MinElementIndex"), Variant, NoSetup, [&] {
+			MinIndex = UUdonArrayUtilsLibrary::GenericMinElementIndex(
+			    Work, ArrayProperty, *Less);
+		});
+		CheckResults(Variant);
+
+		Add(TEXT("RemoveIf"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericRemoveIf(
+			    Work, ArrayProperty, *IsEven);
+		});
+		Add(TEXT("UnstableRemoveIf"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericUnstableRemoveIf(
+			    Work, ArrayProperty, *IsEven);
+		});
+		Test.TestEqual(TEXT("Native RemoveIf"), Arrays.Work.Num(), Num - Count);
+	}
+
+	// no comparison function (the values of the elements are compared)
+	if constexpr (FElement::bHasNaturalOrder) {
+		const auto* const Variant = TEXT("Natural");
+		Add(TEXT("MaxElementIndex"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+			    Work, ArrayProperty, EUdonNaturalOrder::CaseInsensitive);
+		});
+		Add(TEXT("MinElementIndex"), Variant, NoSetup, [&] {
+			MinIndex = UUdonArrayUtilsLibrary::GenericMinElementIndex(
+			    Work, ArrayProperty, EUdonNaturalOrder::CaseInsensitive);
+		});
+		Test.TestEqual(TEXT("Natural MinElementIndex"), MinIndex, Num - 1);
+	}
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUdonArrayUtilsPredicateBenchmark,
+                                  "UdonArrayUtils.Benchmarks.Predicates",
+                                  UDON_ARRAY_UTILS_BENCHMARK_FLAGS)
+
+void FUdonArrayUtilsPredicateBenchmark::GetTests(
+    TArray<FString>& OutBeautifiedNames,
+    TArray<FString>& OutTestCommands) const {
+	udon::GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUdonArrayUtilsPredicateBenchmark::RunTest(const FString& Parameters) {
+	using namespace udon;
+
+	FString ElementType;
+	int32   Num = 0;
+	if (!ParseBenchmarkTest(Parameters, ElementType, Num)) {
+		AddError(FString::Printf(TEXT("Invalid parameters: %s"), *Parameters));
+		return false;
+	}
+
+	auto& Report = FBenchmarkReport::Get(TEXT("Predicates"));
+	DispatchBenchmarkElementType(ElementType, [&](const auto Element) {
+		MeasurePredicates<std::decay_t<decltype(Element)>>(*this, Report, Num);
+	});
+
+	return Report.Write();
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+/**
+ * The removal RemoveIf used to do: every matching element is removed by
+ * RemoveValues(i, 1), which moves the whole tail of the array down, so that
+ * removing half of the elements moves about Num * Num / 4 elements.
+ */
+template <class T>
+void RemoveIfPerElement(TArray<T>& TargetArray,
+                        const FArrayProperty& ArrayProperty) {
+	FScriptArrayHelper ArrayHelper(&ArrayProperty, &TargetArray);
+	for (auto i = 0; i < ArrayHelper.Num(); ++i) {
+		// if the element satisfies the predicate
+		if (TBenchmarkElement<T>::IsEven(
+		        *reinterpret_cast<const T*>(ArrayHelper.GetRawPtr(i)))) {
+			ArrayHelper.RemoveValues(i, 1);
+			--i;
+		}
+	}
+}
+
+/**
+ * Measures how RemoveIf scales with the size of the array, removing about
+ * half of Num elements of type T: the old per-element removal against the
+ * one-pass compaction of RemoveIf and the swap-removal of UnstableRemoveIf.
+ * The same native predicate is used by all, so that the results differ only
+ * by how the elements are removed.
+ */
+template <class T>
+void MeasureRemoveIfScaling(FAutomationTestBase& Test,
+                            FBenchmarkReport& Report, const int32 Num) {
+	using FElement = TBenchmarkElement<T>;
+
+	// the source and work arrays
+	const auto BytesPerElement = (sizeof(T) + FElement::HeapBytes) * 2;
+	if (!ShouldMeasure(Num, BytesPerElement, false)) {
+		Test.AddInfo(TEXT("Skipped: the arrays exceed the memory limit."));
+		return;
+	}
+
+	const TStrongObjectPtr<UUdonArrayUtilsBenchmarkFixture> Fixture(
+	    NewObject<UUdonArrayUtilsBenchmarkFixture>());
+	TBenchmarkArrays<T> Arrays(*Fixture, Num);
+	auto* const         Work          = &Arrays.Work;
+	const auto&         ArrayProperty = Arrays.ArrayProperty;
+	const auto          IsEven        = Arrays.FindNative(TEXT("IsEven"), 1);
+
+	const auto Reset = [&Arrays] { Arrays.Reset(); };
+
+	// measure Body, and add the result
+	const auto Add = [&](const TCHAR* const Variant, TFunctionRef<void()> Body) {
+		Report.Add(Measure(TEXT("RemoveIf"), FElement::TypeName, Variant, Num,
+		                   Reset, Body));
+	};
+
+	// the number of elements that must remain
+	const auto NumRemaining =
+	    Num - UUdonArrayUtilsLibrary::GenericCountIf(Work, ArrayProperty, *IsEven);
+
+	// the old removal, as long as it finishes in reasonable time
+	if (ShouldMeasureQuadratic(Num, sizeof(T))) {
+		Add(TEXT("PerElementRemoveValues"),
+		    [&] { RemoveIfPerElement(Arrays.Work, ArrayProperty); });
+		Test.TestEqual(TEXT("PerElementRemoveValues"), Arrays.Work.Num(),
+		               NumRemaining);
+	} else {
+		Test.AddInfo(TEXT("Skipped PerElementRemoveValues: it would move more "
+		                  "memory than MaxQuadraticGB."));
+	}
+
+	Add(TEXT("Compaction"), [&] {
+		UUdonArrayUtilsLibrary::GenericRemoveIf(Work, ArrayProperty, *IsEven);
+	});
+	Test.TestEqual(TEXT("Compaction"), Arrays.Work.Num(), NumRemaining);
+
+	Add(TEXT("SwapRemove"), [&] {
+		UUdonArrayUtilsLibrary::GenericUnstableRemoveIf(Work, ArrayProperty,
+		                                                *IsEven);
+	});
+	Test.TestEqual(TEXT("SwapRemove"), Arrays.Work.Num(), NumRemaining);
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUdonArrayUtilsRemoveIfScalingBenchmark,
+                                  "UdonArrayUtils.Benchmarks.RemoveIfScaling",
+                                  UDON_ARRAY_UTILS_BENCHMARK_FLAGS)
+
+void FUdonArrayUtilsRemoveIfScalingBenchmark::GetTests(
+    TArray<FString>& OutBeautifiedNames,
+    TArray<FString>& OutTestCommands) const {
+	udon::GetBenchmarkTests(OutBeautifiedNames, OutTestCommands, true);
+}
+
+bool FUdonArrayUtilsRemoveIfScalingBenchmark::RunTest(
+    const FString& Parameters) {
+	using namespace udon;
+
+	FString ElementType;
+	int32   Num = 0;
+	if (!ParseBenchmarkTest(Parameters, ElementType, Num)) {
+		AddError(FString::Printf(TEXT("Invalid parameters: %s"), *Parameters));
+		return false;
+	}
+
+	auto& Report = FBenchmarkReport::Get(TEXT("RemoveIfScaling"));
+	DispatchBenchmarkElementType(ElementType, [&](const auto Element) {
+		MeasureRemoveIfScaling<std::decay_t<decltype(Element)>>(*this, Report,
+		                                                        Num);
+	});
+
+	return Report.Write();
+}
+
+#endif
@@ -0,0 +1,205 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Algo/IsSorted.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsBenchmarkRunner.h"
+
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+/**
+ * Measures the sorts on arrays of Num elements of type T, calling the
+ * comparison functions through their thunks, through ProcessEvent and as
+ * native predicates, and ordering the elements by their values.
+ */
+template <class T>
+void MeasureSorts(FAutomationTestBase& Test, FBenchmarkReport& Report,
+                  const int32 Num) {
+	using FElement = TBenchmarkElement<T>;
+
+	// the source and work arrays, and the scratch of the stable sort
+	const auto BytesPerElement = (sizeof(T) + FElement::HeapBytes) * 3;
+	if (!ShouldMeasure(Num, BytesPerElement, false)) {
+		Test.AddInfo(TEXT("Skipped: the arrays exceed the memory limit."));
+		return;
+	}
+
+	const TStrongObjectPtr<UUdonArrayUtilsBenchmarkFixture> Fixture(
+	    NewObject<UUdonArrayUtilsBenchmarkFixture>());
+	TBenchmarkArrays<T> Arrays(*Fixture, Num);
+	auto* const         Work          = &Arrays.Work;
+	const auto&         ArrayProperty = Arrays.ArrayProperty;
+
+	const auto NoSetup = [] {};
+	const auto Reset   = [&Arrays] { Arrays.Reset(); };
+
+	// measure Body with Setup, and add the result
+	const auto Add = [&](const TCHAR* const Operation,
+	                     const TCHAR* const Variant, TFunctionRef<void()> Setup,
+	                     TFunctionRef<void()> Body) {
+		Report.Add(
+		    Measure(Operation, FElement::TypeName, Variant, Num, Setup, Body));
+	};
+
+	// check that the last iteration sorted the work array
+	const auto CheckSorted = [&](const TCHAR* const Operation,
+	                             const TCHAR* const Variant) {
+		Test.TestTrue(FString::Printf(TEXT("%s %s"), Operation, Variant),
+		              Algo::IsSorted(Arrays.Work, &FElement::Less));
+	};
+
+	// check that the last iteration returned the indices in sorted order
+	TArray<int32> SortedIndices;
+	const auto    IndexLess = [&](const int32 A, const int32 B) {
+		return FElement::Less(Arrays.Source[A], Arrays.Source[B]);
+	};
+	const auto CheckSortedIndices = [&](const TCHAR* const Variant) {
+		Test.TestTrue(FString::Printf(TEXT("GetSortedIndices %s"), Variant),
+		              SortedIndices.Num() == Num &&
+		                  Algo::IsSorted(SortedIndices, IndexLess));
+	};
+
+	// comparison functions called through their thunks or through ProcessEvent
+	for (const auto bProcessEvent : {false, true}) {
+		if (!ShouldMeasure(Num, BytesPerElement, bProcessEvent)) {
+			Test.AddInfo(TEXT("Skipped ProcessEvent: the array exceeds "
+			                  "MaxProcessEventNum."));
+			continue;
+		}
+
+		const auto* const Variant =
+		    bProcessEvent ? TEXT("ProcessEvent") : TEXT("Thunk");
+		auto& Less = Arrays.FindFunction(TEXT("Less"), bProcessEvent);
+
+		Add(TEXT("SortAnyArray"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericSortAnyArray(Work, ArrayProperty,
+			                                            *Fixture, Less);
+		});
+		CheckSorted(TEXT("SortAnyArray"), Variant);
+
+		Add(TEXT("StableSortAnyArray"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Fixture, Less, false);
+		});
+		CheckSorted(TEXT("StableSortAnyArray"), Variant);
+
+		// sorting an already sorted array, where the adaptive sort finds a
+		// single run
+		Add(TEXT("StableSortAnyArraySorted"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Fixture, Less, false);
+		});
+		Add(TEXT("StableSortAnyArrayAdaptiveSorted"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Fixture, Less, true);
+		});
+		CheckSorted(TEXT("StableSortAnyArrayAdaptiveSorted"), Variant);
+
+		Reset();
+		Add(TEXT("GetSortedIndices"), Variant, NoSetup, [&] {
+			SortedIndices = UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+			    Work, ArrayProperty, *Fixture, Less);
+		});
+		CheckSortedIndices(Variant);
+	}
+
+	// native comparison functions
+	{
+		const auto* const Variant = TEXT("Native");
+		const auto        Less    = Arrays.FindNative(TEXT("Less"), 2);
+
+		Add(TEXT("SortAnyArray"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericSortAnyArray(Work, ArrayProperty,
+			                                            *Less);
+		});
+		CheckSorted(TEXT("SortAnyArray"), Variant);
+
+		Add(TEXT("StableSortAnyArray"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Less, false);
+		});
+		CheckSorted(TEXT("StableSortAnyArray"), Variant);
+
+		Add(TEXT("StableSortAnyArraySorted"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Less, false);
+		});
+		Add(TEXT("StableSortAnyArrayAdaptiveSorted"), Variant, NoSetup, [&] {
+			UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+			    Work, ArrayProperty, *Less, true);
+		});
+		CheckSorted(TEXT("StableSortAnyArrayAdaptiveSorted"), Variant);
+
+		Reset();
+		Add(TEXT("GetSortedIndices"), Variant, NoSetup, [&] {
+			SortedIndices = UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+			    Work, ArrayProperty, *Less);
+		});
+		CheckSortedIndices(Variant);
+	}
+
+	// no comparison function (the values of the elements are compared)
+	if constexpr (FElement::bHasNaturalOrder) {
+		const auto* const Variant = TEXT("Natural");
+
+		Add(TEXT("SortAnyArray"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericSortAnyArray(
+			    Work, ArrayProperty, EUdonNaturalOrder::CaseSensitive);
+		});
+		CheckSorted(TEXT("SortAnyArray"), Variant);
+
+		Reset();
+		Add(TEXT("GetSortedIndices"), Variant, NoSetup, [&] {
+			SortedIndices = UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+			    Work, ArrayProperty);
+		});
+		CheckSortedIndices(Variant);
+	}
+
+	// the key read through a property path
+	{
+		const auto* const Variant = TEXT("Property");
+
+		Add(TEXT("SortByProperty"), Variant, Reset, [&] {
+			UUdonArrayUtilsLibrary::GenericSortByProperty(
+			    Work, ArrayProperty, FElement::KeyPath, false);
+		});
+		CheckSorted(TEXT("SortByProperty"), Variant);
+	}
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUdonArrayUtilsSortBenchmark,
+                                  "UdonArrayUtils.Benchmarks.Sort",
+                                  UDON_ARRAY_UTILS_BENCHMARK_FLAGS)
+
+void FUdonArrayUtilsSortBenchmark::GetTests(
+    TArray<FString>& OutBeautifiedNames,
+    TArray<FString>& OutTestCommands) const {
+	udon::GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUdonArrayUtilsSortBenchmark::RunTest(const FString& Parameters) {
+	using namespace udon;
+
+	FString ElementType;
+	int32   Num = 0;
+	if (!ParseBenchmarkTest(Parameters, ElementType, Num)) {
+		AddError(FString::Printf(TEXT("Invalid parameters: %s"), *Parameters));
+		return false;
+	}
+
+	auto& Report = FBenchmarkReport::Get(TEXT("Sort"));
+	DispatchBenchmarkElementType(ElementType, [&](const auto Element) {
+		MeasureSorts<std::decay_t<decltype(Element)>>(*this, Report, Num);
+	});
+
+	return Report.Write();
+}
+
+#endif
@@ -0,0 +1,23 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class UdonArrayUtilsBenchmarks : ModuleRules
+{
+    public UdonArrayUtilsBenchmarks(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "Json",
+                "NetCore",
+                "UdonArrayUtils",
+            }
+            );
+    }
+}
@@ -0,0 +1,196 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Algo/AnyOf.h"
+#include "Algo/Compare.h"
+#include "Algo/StableSort.h"
+#include "CompareString.h"
+#include "Misc/AutomationTest.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+// whether two elements are the same, respecting the case of strings
+template <class T>
+bool IsIdentical(const T& A, const T& B) {
+	return A == B;
+}
+
+bool IsIdentical(const FString& A, const FString& B) {
+	return A.Equals(B, ESearchCase::CaseSensitive);
+}
+
+bool IsIdentical(const FName& A, const FName& B) {
+	return A.IsEqual(B, ENameCase::CaseSensitive);
+}
+
+/**
+ * Checks that Max, Min and Sort without a comparison function order Array
+ * like the comparison function Less.
+ */
+template <class T, class LessT>
+void TestNaturalOrder(FAutomationTestBase& Test, const FString& What,
+                      const TArray<T>&         Array,
+                      const FArrayProperty&    ArrayProperty,
+                      const EUdonNaturalOrder  Order, LessT Less) {
+	// no element is greater than the maximum
+	const auto MaxIndex = UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+	    &Array, ArrayProperty, Order);
+	Test.TestTrue(What + TEXT(" MaxElementIndex"),
+	              Array.IsValidIndex(MaxIndex) &&
+	                  !Algo::AnyOf(Array, [&](const T& Element) {
+		                  return Less(Array[MaxIndex], Element);
+	                  }));
+	Test.TestTrue(What + TEXT(" Max"),
+	              Array.IsValidIndex(MaxIndex) &&
+	                  UUdonArrayUtilsLibrary::GenericMax(
+	                      &Array, ArrayProperty, Order) == &Array[MaxIndex]);
+
+	// no element is less than the minimum
+	const auto MinIndex = UUdonArrayUtilsLibrary::GenericMinElementIndex(
+	    &Array, ArrayProperty, Order);
+	Test.TestTrue(What + TEXT(" MinElementIndex"),
+	              Array.IsValidIndex(MinIndex) &&
+	                  !Algo::AnyOf(Array, [&](const T& Element) {
+		                  return Less(Element, Array[MinIndex]);
+	                  }));
+	Test.TestTrue(What + TEXT(" Min"),
+	              Array.IsValidIndex(MinIndex) &&
+	                  UUdonArrayUtilsLibrary::GenericMin(
+	                      &Array, ArrayProperty, Order) == &Array[MinIndex]);
+
+	// the sort is stable, so the result is exactly that of a stable sort
+	auto Sorted = Array;
+	UUdonArrayUtilsLibrary::GenericSortAnyArray(&Sorted, ArrayProperty, Order);
+	auto Expected = Array;
+	Algo::StableSort(Expected, Less);
+	Test.TestTrue(What + TEXT(" SortAnyArray"),
+	              Algo::Compare(Sorted, Expected, [](const T& A, const T& B) {
+		              return IsIdentical(A, B);
+	              }));
+}
+
+// the orders of strings and the comparison functions they must match
+struct FStringOrder {
+	EUdonNaturalOrder Order;
+	const TCHAR*      Name;
+	bool (*Less)(const FString&, const FString&);
+};
+
+const FStringOrder StringOrders[] = {
+    {EUdonNaturalOrder::CaseSensitive, TEXT("CaseSensitive"),
+     &UUdonCompareString::Less_StrStr},
+    {EUdonNaturalOrder::CaseInsensitive, TEXT("CaseInsensitive"),
+     &UUdonCompareString::Less_StriStri},
+};
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNaturalOrderStringsTest,
+                                 "UdonArrayUtils.NaturalOrder.Strings",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNaturalOrderStringsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// strings that differ only in case, digits, and an empty string
+	const TArray<FString> Strings = {
+	    TEXT("banana"), TEXT("Apple"), TEXT("apple"), TEXT("Cherry"),
+	    TEXT("10"),     TEXT("9"),     TEXT("Zebra"), TEXT("zebra"),
+	    TEXT("b"),      TEXT("B"),     TEXT("")};
+	const auto& ArrayProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Strings));
+
+	for (const auto& StringOrder : StringOrders) {
+		TestNaturalOrder(*this, StringOrder.Name, Strings, ArrayProperty,
+		                 StringOrder.Order, StringOrder.Less);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNaturalOrderNamesTest,
+                                 "UdonArrayUtils.NaturalOrder.Names",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNaturalOrderNamesTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// names that differ in the case of their first letters. names that
+	// differ only in case are the same name, so they aren't used.
+	const TArray<FName> Names = {TEXT("Banana"), TEXT("apple"), TEXT("Cherry"),
+	                             TEXT("zebra"),  TEXT("Mango"), TEXT("delta")};
+	const auto& ArrayProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Names));
+
+	// names are ordered like their strings
+	for (const auto& StringOrder : StringOrders) {
+		TestNaturalOrder(*this, StringOrder.Name, Names, ArrayProperty,
+		                 StringOrder.Order,
+		                 [&StringOrder](const FName& A, const FName& B) {
+			                 return StringOrder.Less(A.ToString(), B.ToString());
+		                 });
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNaturalOrderNumbersTest,
+                                 "UdonArrayUtils.NaturalOrder.Numbers",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNaturalOrderNumbersTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// numbers are ordered by value, whatever the order of strings is
+	const TArray<int32> Ints = {3,  -7, 42, 0,
+	                            -7, 42, TNumericLimits<int32>::Lowest(),
+	                            TNumericLimits<int32>::Max()};
+	TestNaturalOrder(*this, TEXT("int32"), Ints,
+	                 UUdonArrayUtilsTestFixture::GetArrayProperty(
+	                     GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture,
+	                                             Ints)),
+	                 EUdonNaturalOrder::CaseSensitive,
+	                 [](const int32 A, const int32 B) { return A < B; });
+
+	const TArray<float> Floats = {1.5f, -0.25f, 3e7f, -1e-3f, 0.0f, 100.0f};
+	TestNaturalOrder(*this, TEXT("float"), Floats,
+	                 UUdonArrayUtilsTestFixture::GetArrayProperty(
+	                     GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture,
+	                                             Floats)),
+	                 EUdonNaturalOrder::CaseInsensitive,
+	                 [](const float A, const float B) { return A < B; });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNaturalOrderEmptyTest,
+                                 "UdonArrayUtils.NaturalOrder.Empty",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNaturalOrderEmptyTest::RunTest(const FString&) {
+	const TArray<FString> Strings;
+	const auto& ArrayProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Strings));
+
+	TestEqual(TEXT("MaxElementIndex"),
+	          UUdonArrayUtilsLibrary::GenericMaxElementIndex(
+	              &Strings, ArrayProperty, EUdonNaturalOrder::CaseSensitive),
+	          INDEX_NONE);
+	TestEqual(TEXT("MinElementIndex"),
+	          UUdonArrayUtilsLibrary::GenericMinElementIndex(
+	              &Strings, ArrayProperty, EUdonNaturalOrder::CaseSensitive),
+	          INDEX_NONE);
+	TestNull(TEXT("Max"), UUdonArrayUtilsLibrary::GenericMax(
+	                          &Strings, ArrayProperty,
+	                          EUdonNaturalOrder::CaseSensitive));
+	TestNull(TEXT("Min"), UUdonArrayUtilsLibrary::GenericMin(
+	                          &Strings, ArrayProperty,
+	                          EUdonNaturalOrder::CaseSensitive));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,371 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonRandomStream.h"
+
+#include <limits>
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+const FArrayProperty& GetIntsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Ints));
+}
+
+const FArrayProperty& GetInt64sProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Int64s));
+}
+
+const FArrayProperty& GetFloatsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Floats));
+}
+
+const FArrayProperty& GetDoublesProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Doubles));
+}
+
+const FArrayProperty& GetVectorsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Vectors));
+}
+
+// sizes with and without a tail after the blocks of four SIMD lanes
+const int32 Sizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 13, 64, 67};
+
+/**
+ * Makes a random value from -400 to 400, in steps of 0.25 for floating
+ * points. Sums and products of such values are exact, so that the results of
+ * the SIMD lanes equal those of a scalar loop in any order.
+ */
+template <class T>
+T MakeValue(FRandomEngine& Engine) {
+	const auto Value = static_cast<int32>(Engine.NextBelow(801)) - 400;
+	if constexpr (std::is_floating_point_v<T>) {
+		return static_cast<T>(Value) * static_cast<T>(0.25);
+	} else {
+		return static_cast<T>(Value);
+	}
+}
+
+// make Num values with MakeValue
+template <class T>
+TArray<T> MakeValues(const int32 Num, const uint64 Seed) {
+	FRandomEngine Engine(Seed);
+	TArray<T>     Values;
+	Values.SetNumUninitialized(Num);
+	for (auto& Value : Values) {
+		Value = MakeValue<T>(Engine);
+	}
+	return Values;
+}
+
+// the sum of Values in a scalar loop
+template <class T>
+T SumScalar(const TArray<T>& Values) {
+	auto Sum = static_cast<T>(0);
+	for (const auto& Value : Values) {
+		Sum += Value;
+	}
+	return Sum;
+}
+
+/**
+ * Checks that Sum and DotProduct of arrays of each size equal the results of
+ * scalar loops.
+ */
+template <class T>
+void TestSumAndDotProduct(FAutomationTestBase&  Test,
+                          const TCHAR* const    TypeName,
+                          const FArrayProperty& ArrayProperty) {
+	for (const auto Num : Sizes) {
+		const auto What = FString::Printf(TEXT("%d %s"), Num, TypeName);
+		const auto A    = MakeValues<T>(Num, Num);
+		const auto B    = MakeValues<T>(Num, Num + 100);
+
+		auto Result = static_cast<T>(-1);
+		Test.TestTrue(What + TEXT(", Sum supported"),
+		              UUdonArrayUtilsLibrary::GenericSum(&A, ArrayProperty,
+		                                                 &Result));
+		Test.TestEqual(What + TEXT(", Sum"), Result, SumScalar(A));
+
+		auto Expected = 0.0;
+		for (auto i = 0; i < Num; ++i) {
+			Expected += static_cast<double>(A[i]) * static_cast<double>(B[i]);
+		}
+		auto Dot = -1.0;
+		Test.TestTrue(What + TEXT(", DotProduct supported"),
+		              UUdonArrayUtilsLibrary::GenericDotProduct(
+		                  &A, &B, ArrayProperty, Dot));
+		Test.TestEqual(What + TEXT(", DotProduct"), Dot, Expected);
+	}
+}
+
+// the sum of Values by Sum
+template <class T>
+T SumOf(const TArray<T>& Values, const FArrayProperty& ArrayProperty) {
+	auto Result = static_cast<T>(0);
+	UUdonArrayUtilsLibrary::GenericSum(&Values, ArrayProperty, &Result);
+	return Result;
+}
+
+// the average of Values by Average
+template <class T>
+T AverageOf(const TArray<T>& Values, const FArrayProperty& ArrayProperty) {
+	auto Result = static_cast<T>(0);
+	UUdonArrayUtilsLibrary::GenericAverage(&Values, ArrayProperty, &Result);
+	return Result;
+}
+
+/**
+ * Finds the first minimum and maximum in a scalar loop, ignoring NaNs unless
+ * all values are NaN (both indices are then 0).
+ */
+template <class T>
+void MinMaxScalar(const TArray<T>& Values, int32& OutMinIndex,
+                  int32& OutMaxIndex) {
+	OutMinIndex = OutMaxIndex = INDEX_NONE;
+	for (auto i = 0; i < Values.Num(); ++i) {
+		if constexpr (std::is_floating_point_v<T>) {
+			if (FMath::IsNaN(Values[i])) {
+				continue;
+			}
+		}
+		if (OutMinIndex == INDEX_NONE || Values[i] < Values[OutMinIndex]) {
+			OutMinIndex = i;
+		}
+		if (OutMaxIndex == INDEX_NONE || Values[OutMaxIndex] < Values[i]) {
+			OutMaxIndex = i;
+		}
+	}
+	if (OutMinIndex == INDEX_NONE && Values.Num() > 0) {
+		OutMinIndex = OutMaxIndex = 0;
+	}
+}
+
+/**
+ * Makes a random value from a few, so that many values are equal. Floating
+ * points are NaN one time in five, and zeros are -0 half of the time.
+ */
+template <class T>
+T MakeMinMaxValue(FRandomEngine& Engine) {
+	const auto Value = static_cast<int32>(Engine.NextBelow(9)) - 4;
+	if constexpr (std::is_floating_point_v<T>) {
+		if (Engine.NextBelow(5) == 0) {
+			return std::numeric_limits<T>::quiet_NaN();
+		}
+		if (Value == 0 && Engine.NextBelow(2) == 0) {
+			return static_cast<T>(-0.0);
+		}
+		return static_cast<T>(Value) * static_cast<T>(0.5);
+	} else if constexpr (sizeof(T) == sizeof(int64)) {
+		// values that differ only in the high half
+		return static_cast<T>(Value) * (T{1} << 40) + 3;
+	} else {
+		return static_cast<T>(Value);
+	}
+}
+
+// check that MinMax finds the indices MinMaxScalar finds in random arrays
+template <class T>
+void TestMinMax(FAutomationTestBase& Test, const TCHAR* const TypeName,
+                const FArrayProperty& ArrayProperty) {
+	for (const auto Num : Sizes) {
+		for (auto Seed = 0; Seed < 10; ++Seed) {
+			FRandomEngine Engine(Num * 100 + Seed);
+			TArray<T>     Values;
+			for (auto i = 0; i < Num; ++i) {
+				Values.Add(MakeMinMaxValue<T>(Engine));
+			}
+
+			int32 ExpectedMinIndex;
+			int32 ExpectedMaxIndex;
+			MinMaxScalar(Values, ExpectedMinIndex, ExpectedMaxIndex);
+
+			int32 MinIndex = -2;
+			int32 MaxIndex = -2;
+			UUdonArrayUtilsLibrary::GenericMinMax(&Values, ArrayProperty,
+			                                      MinIndex, MaxIndex);
+
+			const auto What =
+			    FString::Printf(TEXT("%d %s, seed %d"), Num, TypeName, Seed);
+			Test.TestEqual(What + TEXT(", min"), MinIndex, ExpectedMinIndex);
+			Test.TestEqual(What + TEXT(", max"), MaxIndex, ExpectedMaxIndex);
+		}
+	}
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNumericSumTest,
+                                 "UdonArrayUtils.Numeric.Sum",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNumericSumTest::RunTest(const FString&) {
+	using namespace udon;
+
+	TestSumAndDotProduct<int32>(*this, TEXT("int32s"), GetIntsProperty());
+	TestSumAndDotProduct<int64>(*this, TEXT("int64s"), GetInt64sProperty());
+	TestSumAndDotProduct<float>(*this, TEXT("floats"), GetFloatsProperty());
+	TestSumAndDotProduct<double>(*this, TEXT("doubles"), GetDoublesProperty());
+
+	// vectors are summed in blocks of four (twelve components), and the
+	// components of the lanes are gathered at the end
+	for (const auto Num : Sizes) {
+		FRandomEngine   Engine(Num);
+		TArray<FVector> Vectors;
+		for (auto i = 0; i < Num; ++i) {
+			const auto X = MakeValue<double>(Engine);
+			const auto Y = MakeValue<double>(Engine);
+			const auto Z = MakeValue<double>(Engine);
+			Vectors.Emplace(X, Y, Z);
+		}
+
+		const auto What = FString::Printf(TEXT("%d vectors"), Num);
+		TestEqual(What + TEXT(", Sum"), SumOf(Vectors, GetVectorsProperty()),
+		          SumScalar(Vectors));
+
+		auto Expected = 0.0;
+		for (const auto& Vector : Vectors) {
+			Expected += Vector | Vector;
+		}
+		auto Result = -1.0;
+		UUdonArrayUtilsLibrary::GenericDotProduct(&Vectors, &Vectors,
+		                                          GetVectorsProperty(), Result);
+		TestEqual(What + TEXT(", DotProduct"), Result, Expected);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNumericOverflowTest,
+                                 "UdonArrayUtils.Numeric.Overflow",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNumericOverflowTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// int32 sums are clamped to the range of int32
+	TestEqual(TEXT("int32 Sum above the range"),
+	          SumOf<int32>({MAX_int32, 1, MAX_int32}, GetIntsProperty()),
+	          MAX_int32);
+	TestEqual(TEXT("int32 Sum below the range"),
+	          SumOf<int32>({MIN_int32, -1, MIN_int32}, GetIntsProperty()),
+	          MIN_int32);
+	TestEqual(TEXT("int32 Sum back in the range"),
+	          SumOf<int32>({MAX_int32, MAX_int32, MIN_int32, MIN_int32, 5},
+	                     GetIntsProperty()),
+	          3);
+
+	// int64 sums wrap around
+	TestEqual(TEXT("int64 Sum above the range"),
+	          SumOf<int64>({MAX_int64, 1}, GetInt64sProperty()), MIN_int64);
+	TestEqual(TEXT("int64 Sum below the range"),
+	          SumOf<int64>({MIN_int64, -2}, GetInt64sProperty()),
+	          MAX_int64 - 1);
+
+	// averages are exact even if the sums overflow
+	TestEqual(TEXT("int32 Average above the range"),
+	          AverageOf<int32>({MAX_int32, MAX_int32, MAX_int32 - 3},
+	                         GetIntsProperty()),
+	          MAX_int32 - 1);
+	TestEqual(TEXT("int64 Average above the range"),
+	          AverageOf<int64>({MAX_int64, MAX_int64, MAX_int64 - 3},
+	                         GetInt64sProperty()),
+	          MAX_int64 - 1);
+	TestEqual(TEXT("int64 Average below the range"),
+	          AverageOf<int64>({MIN_int64, MIN_int64, MIN_int64 + 4},
+	                         GetInt64sProperty()),
+	          MIN_int64 + 1);
+	TestEqual(TEXT("int64 Average of both ends"),
+	          AverageOf<int64>({MAX_int64, MIN_int64, MAX_int64, MIN_int64},
+	                         GetInt64sProperty()),
+	          int64{0});
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNumericNegativeAverageTest,
+                                 "UdonArrayUtils.Numeric.NegativeAverage",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNumericNegativeAverageTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// integer averages are rounded toward zero, like integer divisions
+	TestEqual(TEXT("int32 -7 / 2"),
+	          AverageOf<int32>({-3, -4}, GetIntsProperty()), -3);
+	TestEqual(TEXT("int32 -5 / 3"),
+	          AverageOf<int32>({-1, -2, -2}, GetIntsProperty()), -1);
+	TestEqual(TEXT("int32 -1 / 2"),
+	          AverageOf<int32>({-5, 4}, GetIntsProperty()), 0);
+	TestEqual(TEXT("int64 -7 / 2"),
+	          AverageOf<int64>({-3, -4}, GetInt64sProperty()), int64{-3});
+	TestEqual(TEXT("int64 -5 / 3"),
+	          AverageOf<int64>({-1, -2, -2}, GetInt64sProperty()), int64{-1});
+	TestEqual(TEXT("int64 -1 / 2"),
+	          AverageOf<int64>({-5, 4}, GetInt64sProperty()), int64{0});
+
+	// averages of arrays with a tail after the blocks of four SIMD lanes
+	TestEqual(TEXT("float"),
+	          AverageOf<float>({-1.0f, -2.0f, -3.0f, -4.0f, -5.5f},
+	                         GetFloatsProperty()),
+	          -3.1f);
+	TestEqual(TEXT("double"),
+	          AverageOf<double>({-1.0, -2.0, -3.0, -4.0, -5.0, -6.0, -8.0},
+	                          GetDoublesProperty()),
+	          -29.0 / 7.0);
+
+	// the average of no elements is zero
+	TestEqual(TEXT("Empty int64"), AverageOf<int64>({}, GetInt64sProperty()),
+	          int64{0});
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsNumericMinMaxTest,
+                                 "UdonArrayUtils.Numeric.MinMax",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsNumericMinMaxTest::RunTest(const FString&) {
+	using namespace udon;
+
+	TestMinMax<int32>(*this, TEXT("int32s"), GetIntsProperty());
+	TestMinMax<int64>(*this, TEXT("int64s"), GetInt64sProperty());
+	TestMinMax<float>(*this, TEXT("floats"), GetFloatsProperty());
+	TestMinMax<double>(*this, TEXT("doubles"), GetDoublesProperty());
+
+	// NaNs are ignored unless all elements are NaN
+	const auto NaN = std::numeric_limits<float>::quiet_NaN();
+	int32      MinIndex;
+	int32      MaxIndex;
+	const TArray<float> AllNaN = {NaN, NaN, NaN, NaN, NaN};
+	UUdonArrayUtilsLibrary::GenericMinMax(&AllNaN, GetFloatsProperty(),
+	                                      MinIndex, MaxIndex);
+	TestEqual(TEXT("All NaN, min"), MinIndex, 0);
+	TestEqual(TEXT("All NaN, max"), MaxIndex, 0);
+
+	const TArray<float> LastNumber = {NaN, NaN, NaN, NaN, NaN, 2.0f};
+	UUdonArrayUtilsLibrary::GenericMinMax(&LastNumber, GetFloatsProperty(),
+	                                      MinIndex, MaxIndex);
+	TestEqual(TEXT("Last number, min"), MinIndex, 5);
+	TestEqual(TEXT("Last number, max"), MaxIndex, 5);
+
+	// +0 and -0 are equal, so the first of them is found
+	const TArray<float> Zeros = {0.0f, -0.0f, 0.0f, -0.0f, 0.0f};
+	UUdonArrayUtilsLibrary::GenericMinMax(&Zeros, GetFloatsProperty(),
+	                                      MinIndex, MaxIndex);
+	TestEqual(TEXT("Zeros, min"), MinIndex, 0);
+	TestEqual(TEXT("Zeros, max"), MaxIndex, 0);
+
+	return true;
+}
+
+#endif
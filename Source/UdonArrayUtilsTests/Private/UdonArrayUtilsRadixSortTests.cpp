@@ -0,0 +1,285 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Algo/Compare.h"
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonRandomStream.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+const FArrayProperty& GetIntsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Ints));
+}
+
+const FArrayProperty& GetFloatsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Floats));
+}
+
+const FArrayProperty& GetDoublesProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Doubles));
+}
+
+const FArrayProperty& GetElementsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Elements));
+}
+
+// whether A precedes B in ascending order, where NaNs follow any other value
+template <class T>
+bool LessNaNLast(const T A, const T B) {
+	if constexpr (std::is_floating_point_v<T>) {
+		return !FMath::IsNaN(A) && (FMath::IsNaN(B) || A < B);
+	} else {
+		return A < B;
+	}
+}
+
+// whether A and B hold the same values, where NaNs equal each other
+template <class T>
+bool AreSameValues(const TArray<T>& A, const TArray<T>& B) {
+	return Algo::Compare(A, B, [](const T X, const T Y) {
+		return X == Y || (FMath::IsNaN(X) && FMath::IsNaN(Y));
+	});
+}
+
+/**
+ * Checks that sorting floating points by their values puts negative values
+ * before positive ones and NaNs last, or first if descending. The values are
+ * sorted once as they are, which is below the threshold of the radix sort,
+ * and once repeated 8 times, which is above it.
+ */
+template <class T>
+void TestFloatingPointOrder(FAutomationTestBase&  Test,
+                            const FArrayProperty& ArrayProperty) {
+	const auto NaN      = std::numeric_limits<T>::quiet_NaN();
+	const auto Infinity = std::numeric_limits<T>::infinity();
+
+	const TArray<T> Values = {
+	    3.5f, NaN, -1.0f, -Infinity, 0.0f, -2.5f,
+	    Infinity, NaN, -0.5f, 1e-30f, -1e-30f,
+	};
+	const TArray<T> Ascending = {
+	    -Infinity, -2.5f, -1.0f, -0.5f, -1e-30f, 0.0f,
+	    1e-30f, 3.5f, Infinity, NaN, NaN,
+	};
+
+	for (const auto NumRepeats : {1, 8}) {
+		TArray<T> Array;
+		TArray<T> Expected;
+		for (auto i = 0; i < NumRepeats; ++i) {
+			Array.Append(Values);
+		}
+		for (const auto Value : Ascending) {
+			for (auto i = 0; i < NumRepeats; ++i) {
+				Expected.Add(Value);
+			}
+		}
+
+		const auto What =
+		    FString::Printf(TEXT("%d %s"), Array.Num(),
+		                    sizeof(T) == sizeof(float) ? TEXT("floats")
+		                                               : TEXT("doubles"));
+
+		auto Sorted = Array;
+		UUdonArrayUtilsLibrary::GenericSortByProperty(&Sorted, ArrayProperty,
+		                                              FString(), false);
+		Test.TestTrue(What + TEXT(" ascending"),
+		              AreSameValues(Sorted, Expected));
+
+		Algo::Reverse(Expected);
+		Sorted = Array;
+		UUdonArrayUtilsLibrary::GenericSortByProperty(&Sorted, ArrayProperty,
+		                                              FString(), true);
+		Test.TestTrue(What + TEXT(" descending"),
+		              AreSameValues(Sorted, Expected));
+	}
+}
+
+/**
+ * Sorts Elements by the key at PropertyPath in both orders, and checks that
+ * the IDs are in the order std::stable_sort gives them.
+ */
+template <class KeyT>
+void TestSortByKey(FAutomationTestBase&                      Test,
+                   const FString&                            What,
+                   const TArray<FUdonArrayUtilsTestElement>& Elements,
+                   const TCHAR* const                        PropertyPath,
+                   KeyT FUdonArrayUtilsTestElement::*const   Key) {
+	for (const auto bDescending : {false, true}) {
+		auto Expected = Elements;
+		std::stable_sort(
+		    Expected.GetData(), Expected.GetData() + Expected.Num(),
+		    [&](const FUdonArrayUtilsTestElement& A,
+		        const FUdonArrayUtilsTestElement& B) {
+			    return bDescending ? LessNaNLast(B.*Key, A.*Key)
+			                       : LessNaNLast(A.*Key, B.*Key);
+		    });
+
+		auto Sorted = Elements;
+		UUdonArrayUtilsLibrary::GenericSortByProperty(
+		    &Sorted, GetElementsProperty(), PropertyPath, bDescending);
+
+		Test.TestTrue(
+		    FString::Printf(TEXT("%s by %s%s"), *What, PropertyPath,
+		                    bDescending ? TEXT(" descending") : TEXT("")),
+		    Algo::Compare(Sorted, Expected,
+		                  [](const FUdonArrayUtilsTestElement& A,
+		                     const FUdonArrayUtilsTestElement& B) {
+			                  return A.Id == B.Id;
+		                  }));
+	}
+}
+
+// sort Elements by each of their keys (see TestSortByKey)
+void TestSortByKeys(FAutomationTestBase& Test, const FString& What,
+                    const TArray<FUdonArrayUtilsTestElement>& Elements) {
+	TestSortByKey(Test, What, Elements, TEXT("Key"),
+	              &FUdonArrayUtilsTestElement::Key);
+	TestSortByKey(Test, What, Elements, TEXT("WideKey"),
+	              &FUdonArrayUtilsTestElement::WideKey);
+	TestSortByKey(Test, What, Elements, TEXT("FloatKey"),
+	              &FUdonArrayUtilsTestElement::FloatKey);
+	TestSortByKey(Test, What, Elements, TEXT("DoubleKey"),
+	              &FUdonArrayUtilsTestElement::DoubleKey);
+}
+
+/**
+ * Makes Num elements with IDs in index order, and keys drawn from a few
+ * negative and positive values, so that many keys are equal. Every 13th
+ * floating point key is NaN.
+ */
+TArray<FUdonArrayUtilsTestElement> MakeRandomElements(const int32  Num,
+                                                      const uint64 Seed) {
+	FRandomEngine                      Engine(Seed);
+	TArray<FUdonArrayUtilsTestElement> Elements;
+	Elements.SetNum(Num);
+	for (auto i = 0; i < Num; ++i) {
+		const auto Value = static_cast<int32>(Engine.NextBelow(40)) - 20;
+		const auto bNaN  = i % 13 == 0;
+
+		auto& Element   = Elements[i];
+		Element.Key     = Value;
+		Element.WideKey = Value * (int64{1} << 40) + Engine.NextBelow(3);
+		Element.FloatKey =
+		    bNaN ? std::numeric_limits<float>::quiet_NaN() : Value * 0.25f;
+		Element.DoubleKey =
+		    bNaN ? std::numeric_limits<double>::quiet_NaN() : Value * 0.125;
+		Element.Id = i;
+	}
+	return Elements;
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRadixSortFloatingPointsTest,
+                                 "UdonArrayUtils.RadixSort.FloatingPoints",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRadixSortFloatingPointsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	TestFloatingPointOrder<float>(*this, GetFloatsProperty());
+	TestFloatingPointOrder<double>(*this, GetDoublesProperty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRadixSortStabilityTest,
+                                 "UdonArrayUtils.RadixSort.Stability",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRadixSortStabilityTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// sizes around the threshold of the radix sort (64 keys), below which the
+	// keys are sorted by comparison
+	for (const auto Num : {2, 63, 64, 65, 1000}) {
+		TestSortByKeys(*this, FString::Printf(TEXT("%d elements"), Num),
+		               MakeRandomElements(Num, Num));
+	}
+
+	// the indices of equal elements stay in ascending order
+	const TArray<int32> Ints = {
+	    2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2,
+	    0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0,
+	    1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1,
+	};
+	TArray<int32> Expected;
+	for (const auto Value : {0, 1, 2}) {
+		for (auto i = 0; i < Ints.Num(); ++i) {
+			if (Ints[i] == Value) {
+				Expected.Add(i);
+			}
+		}
+	}
+	TestTrue(TEXT("GetSortedIndices"),
+	         UUdonArrayUtilsLibrary::GenericGetSortedIndices(
+	             &Ints, GetIntsProperty()) == Expected);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRadixSortUniformBytesTest,
+                                 "UdonArrayUtils.RadixSort.UniformBytes",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRadixSortUniformBytesTest::RunTest(const FString&) {
+	using namespace udon;
+
+	constexpr auto Num = 200;
+
+	// keys that differ in only one byte, so that the passes over the other
+	// bytes are skipped. Varying the highest byte mixes negative and positive
+	// keys.
+	for (auto Byte = 0; Byte < 8; ++Byte) {
+		const auto Shift = Byte * 8;
+		const auto Constant =
+		    uint64{0x0123456789ABCDEF} & ~(uint64{0xFF} << Shift);
+
+		FRandomEngine                      Engine(Byte + 1);
+		TArray<FUdonArrayUtilsTestElement> Elements;
+		Elements.SetNum(Num);
+		for (auto i = 0; i < Num; ++i) {
+			const auto Bits =
+			    Constant | (uint64{Engine.NextBelow(256)} << Shift);
+			Elements[i].WideKey = static_cast<int64>(Bits);
+			Elements[i].Key     = static_cast<int32>(static_cast<uint32>(Bits));
+			Elements[i].Id      = i;
+		}
+
+		const auto What = FString::Printf(TEXT("Byte %d"), Byte);
+		TestSortByKey(*this, What, Elements, TEXT("WideKey"),
+		              &FUdonArrayUtilsTestElement::WideKey);
+		if (Byte < 4) {
+			TestSortByKey(*this, What, Elements, TEXT("Key"),
+			              &FUdonArrayUtilsTestElement::Key);
+		}
+	}
+
+	// keys that are all equal, so that every pass is skipped
+	TArray<FUdonArrayUtilsTestElement> Elements;
+	Elements.SetNum(Num);
+	for (auto i = 0; i < Num; ++i) {
+		Elements[i].Key       = -42;
+		Elements[i].WideKey   = -42;
+		Elements[i].FloatKey  = -4.2f;
+		Elements[i].DoubleKey = -4.2;
+		Elements[i].Id        = i;
+	}
+	TestSortByKeys(*this, TEXT("Equal keys"), Elements);
+
+	return true;
+}
+
+#endif
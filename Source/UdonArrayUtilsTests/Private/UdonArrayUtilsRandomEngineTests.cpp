@@ -0,0 +1,228 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonRandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+// check that two 64-bit values are equal, showing both in hex if not
+void TestEqualBits(FAutomationTestBase& Test, const FString& What,
+                   const uint64 Actual, const uint64 Expected) {
+	if (Actual != Expected) {
+		Test.AddError(FString::Printf(TEXT("%s: expected 0x%016llx, but got "
+		                                   "0x%016llx."),
+		                              *What, Expected, Actual));
+	}
+}
+} // namespace
+} // namespace udon
+
+/*
+ * The golden values below were generated by the reference implementations
+ * of SplitMix64 and xoshiro256** (https://prng.di.unimi.it/), which
+ * FRandomEngine must match bit for bit on every platform so that seeded
+ * results replay everywhere.
+ */
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomGoldenSequenceTest,
+                                 "UdonArrayUtils.Random.GoldenSequence",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomGoldenSequenceTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// seed 0. the state is the first four outputs of SplitMix64 seeded with 0
+	// (0xe220a8397b1dcdaf, 0x6e789e6aa1b965f4, 0x06c45d188009454f,
+	// 0xf88bb8a8724c81ec).
+	{
+		const TArray<uint64> Expected = {
+		    0x99ec5f36cb75f2b4ull, 0xbf6e1f784956452aull, 0x1a5f849d4933e6e0ull,
+		    0x6aa594f1262d2d2cull, 0xbba5ad4a1f842e59ull, 0xffef8375d9ebcacaull,
+		    0x6c160deed2f54c98ull, 0x8920ad648fc30a3full};
+
+		FRandomEngine Engine(0);
+		for (auto i = 0; i < Expected.Num(); ++i) {
+			TestEqualBits(*this, FString::Printf(TEXT("Seed 0, Next #%d"), i),
+			              Engine.Next(), Expected[i]);
+		}
+	}
+
+	// a seed using all 64 bits
+	{
+		const TArray<uint64> Expected = {
+		    0xa2c2a42038d4ec3dull, 0x05fc25d0738e7b0full, 0x625e7bff938e701eull,
+		    0x1ba4ddc6fe2b5726ull, 0xdf0a2482ac9254cfull, 0x3939eda866ababe8ull,
+		    0xb59d922db3f2da81ull, 0x80472ee13a970c2aull};
+
+		constexpr uint64 Seed = 0x0123456789abcdefull;
+		FRandomEngine    Engine(Seed);
+		for (auto i = 0; i < Expected.Num(); ++i) {
+			TestEqualBits(
+			    *this, FString::Printf(TEXT("Seed 0x%016llx, Next #%d"), Seed, i),
+			    Engine.Next(), Expected[i]);
+		}
+	}
+
+	// SetSeed restarts the sequence
+	{
+		FRandomEngine Engine(1);
+		Engine.Next();
+		Engine.SetSeed(0);
+		TestEqualBits(*this, TEXT("SetSeed(0), Next #0"), Engine.Next(),
+		              0x99ec5f36cb75f2b4ull);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomGoldenDerivedTest,
+                                 "UdonArrayUtils.Random.GoldenDerived",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomGoldenDerivedTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// NextBelow with a small bound
+	{
+		const TArray<uint32> Expected = {0, 2, 4, 5, 5, 4, 4, 5,
+		                                 4, 3, 4, 1, 4, 1, 4, 5};
+
+		FRandomEngine Engine(42);
+		for (auto i = 0; i < Expected.Num(); ++i) {
+			TestEqual(FString::Printf(TEXT("NextBelow(6) #%d"), i),
+			          static_cast<int64>(Engine.NextBelow(6)),
+			          static_cast<int64>(Expected[i]));
+		}
+	}
+
+	// NextBelow with a bound that rejects almost half of the draws
+	{
+		const TArray<uint32> Expected = {1460382105u, 1635039033u,
+		                                 1465556378u, 690226226u};
+
+		FRandomEngine Engine(42);
+		for (auto i = 0; i < Expected.Num(); ++i) {
+			TestEqual(FString::Printf(TEXT("NextBelow(0x80000001) #%d"), i),
+			          static_cast<int64>(Engine.NextBelow(0x80000001u)),
+			          static_cast<int64>(Expected[i]));
+		}
+	}
+
+	// NextDouble, compared exactly
+	{
+		const TArray<double> Expected = {
+		    0.7005764821796896, 0.2787512294737843, 0.8396274618764198,
+		    0.9810977250149351};
+
+		FRandomEngine Engine(7);
+		for (auto i = 0; i < Expected.Num(); ++i) {
+			TestEqual(FString::Printf(TEXT("NextDouble #%d"), i),
+			          Engine.NextDouble(), Expected[i], 0.0);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomNextBelowBoundsTest,
+                                 "UdonArrayUtils.Random.NextBelowBounds",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomNextBelowBoundsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	FRandomEngine Engine(12345);
+
+	// a bound of 0 or 1 always gives 0
+	for (const auto Bound : {0u, 1u}) {
+		auto bAllZero = true;
+		for (auto i = 0; i < 1000; ++i) {
+			bAllZero &= Engine.NextBelow(Bound) == 0;
+		}
+		TestTrue(FString::Printf(TEXT("NextBelow(%u) is 0"), Bound), bAllZero);
+	}
+
+	// results are below the bound, including bounds near the top of uint32
+	for (const auto Bound : {2u, 3u, 7u, 1000u, 0x80000000u, 0x80000001u,
+	                         0xfffffffeu, 0xffffffffu}) {
+		auto bAllBelow = true;
+		for (auto i = 0; i < 10000; ++i) {
+			bAllBelow &= Engine.NextBelow(Bound) < Bound;
+		}
+		TestTrue(FString::Printf(TEXT("NextBelow(%u) < %u"), Bound, Bound),
+		         bAllBelow);
+	}
+
+	// every value below a small bound comes up about equally often. the
+	// tolerance is 5 standard deviations, and the seed is fixed, so the
+	// test is deterministic.
+	{
+		constexpr auto Bound    = 7u;
+		constexpr auto NumDraws = 70000;
+		int32          Counts[Bound] = {};
+		for (auto i = 0; i < NumDraws; ++i) {
+			++Counts[Engine.NextBelow(Bound)];
+		}
+
+		const auto Mean      = static_cast<double>(NumDraws) / Bound;
+		const auto Tolerance = 5.0 * FMath::Sqrt(Mean * (Bound - 1) / Bound);
+		for (auto Value = 0u; Value < Bound; ++Value) {
+			TestTrue(FString::Printf(TEXT("NextBelow(7) gives %u %d times"),
+			                         Value, Counts[Value]),
+			         FMath::Abs(Counts[Value] - Mean) <= Tolerance);
+		}
+	}
+
+	// NextDouble is in [0, 1)
+	{
+		auto bAllInRange = true;
+		for (auto i = 0; i < 10000; ++i) {
+			const auto Value = Engine.NextDouble();
+			bAllInRange &= 0.0 <= Value && Value < 1.0;
+		}
+		TestTrue(TEXT("NextDouble is in [0, 1)"), bAllInRange);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomStreamTest,
+                                 "UdonArrayUtils.Random.Stream",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomStreamTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// a stream generates the sequence of an engine with the same seed, also
+	// for negative seeds
+	const TStrongObjectPtr<UUdonRandomStream> Stream(
+	    UUdonRandomStream::CreateRandomStream(-5));
+	FRandomEngine Engine(static_cast<uint64>(-5ll));
+
+	TArray<int32> Sequence;
+	for (auto i = 0; i < 16; ++i) {
+		Sequence.Add(Stream->RandomInteger(1000));
+		TestEqual(FString::Printf(TEXT("RandomInteger #%d"), i), Sequence[i],
+		          static_cast<int32>(Engine.NextBelow(1000)));
+	}
+	TestEqual(TEXT("GetSeed"), Stream->GetSeed(), -5ll);
+
+	// Reset replays the sequence
+	Stream->Reset();
+	for (auto i = 0; i < Sequence.Num(); ++i) {
+		TestEqual(FString::Printf(TEXT("RandomInteger #%d after Reset"), i),
+		          Stream->RandomInteger(1000), Sequence[i]);
+	}
+
+	// a bound that isn't positive gives 0
+	TestEqual(TEXT("RandomInteger(0)"), Stream->RandomInteger(0), 0);
+	TestEqual(TEXT("RandomInteger(-1)"), Stream->RandomInteger(-1), 0);
+
+	return true;
+}
+
+#endif
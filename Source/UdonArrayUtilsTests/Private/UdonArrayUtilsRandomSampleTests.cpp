@@ -0,0 +1,255 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+const FArrayProperty& GetIntsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Ints));
+}
+
+// whether Indices are NumSamples ascending, distinct indices of NumArray
+bool AreSampleIndices(const TArray<int32>& Indices, const int32 NumArray,
+                      const int32 NumSamples) {
+	if (Indices.Num() != NumSamples) {
+		return false;
+	}
+	for (auto i = 0; i < Indices.Num(); ++i) {
+		if (Indices[i] < 0 || Indices[i] >= NumArray ||
+		    (i > 0 && Indices[i - 1] >= Indices[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Sizes around the boundary between Floyd's algorithm and the scan: the
+ * scan is used when NumSamples * 8 >= NumArray.
+ */
+struct FSampleSize {
+	int32        NumArray;
+	int32        NumSamples;
+	const TCHAR* Path;
+
+	// describe the size in the messages of the tests
+	FString Describe() const {
+		return FString::Printf(TEXT("%d of %d (%s)"), NumSamples, NumArray,
+		                       Path);
+	}
+};
+
+const FSampleSize BoundarySizes[] = {
+    {80, 9, TEXT("Floyd")}, {80, 10, TEXT("scan")}, {80, 11, TEXT("scan")},
+    {79, 10, TEXT("scan")}, {81, 10, TEXT("Floyd")}, {1000, 1, TEXT("Floyd")},
+};
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomSampleIndicesTest,
+                                 "UdonArrayUtils.RandomSample.Indices",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomSampleIndicesTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+
+	for (const auto& Size : BoundarySizes) {
+		const auto Array =
+		    UUdonArrayUtilsTestFixture::MakeIndexInts(Size.NumArray);
+		const auto What  = Size.Describe();
+
+		// the indices are ascending, distinct and in range
+		FRandomEngine Engine(1);
+		auto          bAllValid = true;
+		for (auto Trial = 0; Trial < 100; ++Trial) {
+			bAllValid &= AreSampleIndices(
+			    UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+			        &Array, ArrayProperty, Size.NumSamples, Engine),
+			    Size.NumArray, Size.NumSamples);
+		}
+		TestTrue(What + TEXT(" are ascending and distinct"), bAllValid);
+
+		// the same seed selects the same indices
+		FRandomEngine Engine1(123);
+		FRandomEngine Engine2(123);
+		TestTrue(What + TEXT(" with the same seed"),
+		         UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		             &Array, ArrayProperty, Size.NumSamples, Engine1) ==
+		             UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		                 &Array, ArrayProperty, Size.NumSamples, Engine2));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomSampleUniformTest,
+                                 "UdonArrayUtils.RandomSample.Uniform",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomSampleUniformTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+
+	// every index is selected about equally often on both sides of the
+	// boundary. the tolerance is 5 standard deviations, and the seed is fixed,
+	// so the test is deterministic.
+	for (const auto& Size : BoundarySizes) {
+		const auto Array =
+		    UUdonArrayUtilsTestFixture::MakeIndexInts(Size.NumArray);
+
+		constexpr auto NumTrials = 20000;
+		TArray<int32>  Counts;
+		Counts.SetNumZeroed(Size.NumArray);
+		FRandomEngine Engine(2024);
+		for (auto Trial = 0; Trial < NumTrials; ++Trial) {
+			for (const auto Index :
+			     UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+			         &Array, ArrayProperty, Size.NumSamples, Engine)) {
+				++Counts[Index];
+			}
+		}
+
+		const auto p = static_cast<double>(Size.NumSamples) / Size.NumArray;
+		const auto Mean       = NumTrials * p;
+		const auto Tolerance  = 5.0 * FMath::Sqrt(NumTrials * p * (1.0 - p));
+		auto       WorstIndex = 0;
+		for (auto i = 1; i < Counts.Num(); ++i) {
+			if (FMath::Abs(Counts[i] - Mean) >
+			    FMath::Abs(Counts[WorstIndex] - Mean)) {
+				WorstIndex = i;
+			}
+		}
+		TestTrue(FString::Printf(TEXT("%s: index %d is selected %d times, "
+		                              "expected %.1f"),
+		                         *Size.Describe(), WorstIndex,
+		                         Counts[WorstIndex], Mean),
+		         FMath::Abs(Counts[WorstIndex] - Mean) <= Tolerance);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomSampleClampTest,
+                                 "UdonArrayUtils.RandomSample.Clamp",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomSampleClampTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+	const auto  Array         = UUdonArrayUtilsTestFixture::MakeIndexInts(10);
+
+	FRandomEngine Engine(3);
+
+	// as many samples as elements or more select all of them
+	for (const auto NumSamples : {10, 11, TNumericLimits<int32>::Max()}) {
+		TestTrue(FString::Printf(TEXT("RandomSampleIndices(%d)"), NumSamples),
+		         UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		             &Array, ArrayProperty, NumSamples, Engine) == Array);
+
+		TArray<int32> Samples;
+		TArray<int32> Others = {-1};
+		UUdonArrayUtilsLibrary::GenericRandomSample(
+		    &Array, ArrayProperty, NumSamples, &Samples, &Others, Engine);
+		TestTrue(FString::Printf(TEXT("RandomSample(%d) Samples"), NumSamples),
+		         Samples == Array);
+		TestEqual(FString::Printf(TEXT("RandomSample(%d) Others"), NumSamples),
+		          Others.Num(), 0);
+	}
+
+	// no samples or a negative number of samples select none
+	for (const auto NumSamples : {0, -1, TNumericLimits<int32>::Lowest()}) {
+		TestEqual(FString::Printf(TEXT("RandomSampleIndices(%d)"), NumSamples),
+		          UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		              &Array, ArrayProperty, NumSamples, Engine)
+		              .Num(),
+		          0);
+
+		TArray<int32> Samples = {-1};
+		TArray<int32> Others;
+		UUdonArrayUtilsLibrary::GenericRandomSample(
+		    &Array, ArrayProperty, NumSamples, &Samples, &Others, Engine);
+		TestEqual(FString::Printf(TEXT("RandomSample(%d) Samples"), NumSamples),
+		          Samples.Num(), 0);
+		TestTrue(FString::Printf(TEXT("RandomSample(%d) Others"), NumSamples),
+		         Others == Array);
+	}
+
+	// an empty array has no samples
+	const TArray<int32> Empty;
+	TestEqual(TEXT("RandomSampleIndices of an empty array"),
+	          UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+	              &Empty, ArrayProperty, 3, Engine)
+	              .Num(),
+	          0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRandomSampleElementsTest,
+                                 "UdonArrayUtils.RandomSample.Elements",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRandomSampleElementsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+
+	for (const auto& Size : BoundarySizes) {
+		const auto Array =
+		    UUdonArrayUtilsTestFixture::MakeIndexInts(Size.NumArray);
+		const auto What  = Size.Describe();
+
+		// without Others, the samples are the elements at the sampled indices
+		// of the same seed
+		FRandomEngine IndicesEngine(5);
+		TArray<int32> Expected;
+		for (const auto Index :
+		     UUdonArrayUtilsLibrary::GenericRandomSampleIndices(
+		         &Array, ArrayProperty, Size.NumSamples, IndicesEngine)) {
+			Expected.Add(Array[Index]);
+		}
+
+		FRandomEngine SamplesEngine(5);
+		TArray<int32> Samples;
+		UUdonArrayUtilsLibrary::GenericRandomSample(
+		    &Array, ArrayProperty, Size.NumSamples, &Samples, nullptr,
+		    SamplesEngine);
+		TestTrue(What + TEXT(" Samples without Others"), Samples == Expected);
+
+		// with Others, the samples and the others split the array, each in the
+		// order of the array
+		TArray<int32> Others;
+		UUdonArrayUtilsLibrary::GenericRandomSample(
+		    &Array, ArrayProperty, Size.NumSamples, &Samples, &Others,
+		    SamplesEngine);
+		auto Merged = Samples;
+		Merged.Append(Others);
+		Merged.Sort();
+		TestTrue(What + TEXT(" Samples and Others"),
+		         AreSampleIndices(Samples, Size.NumArray, Size.NumSamples) &&
+		             AreSampleIndices(Others, Size.NumArray,
+		                              Size.NumArray - Size.NumSamples) &&
+		             Merged == Array);
+	}
+
+	// sampling into the target array itself samples from its old elements
+	auto          Array = UUdonArrayUtilsTestFixture::MakeIndexInts(80);
+	FRandomEngine Engine(6);
+	UUdonArrayUtilsLibrary::GenericRandomSample(&Array, ArrayProperty, 10,
+	                                            &Array, nullptr, Engine);
+	TestTrue(TEXT("RandomSample into the target array"),
+	         AreSampleIndices(Array, 80, 10));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,178 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+// a node that removes elements, and whether it keeps the order of the others
+struct FRemoveMode {
+	const TCHAR* Name;
+	void (*RemoveIf)(void*, const FArrayProperty&, UObject&, UFunction&);
+	bool bStable;
+};
+
+const FRemoveMode RemoveModes[] = {
+    {TEXT("RemoveIf"), &UUdonArrayUtilsLibrary::GenericRemoveIf, true},
+    {TEXT("UnstableRemoveIf"),
+     &UUdonArrayUtilsLibrary::GenericUnstableRemoveIf, false},
+};
+
+// which elements are removed: the elements with odd keys, where MakeKey
+// gives the key of the element at an index
+struct FRemovePattern {
+	const TCHAR* Name;
+	int32 (*MakeKey)(int32 Index);
+};
+
+const FRemovePattern RemovePatterns[] = {
+    {TEXT("all removed"), [](const int32 Index) { return Index * 2 + 1; }},
+    {TEXT("none removed"), [](const int32 Index) { return Index * 2; }},
+    {TEXT("alternating"), [](const int32 Index) { return Index; }},
+    {TEXT("every fifth kept"),
+     [](const int32 Index) { return Index * 2 + (Index % 5 != 4); }},
+};
+
+const int32 Sizes[] = {0, 1, 2, 7, 64};
+
+// the keys of Num elements with Pattern
+TArray<int32> MakeKeys(const FRemovePattern& Pattern, const int32 Num) {
+	TArray<int32> Keys;
+	for (auto i = 0; i < Num; ++i) {
+		Keys.Add(Pattern.MakeKey(i));
+	}
+	return Keys;
+}
+
+/**
+ * Whether Actual are the even keys of Keys, in the same order if bStable, or
+ * in any order otherwise.
+ */
+bool AreKeptKeys(TArray<int32> Actual, const TArray<int32>& Keys,
+                 const bool bStable) {
+	auto Expected =
+	    Keys.FilterByPredicate([](const int32 Key) { return Key % 2 == 0; });
+	if (!bStable) {
+		Actual.Sort();
+		Expected.Sort();
+	}
+	return Actual == Expected;
+}
+
+// describe a case in the messages of the tests
+FString Describe(const FRemoveMode& Mode, const FRemovePattern& Pattern,
+                 const int32 Num) {
+	return FString::Printf(TEXT("%s, %d elements, %s"), Mode.Name, Num,
+	                       Pattern.Name);
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRemoveIfStringsTest,
+                                 "UdonArrayUtils.RemoveIf.Strings",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRemoveIfStringsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const TStrongObjectPtr<UUdonArrayUtilsTestFixture> Fixture(
+	    NewObject<UUdonArrayUtilsTestFixture>());
+	auto& IsOddString = *Fixture->FindFunctionChecked(
+	    GET_FUNCTION_NAME_CHECKED(UUdonArrayUtilsTestFixture, IsOddString));
+	const auto& ArrayProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Strings));
+
+	for (const auto& Mode : RemoveModes) {
+		for (const auto& Pattern : RemovePatterns) {
+			for (const auto Num : Sizes) {
+				const auto Keys = MakeKeys(Pattern, Num);
+
+				TArray<FString> Array;
+				for (const auto Key : Keys) {
+					Array.Add(FString::FromInt(Key));
+				}
+
+				Fixture->NumPredicateCalls = 0;
+				Mode.RemoveIf(&Array, ArrayProperty, *Fixture, IsOddString);
+
+				// the predicate is called once per element
+				const auto What = Describe(Mode, Pattern, Num);
+				TestEqual(What + TEXT(", predicate calls"),
+				          Fixture->NumPredicateCalls, Num);
+
+				TArray<int32> Kept;
+				for (const auto& Element : Array) {
+					Kept.Add(FCString::Atoi(*Element));
+				}
+				TestTrue(What, AreKeptKeys(Kept, Keys, Mode.bStable));
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsRemoveIfDestructionTest,
+                                 "UdonArrayUtils.RemoveIf.Destruction",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsRemoveIfDestructionTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const TStrongObjectPtr<UUdonArrayUtilsTestFixture> Fixture(
+	    NewObject<UUdonArrayUtilsTestFixture>());
+	auto& IsOddKey = *Fixture->FindFunctionChecked(
+	    GET_FUNCTION_NAME_CHECKED(UUdonArrayUtilsTestFixture, IsOddKey));
+	const auto& ArrayProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, CountedElements));
+
+	const auto NumAliveBefore = FUdonArrayUtilsTestCountedElement::NumAlive;
+	for (const auto& Mode : RemoveModes) {
+		for (const auto& Pattern : RemovePatterns) {
+			for (const auto Num : Sizes) {
+				const auto What = Describe(Mode, Pattern, Num);
+				const auto Keys = MakeKeys(Pattern, Num);
+				{
+					TArray<FUdonArrayUtilsTestCountedElement> Array;
+					Array.Reserve(Num);
+					for (const auto Key : Keys) {
+						Array.Emplace(Key);
+					}
+
+					Mode.RemoveIf(&Array, ArrayProperty, *Fixture, IsOddKey);
+
+					// each removed element is destroyed once, and each kept
+					// element is still alive with its string
+					TestEqual(What + TEXT(", alive after removal"),
+					          FUdonArrayUtilsTestCountedElement::NumAlive -
+					              NumAliveBefore,
+					          Array.Num());
+
+					TArray<int32> Kept;
+					auto          bStringsKept = true;
+					for (const auto& Element : Array) {
+						Kept.Add(Element.Key);
+						bStringsKept &=
+						    Element.Value ==
+						    FString::Printf(TEXT("Element %d"), Element.Key);
+					}
+					TestTrue(What, AreKeptKeys(Kept, Keys, Mode.bStable));
+					TestTrue(What + TEXT(", strings"), bStringsKept);
+				}
+
+				// the kept elements are destroyed with the array
+				TestEqual(What + TEXT(", alive after the array"),
+				          FUdonArrayUtilsTestCountedElement::NumAlive,
+				          NumAliveBefore);
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,257 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonArrayUtilsTestStatistics.h"
+#include "UdonReservoirSampler.h"
+
+#include <limits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+const FArrayProperty& GetIntsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Ints));
+}
+
+// create a sampler drawing from a stream seeded with Seed
+TStrongObjectPtr<UUdonReservoirSampler> CreateSampler(const int32 Capacity,
+                                                      const bool  bWeighted,
+                                                      const int64 Seed) {
+	return TStrongObjectPtr<UUdonReservoirSampler>(
+	    UUdonReservoirSampler::CreateReservoirSampler(
+	        Capacity, bWeighted, UUdonRandomStream::CreateRandomStream(Seed)));
+}
+
+// offer the elements 0, 1, ..., Weights.Num() - 1 with Weights
+void AddAll(UUdonReservoirSampler& Sampler, TArray<int32>& Reservoir,
+            const TArray<double>& Weights) {
+	for (auto i = 0; i < Weights.Num(); ++i) {
+		Sampler.GenericAdd(&Reservoir, GetIntsProperty(), &i, Weights[i]);
+	}
+}
+
+/**
+ * Checks that the samplers with Capacity keep each of the elements with the
+ * probabilities Expected, running NumTrials streams of the elements with
+ * Weights through one sampler that is reset between them.
+ */
+void TestInclusions(FAutomationTestBase& Test, const FString& What,
+                    const int32 Capacity, const bool bWeighted,
+                    const TArray<double>& Weights, const int32 NumTrials,
+                    const int64 Seed, const TArray<double>& Expected) {
+	const auto    Sampler = CreateSampler(Capacity, bWeighted, Seed);
+	TArray<int32> Reservoir;
+	TArray<int32> Counts;
+	Counts.SetNumZeroed(Weights.Num());
+	auto bAllFull = true;
+	for (auto Trial = 0; Trial < NumTrials; ++Trial) {
+		Sampler->Reset();
+		AddAll(*Sampler, Reservoir, Weights);
+		bAllFull &= Reservoir.Num() == Capacity;
+		for (const auto Sample : Reservoir) {
+			++Counts[Sample];
+		}
+	}
+
+	Test.TestTrue(What + TEXT(" keeps Capacity samples"), bAllFull);
+	TestFrequencies(Test, What, Counts, NumTrials, Expected);
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsReservoirSamplerUniformTest,
+                                 "UdonArrayUtils.ReservoirSampler.Uniform",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsReservoirSamplerUniformTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// every element is kept with the probability Capacity / Num, including
+	// the first Capacity elements that fill the reservoir
+	TArray<double> Weights;
+	Weights.Init(1.0, 50);
+	TArray<double> Expected;
+	Expected.Init(5.0 / 50.0, 50);
+	TestInclusions(*this, TEXT("5 of 50"), 5, false, Weights, 20000, 31,
+	               Expected);
+
+	// the weights are ignored by unweighted samplers
+	const auto    Sampler = CreateSampler(3, false, 1);
+	TArray<int32> Reservoir;
+	AddAll(*Sampler, Reservoir, {0.0, -1.0, 0.0});
+	TestTrue(TEXT("Weights are ignored"),
+	         Reservoir == UUdonArrayUtilsTestFixture::MakeIndexInts(3));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsReservoirSamplerWeightedTest,
+                                 "UdonArrayUtils.ReservoirSampler.Weighted",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsReservoirSamplerWeightedTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// an element is kept with the probability of drawing it in the first
+	// Capacity draws without replacement, and elements without a positive
+	// weight never
+	const TArray<double> Weights = {1.0, 2.0, 0.0, 3.0, NaN, 4.0, -1.0, 10.0};
+	for (const auto Capacity : {1, 2}) {
+		TestInclusions(*this, FString::Printf(TEXT("Capacity %d"), Capacity),
+		               Capacity, true, Weights, 40000, 40 + Capacity,
+		               GetInclusionProbabilities(Weights, Capacity));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsReservoirSamplerFillTest,
+                                 "UdonArrayUtils.ReservoirSampler.Fill",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsReservoirSamplerFillTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// fewer elements than the capacity are all kept, in the order added
+	for (const auto bWeighted : {false, true}) {
+		const auto    Sampler = CreateSampler(10, bWeighted, 2);
+		TArray<int32> Reservoir;
+		AddAll(*Sampler, Reservoir, {1.0, 1.0, 1.0, 1.0});
+		TestTrue(bWeighted ? TEXT("Weighted") : TEXT("Uniform"),
+		         Reservoir == UUdonArrayUtilsTestFixture::MakeIndexInts(4));
+		TestEqual(TEXT("GetNumAdded"), Sampler->GetNumAdded(), 4ll);
+	}
+
+	// a sampler without capacity keeps nothing
+	for (const auto Capacity : {0, -3}) {
+		const auto    Sampler = CreateSampler(Capacity, false, 3);
+		TArray<int32> Reservoir;
+		AddAll(*Sampler, Reservoir, {1.0, 1.0});
+		TestEqual(TEXT("GetCapacity"), Sampler->GetCapacity(), 0);
+		TestEqual(FString::Printf(TEXT("Capacity %d"), Capacity),
+		          Reservoir.Num(), 0);
+	}
+
+	// samplers with streams of the same seed keep the same samples
+	for (const auto bWeighted : {false, true}) {
+		TArray<double> Weights;
+		for (auto i = 0; i < 100; ++i) {
+			Weights.Add(i % 7 + 1.0);
+		}
+
+		TArray<int32> Reservoir1;
+		TArray<int32> Reservoir2;
+		AddAll(*CreateSampler(4, bWeighted, 4), Reservoir1, Weights);
+		AddAll(*CreateSampler(4, bWeighted, 4), Reservoir2, Weights);
+		TestTrue(bWeighted ? TEXT("Weighted with the same seed")
+		                   : TEXT("Uniform with the same seed"),
+		         Reservoir1 == Reservoir2);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsReservoirSamplerResetTest,
+                                 "UdonArrayUtils.ReservoirSampler.Reset",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsReservoirSamplerResetTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const TArray<double> Weights = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+	for (const auto bWeighted : {false, true}) {
+		const auto* const What = bWeighted ? TEXT("Weighted") : TEXT("Uniform");
+
+		// fill a reservoir
+		const TStrongObjectPtr<UUdonRandomStream> Stream(
+		    UUdonRandomStream::CreateRandomStream(5));
+		const TStrongObjectPtr<UUdonReservoirSampler> Sampler(
+		    UUdonReservoirSampler::CreateReservoirSampler(2, bWeighted,
+		                                                  Stream.Get()));
+		TArray<int32> Reservoir;
+		AddAll(*Sampler, Reservoir, Weights);
+		const auto FirstSamples = Reservoir;
+
+		// after Reset, the first Add empties the reservoir, even another
+		// array with other elements, and starts a new sample
+		Sampler->Reset();
+		TestEqual(FString(What) + TEXT(" GetNumAdded after Reset"),
+		          Sampler->GetNumAdded(), 0ll);
+
+		TArray<int32> OtherReservoir = {7, 8, 9};
+		const auto    Element        = 42;
+		TestTrue(FString(What) + TEXT(" Add after Reset"),
+		         Sampler->GenericAdd(&OtherReservoir, GetIntsProperty(),
+		                             &Element, 1.0));
+		TestTrue(FString(What) + TEXT(" reservoir after Reset"),
+		         OtherReservoir == TArray<int32>{42});
+		TestEqual(FString(What) + TEXT(" GetNumAdded after Add"),
+		          Sampler->GetNumAdded(), 1ll);
+
+		// the same stream from the same state replays the same samples
+		Sampler->Reset();
+		Stream->Reset();
+		AddAll(*Sampler, Reservoir, Weights);
+		TestTrue(FString(What) + TEXT(" replayed after Reset"),
+		         Reservoir == FirstSamples);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsReservoirSamplerChangedTest,
+                                 "UdonArrayUtils.ReservoirSampler.Changed",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsReservoirSamplerChangedTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// each sampler logs an error for a changed and for another reservoir
+	AddExpectedError(TEXT("Pass the same array to every Add"),
+	                 EAutomationExpectedErrorFlags::Contains, 4);
+
+	for (const auto bWeighted : {false, true}) {
+		const auto* const What = bWeighted ? TEXT("Weighted") : TEXT("Uniform");
+
+		const auto    Sampler = CreateSampler(3, bWeighted, 6);
+		TArray<int32> Reservoir;
+		AddAll(*Sampler, Reservoir, {1.0, 1.0});
+
+		// an element added to the reservoir by someone else is detected, and
+		// the offered element is neither added nor counted
+		Reservoir.Add(100);
+		const auto Element = 5;
+		TestFalse(FString(What) + TEXT(" Add to a changed reservoir"),
+		          Sampler->GenericAdd(&Reservoir, GetIntsProperty(), &Element,
+		                              1.0));
+		TestTrue(FString(What) + TEXT(" changed reservoir"),
+		         Reservoir == TArray<int32>{0, 1, 100});
+		TestEqual(FString(What) + TEXT(" GetNumAdded"),
+		          Sampler->GetNumAdded(), 2ll);
+
+		// so is another array
+		TArray<int32> OtherReservoir;
+		TestFalse(FString(What) + TEXT(" Add to another reservoir"),
+		          Sampler->GenericAdd(&OtherReservoir, GetIntsProperty(),
+		                              &Element, 1.0));
+
+		// once the reservoir is restored, adding continues
+		Reservoir.Pop();
+		TestTrue(FString(What) + TEXT(" Add to the restored reservoir"),
+		         Sampler->GenericAdd(&Reservoir, GetIntsProperty(), &Element,
+		                             1.0));
+		TestTrue(FString(What) + TEXT(" restored reservoir"),
+		         Reservoir == TArray<int32>{0, 1, 5});
+	}
+
+	return true;
+}
+
+#endif
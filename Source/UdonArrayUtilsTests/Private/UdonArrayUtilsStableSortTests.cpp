@@ -0,0 +1,239 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Algo/Compare.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonRandomStream.h"
+
+#include <algorithm>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+const FArrayProperty& GetElementsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Elements));
+}
+
+// make elements with the keys Keys, and IDs in index order
+TArray<FUdonArrayUtilsTestElement> MakeElements(const TArray<int32>& Keys) {
+	TArray<FUdonArrayUtilsTestElement> Elements;
+	Elements.SetNum(Keys.Num());
+	for (auto i = 0; i < Keys.Num(); ++i) {
+		Elements[i].Key = Keys[i];
+		Elements[i].Id  = i;
+	}
+	return Elements;
+}
+
+// make Num random keys below NumValues, so that many keys are equal
+TArray<int32> MakeRandomKeys(const int32 Num, const int32 NumValues,
+                             const uint64 Seed) {
+	FRandomEngine Engine(Seed);
+	TArray<int32> Keys;
+	Keys.SetNumUninitialized(Num);
+	for (auto& Key : Keys) {
+		Key = static_cast<int32>(Engine.NextBelow(NumValues));
+	}
+	return Keys;
+}
+
+/**
+ * Sorts elements with Keys by StableSortAnyArray with LessKey, and checks
+ * that the IDs are in the order std::stable_sort gives them.
+ * @return  the number of comparisons the sort made
+ */
+int32 TestStableSort(FAutomationTestBase& Test, const FString& What,
+                     const TArray<int32>& Keys, const bool bAdaptive) {
+	const TStrongObjectPtr<UUdonArrayUtilsTestFixture> Fixture(
+	    NewObject<UUdonArrayUtilsTestFixture>());
+
+	const auto Elements = MakeElements(Keys);
+	auto       Expected = Elements;
+	std::stable_sort(Expected.GetData(), Expected.GetData() + Expected.Num(),
+	                 [](const FUdonArrayUtilsTestElement& A,
+	                    const FUdonArrayUtilsTestElement& B) {
+		                 return A.Key < B.Key;
+	                 });
+
+	auto Sorted = Elements;
+	UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+	    &Sorted, GetElementsProperty(), *Fixture,
+	    *Fixture->FindFunctionChecked(
+	        GET_FUNCTION_NAME_CHECKED(UUdonArrayUtilsTestFixture, LessKey)),
+	    bAdaptive);
+
+	Test.TestTrue(
+	    FString::Printf(TEXT("%s (%s)"), *What,
+	                    bAdaptive ? TEXT("adaptive") : TEXT("not adaptive")),
+	    Algo::Compare(Sorted, Expected,
+	                  [](const FUdonArrayUtilsTestElement& A,
+	                     const FUdonArrayUtilsTestElement& B) {
+		                  return A.Id == B.Id;
+	                  }));
+
+	return Fixture->NumComparisons;
+}
+
+// TestStableSort with and without the detection of sorted runs
+void TestStableSorts(FAutomationTestBase& Test, const FString& What,
+                     const TArray<int32>& Keys) {
+	TestStableSort(Test, What, Keys, true);
+	TestStableSort(Test, What, Keys, false);
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsStableSortStabilityTest,
+                                 "UdonArrayUtils.StableSort.Stability",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsStableSortStabilityTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// sizes around the minimum run length (32 to 64) and the scratch buffer
+	// (half of the elements)
+	for (const auto Num : {0, 1, 2, 3, 31, 32, 63, 64, 65, 127, 128, 1000}) {
+		TestStableSorts(*this, FString::Printf(TEXT("%d elements"), Num),
+		                MakeRandomKeys(Num, 10, Num));
+	}
+
+	// keys that are all equal keep their order
+	TArray<int32> EqualKeys;
+	EqualKeys.Init(7, 300);
+	TestStableSorts(*this, TEXT("Equal keys"), EqualKeys);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsStableSortRunsTest,
+                                 "UdonArrayUtils.StableSort.Runs",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsStableSortRunsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	constexpr auto Num = 1000;
+
+	// a sorted array is one run, found with one comparison per element
+	TArray<int32> Ascending;
+	TArray<int32> Descending;
+	TArray<int32> DescendingPairs;
+	for (auto i = 0; i < Num; ++i) {
+		Ascending.Add(i / 3);
+		Descending.Add(Num - i);
+		DescendingPairs.Add((Num - i) / 2);
+	}
+	TestEqual(TEXT("Comparisons of an ascending run"),
+	          TestStableSort(*this, TEXT("Ascending"), Ascending, true),
+	          Num - 1);
+
+	// a strictly descending run is reversed in place
+	TestEqual(TEXT("Comparisons of a descending run"),
+	          TestStableSort(*this, TEXT("Descending"), Descending, true),
+	          Num - 1);
+
+	// a descending run with equal keys isn't reversed as a whole, which would
+	// swap the equal keys
+	TestStableSorts(*this, TEXT("Descending pairs"), DescendingPairs);
+
+	// NumRuns ascending runs of 100 elements each, whose keys interleave
+	// with those of the other runs. The runs are merged in pairs, and an odd
+	// run is carried over to the next pass.
+	for (auto NumRuns = 1; NumRuns <= 7; ++NumRuns) {
+		TArray<int32> Keys;
+		for (auto Run = 0; Run < NumRuns; ++Run) {
+			for (auto i = 0; i < 100; ++i) {
+				Keys.Add((Run + i * NumRuns) / 2);
+			}
+		}
+		TestStableSorts(*this, FString::Printf(TEXT("%d runs"), NumRuns),
+		                Keys);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsStableSortNearlySortedTest,
+                                 "UdonArrayUtils.StableSort.NearlySorted",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsStableSortNearlySortedTest::RunTest(const FString&) {
+	using namespace udon;
+
+	constexpr auto Num = 1000;
+
+	// sorted keys with a few elements swapped
+	TArray<int32> Keys;
+	for (auto i = 0; i < Num; ++i) {
+		Keys.Add(i / 4);
+	}
+	FRandomEngine Engine(8);
+	for (auto i = 0; i < 10; ++i) {
+		Keys.Swap(static_cast<int32>(Engine.NextBelow(Num)),
+		          static_cast<int32>(Engine.NextBelow(Num)));
+	}
+	TestStableSorts(*this, TEXT("Swapped elements"), Keys);
+
+	// sorted keys with a few random keys appended
+	Keys.Reset();
+	for (auto i = 0; i < Num; ++i) {
+		Keys.Add(i / 4);
+	}
+	Keys.Append(MakeRandomKeys(20, Num / 4, 9));
+	TestStableSorts(*this, TEXT("Appended elements"), Keys);
+
+	// a few distinct keys
+	TestStableSorts(*this, TEXT("Two keys"), MakeRandomKeys(Num, 2, 10));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsStableSortNestedTest,
+                                 "UdonArrayUtils.StableSort.Nested",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsStableSortNestedTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// each comparison of the outer sort sorts 70 other elements (two runs
+	// that are merged), on the same thread and while the outer sort holds the
+	// scratch buffer
+	const TStrongObjectPtr<UUdonArrayUtilsTestFixture> Fixture(
+	    NewObject<UUdonArrayUtilsTestFixture>());
+	Fixture->NestedElements = MakeElements(MakeRandomKeys(70, 10, 11));
+
+	const auto Elements = MakeElements(MakeRandomKeys(150, 20, 12));
+	auto       Expected = Elements;
+	std::stable_sort(Expected.GetData(), Expected.GetData() + Expected.Num(),
+	                 [](const FUdonArrayUtilsTestElement& A,
+	                    const FUdonArrayUtilsTestElement& B) {
+		                 return A.Key < B.Key;
+	                 });
+
+	for (const auto bAdaptive : {true, false}) {
+		auto Sorted = Elements;
+		UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+		    &Sorted, GetElementsProperty(), *Fixture,
+		    *Fixture->FindFunctionChecked(GET_FUNCTION_NAME_CHECKED(
+		        UUdonArrayUtilsTestFixture, LessKeyWithNestedSort)),
+		    bAdaptive);
+
+		const auto What = FString(bAdaptive ? TEXT("adaptive")
+		                                    : TEXT("not adaptive"));
+		TestTrue(TEXT("Outer sort, ") + What,
+		         Algo::Compare(Sorted, Expected,
+		                       [](const FUdonArrayUtilsTestElement& A,
+		                          const FUdonArrayUtilsTestElement& B) {
+			                       return A.Id == B.Id;
+		                       }));
+		TestTrue(TEXT("Nested sorts, ") + What, Fixture->bNestedSortsSorted);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "UdonArrayUtilsTestFixture.h"
+
+#include "Algo/IsSorted.h"
+#include "UdonArrayUtilsLibrary.h"
+
+int32 FUdonArrayUtilsTestCountedElement::NumAlive = 0;
+
+bool UUdonArrayUtilsTestFixture::LessKey(const FUdonArrayUtilsTestElement& A,
+                                         const FUdonArrayUtilsTestElement& B) {
+	++NumComparisons;
+	return A.Key < B.Key;
+}
+
+bool UUdonArrayUtilsTestFixture::LessKeyWithNestedSort(
+    const FUdonArrayUtilsTestElement& A, const FUdonArrayUtilsTestElement& B) {
+	auto Nested = NestedElements;
+	UUdonArrayUtilsLibrary::GenericStableSortAnyArray(
+	    &Nested,
+	    GetArrayProperty(
+	        GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Elements)),
+	    *this,
+	    *FindFunctionChecked(
+	        GET_FUNCTION_NAME_CHECKED(UUdonArrayUtilsTestFixture, LessKey)),
+	    false);
+
+	// the keys are ascending, and the IDs of equal keys too
+	bNestedSortsSorted &= Algo::IsSorted(
+	    Nested, [](const FUdonArrayUtilsTestElement& X,
+	               const FUdonArrayUtilsTestElement& Y) {
+		    return X.Key < Y.Key || (X.Key == Y.Key && X.Id < Y.Id);
+	    });
+
+	return LessKey(A, B);
+}
+
+bool UUdonArrayUtilsTestFixture::IsOddString(const FString& Value) {
+	++NumPredicateCalls;
+	return FCString::Atoi(*Value) % 2 != 0;
+}
+
+bool UUdonArrayUtilsTestFixture::IsOddKey(
+    const FUdonArrayUtilsTestCountedElement& Element) {
+	++NumPredicateCalls;
+	return Element.Key % 2 != 0;
+}
@@ -0,0 +1,181 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Object.h"
+#include "UObject/UnrealType.h"
+
+#include "UdonArrayUtilsTestFixture.generated.h"
+
+/**
+ * Flags of the functional tests. They run in the editor, in game and server
+ * builds, and in commandlets, so that they can be run headless on build
+ * agents.
+ */
+#define UDON_ARRAY_UTILS_TEST_FLAGS                                             \
+	(EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | \
+	 EAutomationTestFlags::ServerContext |                                      \
+	 EAutomationTestFlags::CommandletContext |                                  \
+	 EAutomationTestFlags::ProductFilter)
+
+/**
+ * An element with keys of several types to sort by, and an ID that tells
+ * elements with equal keys apart.
+ */
+USTRUCT()
+struct FUdonArrayUtilsTestElement {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Key = 0;
+
+	UPROPERTY()
+	int64 WideKey = 0;
+
+	UPROPERTY()
+	float FloatKey = 0.0f;
+
+	UPROPERTY()
+	double DoubleKey = 0.0;
+
+	UPROPERTY()
+	int32 Id = 0;
+};
+
+/**
+ * An element that holds a string, and counts its live instances so that tests
+ * can check that removed elements are destroyed exactly once.
+ */
+USTRUCT()
+struct FUdonArrayUtilsTestCountedElement {
+	GENERATED_BODY()
+
+	FUdonArrayUtilsTestCountedElement() {
+		++NumAlive;
+	}
+
+	explicit FUdonArrayUtilsTestCountedElement(const int32 InKey)
+	    : Key(InKey), Value(FString::Printf(TEXT("Element %d"), InKey)) {
+		++NumAlive;
+	}
+
+	FUdonArrayUtilsTestCountedElement(
+	    const FUdonArrayUtilsTestCountedElement& Other)
+	    : Key(Other.Key), Value(Other.Value) {
+		++NumAlive;
+	}
+
+	FUdonArrayUtilsTestCountedElement&
+	    operator=(const FUdonArrayUtilsTestCountedElement& Other) = default;
+
+	~FUdonArrayUtilsTestCountedElement() {
+		--NumAlive;
+	}
+
+	UPROPERTY()
+	int32 Key = 0;
+
+	// a string, so that the element owns memory to free
+	UPROPERTY()
+	FString Value;
+
+	// the number of instances that are constructed and not destroyed yet
+	static int32 NumAlive;
+};
+
+/**
+ * The class whose array properties describe the arrays passed to the
+ * Generic functions of the library in the tests. The arrays themselves are
+ * local to the tests.
+ */
+UCLASS()
+class UUdonArrayUtilsTestFixture: public UObject {
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<int32> Ints;
+
+	UPROPERTY()
+	TArray<int64> Int64s;
+
+	UPROPERTY()
+	TArray<float> Floats;
+
+	UPROPERTY()
+	TArray<double> Doubles;
+
+	UPROPERTY()
+	TArray<FVector> Vectors;
+
+	UPROPERTY()
+	TArray<FString> Strings;
+
+	UPROPERTY()
+	TArray<FName> Names;
+
+	UPROPERTY()
+	TArray<FUdonArrayUtilsTestElement> Elements;
+
+	UPROPERTY()
+	TArray<FUdonArrayUtilsTestCountedElement> CountedElements;
+
+public:
+	// whether the key of A is less than that of B. Counts the calls in
+	// NumComparisons.
+	UFUNCTION()
+	bool LessKey(const FUdonArrayUtilsTestElement& A,
+	             const FUdonArrayUtilsTestElement& B);
+
+	// LessKey, after stably sorting a copy of NestedElements with LessKey, so
+	// that a sort runs inside the comparison function of another. Clears
+	// bNestedSortsSorted if a nested sort gives a wrong order.
+	UFUNCTION()
+	bool LessKeyWithNestedSort(const FUdonArrayUtilsTestElement& A,
+	                           const FUdonArrayUtilsTestElement& B);
+
+	// whether the number in Value is odd. Counts the calls in
+	// NumPredicateCalls.
+	UFUNCTION()
+	bool IsOddString(const FString& Value);
+
+	// whether the key of Element is odd. Counts the calls in
+	// NumPredicateCalls.
+	UFUNCTION()
+	bool IsOddKey(const FUdonArrayUtilsTestCountedElement& Element);
+
+public:
+	// the number of calls to LessKey
+	int32 NumComparisons = 0;
+
+	// the number of calls to IsOddString and IsOddKey
+	int32 NumPredicateCalls = 0;
+
+	// the elements sorted by LessKeyWithNestedSort
+	TArray<FUdonArrayUtilsTestElement> NestedElements;
+
+	// whether every nested sort of LessKeyWithNestedSort gave the right order
+	bool bNestedSortsSorted = true;
+
+public:
+	// get the property of the array named Name, such as Ints
+	static const FArrayProperty& GetArrayProperty(const FName& Name) {
+		const auto* const ArrayProperty =
+		    FindFProperty<FArrayProperty>(StaticClass(), Name);
+		check(ArrayProperty);
+		return *ArrayProperty;
+	}
+
+	// make the array {0, 1, ..., Num - 1} for Ints, so that elements equal
+	// their indices
+	static TArray<int32> MakeIndexInts(const int32 Num) {
+		TArray<int32> Array;
+		Array.Reserve(Num);
+		for (auto i = 0; i < Num; ++i) {
+			Array.Add(i);
+		}
+		return Array;
+	}
+};
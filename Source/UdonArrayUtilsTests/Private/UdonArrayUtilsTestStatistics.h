@@ -0,0 +1,72 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+namespace udon {
+/**
+ * Checks that the indices drawn NumDraws times were drawn with the
+ * probabilities Expected: indices with probability 0 never, and the others
+ * within 5 standard deviations of their expected counts. The seeds of the
+ * tests are fixed, so the checks are deterministic.
+ */
+inline void TestFrequencies(FAutomationTestBase& Test, const FString& What,
+                            const TArray<int32>&  Counts,
+                            const int32           NumDraws,
+                            const TArray<double>& Expected) {
+	for (auto i = 0; i < Expected.Num(); ++i) {
+		const auto p       = Expected[i];
+		const auto Mean    = NumDraws * p;
+		const auto Message = FString::Printf(
+		    TEXT("%s: index %d is drawn %d times, expected %.1f"), *What, i,
+		    Counts[i], Mean);
+		if (p == 0.0) {
+			Test.TestEqual(Message, Counts[i], 0);
+		} else {
+			Test.TestTrue(Message, FMath::Abs(Counts[i] - Mean) <=
+			                           5.0 * FMath::Sqrt(Mean * (1.0 - p)));
+		}
+	}
+}
+
+// the probabilities of the weights, where weights that aren't positive are 0
+inline TArray<double> GetProbabilities(const TArray<double>& Weights) {
+	auto Total = 0.0;
+	for (const auto Weight : Weights) {
+		Total += Weight > 0.0 ? Weight : 0.0;
+	}
+
+	TArray<double> Probabilities;
+	for (const auto Weight : Weights) {
+		Probabilities.Add(Weight > 0.0 ? Weight / Total : 0.0);
+	}
+	return Probabilities;
+}
+
+/**
+ * The probabilities that each index is among the first NumSamples (1 or 2)
+ * indices drawn without replacement with probabilities proportional to
+ * Weights: p(i) for one sample, and p(i) + the sum of
+ * p(j) * p(i) / (1 - p(j)) over j != i for two.
+ */
+inline TArray<double> GetInclusionProbabilities(const TArray<double>& Weights,
+                                                const int32 NumSamples) {
+	check(NumSamples == 1 || NumSamples == 2);
+
+	const auto Probabilities = GetProbabilities(Weights);
+	auto       Inclusions    = Probabilities;
+	if (NumSamples == 2) {
+		for (auto i = 0; i < Inclusions.Num(); ++i) {
+			for (auto j = 0; j < Inclusions.Num(); ++j) {
+				if (j != i) {
+					Inclusions[i] += Probabilities[j] * Probabilities[i] /
+					                 (1.0 - Probabilities[j]);
+				}
+			}
+		}
+	}
+	return Inclusions;
+}
+} // namespace udon
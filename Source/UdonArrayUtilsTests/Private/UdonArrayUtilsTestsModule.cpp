@@ -0,0 +1,5 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, UdonArrayUtilsTests)
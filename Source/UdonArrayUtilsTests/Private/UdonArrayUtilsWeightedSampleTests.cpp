@@ -0,0 +1,312 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UdonAliasTable.h"
+#include "UdonArrayUtilsLibrary.h"
+#include "UdonArrayUtilsTestFixture.h"
+#include "UdonArrayUtilsTestStatistics.h"
+
+#include <limits>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace udon {
+namespace {
+constexpr auto NaN      = std::numeric_limits<double>::quiet_NaN();
+constexpr auto Infinity = std::numeric_limits<double>::infinity();
+
+const FArrayProperty& GetIntsProperty() {
+	return UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Ints));
+}
+
+// draw from Table NumDraws times, and check the frequencies against Weights
+void TestAliasTable(FAutomationTestBase& Test, const FString& What,
+                    const TArray<double>& Weights, const int32 NumDraws,
+                    const uint64 Seed) {
+	FAliasTable Table;
+	Table.Build(Weights);
+	Test.TestEqual(What + TEXT(" Num"), Table.Num(), Weights.Num());
+
+	TArray<int32> Counts;
+	Counts.SetNumZeroed(Weights.Num());
+	FRandomEngine Engine(Seed);
+	for (auto i = 0; i < NumDraws; ++i) {
+		++Counts[Table.Draw(Engine)];
+	}
+
+	TestFrequencies(Test, What, Counts, NumDraws, GetProbabilities(Weights));
+}
+} // namespace
+} // namespace udon
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsAliasTableDistributionTest,
+                                 "UdonArrayUtils.AliasTable.Distribution",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsAliasTableDistributionTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// zero, negative and NaN weights are never drawn
+	TestAliasTable(*this, TEXT("Mixed"), {0.0, NaN, -1.0, 2.0, 0.0, 6.0, 0.0},
+	               40000, 11);
+
+	// weights whose scaled probabilities don't add up exactly, so that the
+	// last columns are filled by rounding
+	TArray<double> Tenths;
+	for (auto i = 0; i < 10; ++i) {
+		Tenths.Add(i * 0.1);
+	}
+	TestAliasTable(*this, TEXT("Tenths"), Tenths, 100000, 12);
+	TestAliasTable(*this, TEXT("Thirds"),
+	               {1.0 / 3.0, 1.0 / 3.0, 0.0, 1.0 / 3.0}, 30000, 13);
+
+	// a single positive weight is always drawn
+	TestAliasTable(*this, TEXT("Single"), {0.0, 0.0, 1e-300, 0.0}, 1000, 14);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsAliasTableEmptyTest,
+                                 "UdonArrayUtils.AliasTable.Empty",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsAliasTableEmptyTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// nothing can be drawn without a positive, finite total weight
+	const TArray<double> WeightsList[] = {
+	    {},
+	    {0.0, 0.0},
+	    {-1.0, NaN, 0.0},
+	    {1.0, Infinity, 2.0},
+	    {TNumericLimits<double>::Max(), TNumericLimits<double>::Max()},
+	};
+
+	FRandomEngine Engine(1);
+	for (const auto& Weights : WeightsList) {
+		FAliasTable Table;
+		Table.Build({1.0, 2.0});
+		Table.Build(Weights);
+
+		const auto What = FString::Printf(TEXT("%d weights"), Weights.Num());
+		TestEqual(What + TEXT(" Num"), Table.Num(), 0);
+		TestEqual(What + TEXT(" Draw"), Table.Draw(Engine), INDEX_NONE);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsAliasTableObjectTest,
+                                 "UdonArrayUtils.AliasTable.Object",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsAliasTableObjectTest::RunTest(const FString&) {
+	using namespace udon;
+
+	const TArray<double> Weights = {1.0, 0.0, 3.0};
+	const TStrongObjectPtr<UUdonAliasTable> AliasTable(
+	    UUdonAliasTable::CreateAliasTable(Weights));
+	TestTrue(TEXT("GetWeights"), AliasTable->GetWeights() == Weights);
+
+	// the table is rebuilt only when the weights change
+	TestFalse(TEXT("Update with the same weights"),
+	          AliasTable->Update(Weights));
+	TestTrue(TEXT("Update with other weights"),
+	         AliasTable->Update({1.0, 0.0, 3.0, 4.0}));
+	TestEqual(TEXT("Num after Update"), AliasTable->GetTable().Num(), 4);
+
+	// the same seed draws the same indices
+	const TStrongObjectPtr<UUdonRandomStream> Stream(
+	    UUdonRandomStream::CreateRandomStream(99));
+	FRandomEngine Engine(99);
+	auto          bSame = true;
+	for (auto i = 0; i < 100; ++i) {
+		const auto Index = AliasTable->Draw(Stream.Get());
+		bSame &= Index == AliasTable->GetTable().Draw(Engine) && Index != 1;
+	}
+	TestTrue(TEXT("Draw with a seeded stream"), bSame);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FUdonArrayUtilsWeightedSampleWithReplacementTest,
+    "UdonArrayUtils.WeightedSample.WithReplacement",
+    UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsWeightedSampleWithReplacementTest::RunTest(
+    const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+	const auto  Array         = UUdonArrayUtilsTestFixture::MakeIndexInts(7);
+
+	const TArray<double> Weights = {0.0, NaN, -1.0, 2.0, 0.0, 6.0, 0.0};
+
+	// the samples are drawn from the alias table of the weights
+	constexpr auto NumSamples = 40000;
+	TArray<int32>  Samples;
+	FRandomEngine  Engine(11);
+	TestTrue(TEXT("WeightedRandomSample"),
+	         UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	             &Array, ArrayProperty, Weights, FString(), NumSamples, true,
+	             Engine, nullptr, &Samples));
+	TestEqual(TEXT("Num"), Samples.Num(), NumSamples);
+
+	TArray<int32> Counts;
+	Counts.SetNumZeroed(Array.Num());
+	for (const auto Sample : Samples) {
+		++Counts[Sample];
+	}
+	TestFrequencies(*this, TEXT("WeightedRandomSample"), Counts, NumSamples,
+	                GetProbabilities(Weights));
+
+	// a cached alias table draws the same samples
+	const TStrongObjectPtr<UUdonAliasTable> AliasTable(
+	    NewObject<UUdonAliasTable>());
+	for (auto i = 0; i < 2; ++i) {
+		FRandomEngine Engine1(5);
+		FRandomEngine Engine2(5);
+		TArray<int32> Expected;
+		UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+		    &Array, ArrayProperty, Weights, FString(), 100, true, Engine1,
+		    nullptr, &Expected);
+		UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+		    &Array, ArrayProperty, Weights, FString(), 100, true, Engine2,
+		    AliasTable.Get(), &Samples);
+		TestTrue(FString::Printf(TEXT("With an alias table #%d"), i),
+		         Samples == Expected);
+	}
+	TestTrue(TEXT("Weights of the alias table"),
+	         AliasTable->GetWeights() == Weights);
+
+	// nothing is drawn without a positive weight
+	const TArray<double> NonPositiveWeights = {0.0, 0.0, -1.0, NaN,
+	                                           0.0, 0.0, 0.0};
+	TestTrue(TEXT("WeightedRandomSample without positive weights"),
+	         UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	             &Array, ArrayProperty, NonPositiveWeights, FString(), 10, true,
+	             Engine, nullptr, &Samples));
+	TestEqual(TEXT("Num without positive weights"), Samples.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FUdonArrayUtilsWeightedSampleWithoutReplacementTest,
+    "UdonArrayUtils.WeightedSample.WithoutReplacement",
+    UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsWeightedSampleWithoutReplacementTest::RunTest(
+    const FString&) {
+	using namespace udon;
+
+	const auto& ArrayProperty = GetIntsProperty();
+
+	// the number of samples is clamped to the number of positive weights
+	{
+		const auto    Array = UUdonArrayUtilsTestFixture::MakeIndexInts(7);
+		TArray<int32> Samples;
+		FRandomEngine Engine(1);
+		UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+		    &Array, ArrayProperty, {0.0, 1.0, NaN, 2.0, -3.0, 4.0, 0.0},
+		    FString(), 10, false, Engine, nullptr, &Samples);
+		TestTrue(TEXT("Clamped to the positive weights"),
+		         Samples == TArray<int32>{1, 3, 5});
+	}
+
+	// infinite weights are selected before any finite weight
+	{
+		const auto    Array = UUdonArrayUtilsTestFixture::MakeIndexInts(5);
+		TArray<int32> Samples;
+		FRandomEngine Engine(2);
+		auto          bAlwaysSelected = true;
+		for (auto Trial = 0; Trial < 1000; ++Trial) {
+			UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+			    &Array, ArrayProperty, {1.0, Infinity, 2.0, 3.0, Infinity},
+			    FString(), 2, false, Engine, nullptr, &Samples);
+			bAlwaysSelected &= Samples == TArray<int32>{1, 4};
+		}
+		TestTrue(TEXT("Infinite weights"), bAlwaysSelected);
+	}
+
+	// an index is in the samples with the probability of drawing it in the
+	// first NumSamples draws without replacement
+	const auto Array = UUdonArrayUtilsTestFixture::MakeIndexInts(8);
+
+	const TArray<double> Weights = {1.0, 2.0, 0.0, 3.0, NaN, 4.0, -1.0, 10.0};
+	for (const auto NumSamples : {1, 2}) {
+		constexpr auto NumTrials = 40000;
+		TArray<int32>  Counts;
+		Counts.SetNumZeroed(Array.Num());
+		TArray<int32> Samples;
+		FRandomEngine Engine(20 + NumSamples);
+		auto          bAllValid = true;
+		for (auto Trial = 0; Trial < NumTrials; ++Trial) {
+			UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+			    &Array, ArrayProperty, Weights, FString(), NumSamples, false,
+			    Engine, nullptr, &Samples);
+			bAllValid &= Samples.Num() == NumSamples &&
+			             (NumSamples == 1 || Samples[0] < Samples[1]);
+			for (const auto Sample : Samples) {
+				++Counts[Sample];
+			}
+		}
+
+		const auto What = FString::Printf(TEXT("%d samples"), NumSamples);
+		TestTrue(What + TEXT(" are ascending and distinct"), bAllValid);
+		TestFrequencies(*this, What, Counts, NumTrials,
+		                GetInclusionProbabilities(Weights, NumSamples));
+	}
+
+	// the same seed selects the same samples
+	FRandomEngine Engine1(7);
+	FRandomEngine Engine2(7);
+	TArray<int32> Samples1;
+	TArray<int32> Samples2;
+	UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	    &Array, ArrayProperty, Weights, FString(), 3, false, Engine1, nullptr,
+	    &Samples1);
+	UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	    &Array, ArrayProperty, Weights, FString(), 3, false, Engine2, nullptr,
+	    &Samples2);
+	TestTrue(TEXT("With the same seed"), Samples1 == Samples2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUdonArrayUtilsWeightedSampleWeightsTest,
+                                 "UdonArrayUtils.WeightedSample.Weights",
+                                 UDON_ARRAY_UTILS_TEST_FLAGS)
+
+bool FUdonArrayUtilsWeightedSampleWeightsTest::RunTest(const FString&) {
+	using namespace udon;
+
+	// without weights, the elements themselves are the weights
+	const auto& FloatsProperty = UUdonArrayUtilsTestFixture::GetArrayProperty(
+	    GET_MEMBER_NAME_CHECKED(UUdonArrayUtilsTestFixture, Floats));
+	const TArray<float> Floats = {0.0f, 1.0f, -2.0f, 3.0f};
+	TArray<float>       Samples;
+	FRandomEngine       Engine(3);
+	TestTrue(TEXT("Weights from the elements"),
+	         UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	             &Floats, FloatsProperty, {}, FString(), 2, false, Engine,
+	             nullptr, &Samples) &&
+	             Samples == TArray<float>{1.0f, 3.0f});
+
+	// one weight is needed per element
+	const auto    Array = UUdonArrayUtilsTestFixture::MakeIndexInts(3);
+	TArray<int32> IntSamples;
+	AddExpectedError(TEXT("needs one weight per element"),
+	                 EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Too few weights"),
+	          UUdonArrayUtilsLibrary::GenericWeightedRandomSample(
+	              &Array, GetIntsProperty(), {1.0, 2.0}, FString(), 1, false,
+	              Engine, nullptr, &IntSamples));
+
+	return true;
+}
+
+#endif
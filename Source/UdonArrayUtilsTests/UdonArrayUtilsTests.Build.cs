@@ -0,0 +1,22 @@
+// Copyright 2024 Udon-Tobira, All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class UdonArrayUtilsTests : ModuleRules
+{
+    public UdonArrayUtilsTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "NetCore",
+                "UdonArrayUtils",
+            }
+            );
+    }
+}